@@ -0,0 +1,184 @@
+/**
+ * @file AllocTracker.cpp
+ * @brief This file contains the implementation of the AllocTracker class and the replaced global operator new and delete.
+ *
+ * Link this file only into benchmark and tool binaries. The operators forward to malloc and free; the counting itself
+ * must not allocate, so the phase registry is a fixed array and the phase names are compared with strcmp.
+ *
+ * @date October 17, 2026
+ * @author Kun Feng Wei
+ */
+
+#include "AllocTracker.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+
+namespace {
+
+std::atomic<uint64_t> process_allocations(0);
+std::atomic<uint64_t> process_bytes(0);
+std::atomic<uint64_t> process_frees(0);
+
+thread_local AllocTracker::Phase* open_phase = nullptr;
+
+// Accumulated totals per phase name; only touched when a phase closes or is read
+struct PhaseRegistry
+{
+    std::mutex mutex;
+    int count = 0;
+    const char* names[AllocTracker::MAX_PHASES] = {};
+    AllocTracker::Totals totals[AllocTracker::MAX_PHASES] = {};
+
+    // Returns the slot of a name, adding it if there is room, or -1; the caller holds the mutex
+    int find(const char* name, bool add)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            if (std::strcmp(names[i], name) == 0)
+            {
+                return i;
+            }
+        }
+        if (!add || count == AllocTracker::MAX_PHASES)
+        {
+            return -1;
+        }
+        names[count] = name;
+        totals[count] = {};
+        return count++;
+    }
+};
+
+PhaseRegistry& phaseRegistry()
+{
+    static PhaseRegistry* registry = new PhaseRegistry(); // never destroyed, usable during static destruction
+    return *registry;
+}
+
+void* allocate(size_t size)
+{
+    AllocTracker::countAllocation(size);
+    if (void* memory = std::malloc(size == 0 ? 1 : size))
+    {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void* allocateAligned(size_t size, std::align_val_t alignment)
+{
+    AllocTracker::countAllocation(size);
+    size_t align = static_cast<size_t>(alignment);
+    // aligned_alloc wants a size that is a multiple of the alignment
+    if (void* memory = std::aligned_alloc(align, (size + align - 1) / align * align))
+    {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void release(void* memory)
+{
+    if (memory != nullptr)
+    {
+        AllocTracker::countFree();
+        std::free(memory);
+    }
+}
+
+} // namespace
+
+void* operator new(size_t size) { return allocate(size); }
+void* operator new[](size_t size) { return allocate(size); }
+void* operator new(size_t size, std::align_val_t alignment) { return allocateAligned(size, alignment); }
+void* operator new[](size_t size, std::align_val_t alignment) { return allocateAligned(size, alignment); }
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    try { return allocate(size); } catch (const std::bad_alloc&) { return nullptr; }
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+    try { return allocate(size); } catch (const std::bad_alloc&) { return nullptr; }
+}
+
+void operator delete(void* memory) noexcept { release(memory); }
+void operator delete[](void* memory) noexcept { release(memory); }
+void operator delete(void* memory, size_t) noexcept { release(memory); }
+void operator delete[](void* memory, size_t) noexcept { release(memory); }
+void operator delete(void* memory, std::align_val_t) noexcept { release(memory); }
+void operator delete[](void* memory, std::align_val_t) noexcept { release(memory); }
+void operator delete(void* memory, size_t, std::align_val_t) noexcept { release(memory); }
+void operator delete[](void* memory, size_t, std::align_val_t) noexcept { release(memory); }
+
+void AllocTracker::countAllocation(uint64_t bytes) {
+    process_allocations.fetch_add(1, std::memory_order_relaxed);
+    process_bytes.fetch_add(bytes, std::memory_order_relaxed);
+    if (open_phase != nullptr) {
+        open_phase->totals_.allocations++;
+        open_phase->totals_.bytes += bytes;
+    }
+}
+
+void AllocTracker::countFree() {
+    process_frees.fetch_add(1, std::memory_order_relaxed);
+    if (open_phase != nullptr) {
+        open_phase->totals_.frees++;
+    }
+}
+
+AllocTracker::Totals AllocTracker::current() {
+    return {process_allocations.load(std::memory_order_relaxed), process_bytes.load(std::memory_order_relaxed),
+            process_frees.load(std::memory_order_relaxed)};
+}
+
+AllocTracker::Totals AllocTracker::phaseTotals(const char* name) {
+    PhaseRegistry& registry = phaseRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    int slot = registry.find(name, false);
+    return slot < 0 ? Totals() : registry.totals[slot];
+}
+
+void AllocTracker::resetPhases() {
+    PhaseRegistry& registry = phaseRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.count = 0;
+}
+
+/**
+ * Parameterized constructor.
+ * @param name The phase name; must outlive the program's use of the tracker (a string literal).
+ * @post The phase is the innermost open phase of the calling thread.
+ */
+AllocTracker::Phase::Phase(const char* name) : name_(name), totals_(), parent_(open_phase) {
+    open_phase = this;
+}
+
+/**
+ * Destructor.
+ * @post Adds the phase's totals to its name and to the enclosing phase, which becomes innermost again.
+ */
+AllocTracker::Phase::~Phase() {
+    open_phase = parent_;
+    if (parent_ != nullptr) {
+        parent_->totals_.allocations += totals_.allocations;
+        parent_->totals_.bytes += totals_.bytes;
+        parent_->totals_.frees += totals_.frees;
+    }
+    PhaseRegistry& registry = phaseRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    int slot = registry.find(name_, true);
+    if (slot >= 0) {
+        registry.totals[slot].allocations += totals_.allocations;
+        registry.totals[slot].bytes += totals_.bytes;
+        registry.totals[slot].frees += totals_.frees;
+    }
+}
+
+AllocTracker::Totals AllocTracker::Phase::totals() const {
+    return totals_;
+}
@@ -0,0 +1,102 @@
+/**
+ * @file AllocTracker.hpp
+ * @brief This file contains the declaration of the AllocTracker class, which counts heap allocations by named phase.
+ *
+ * AllocTracker.cpp replaces the global operator new and operator delete, so it must only be linked into benchmark
+ * and tool binaries, never into the library objects or `main`. Every allocation in the process is counted (calls and
+ * requested bytes), and the allocations made by a thread while an AllocTracker::Phase is open on it are also added to
+ * that phase. Phases nest: when an inner phase closes, its totals are added to the enclosing one. Totals of phases
+ * with the same name accumulate, and phaseTotals() reads them back.
+ *
+ * Example:
+ *   {
+ *       AllocTracker::Phase phase("load");
+ *       Kitchen kitchen("Dishes.csv");
+ *   }
+ *   AllocTracker::Totals load = AllocTracker::phaseTotals("load");
+ *
+ * @date October 17, 2026
+ * @author Kun Feng Wei
+ */
+
+#ifndef ALLOC_TRACKER_HPP
+#define ALLOC_TRACKER_HPP
+
+#include <cstdint>
+
+class AllocTracker {
+public:
+    /**
+     * Allocation counts of the whole process or of one phase.
+     */
+    struct Totals
+    {
+        uint64_t allocations;  ///< Calls to operator new (all forms).
+        uint64_t bytes;        ///< Bytes requested by those calls.
+        uint64_t frees;        ///< Calls to operator delete with a non-null pointer.
+    };
+
+    /**
+     * The most distinct phase names that can be tracked; further names are counted only in the process totals.
+     */
+    static const int MAX_PHASES = 32;
+
+    /**
+     * @return The totals of the whole process since it started.
+     */
+    static Totals current();
+
+    /**
+     * @param name The phase name.
+     * @return The accumulated totals of every closed phase with that name, or zeros if there was none.
+     */
+    static Totals phaseTotals(const char* name);
+
+    /**
+     * Forgets the accumulated totals of every phase.
+     */
+    static void resetPhases();
+
+    /**
+     * Called by the replaced operators; adds one allocation or free to the process and to the open phase.
+     */
+    static void countAllocation(uint64_t bytes);
+    static void countFree();
+
+    /**
+     * @class AllocTracker::Phase
+     * @brief Attributes the calling thread's allocations to a name from construction to destruction.
+     */
+    class Phase {
+    public:
+        /**
+         * Parameterized constructor.
+         * @param name The phase name; must outlive the program's use of the tracker (a string literal).
+         * @post The phase is the innermost open phase of the calling thread.
+         */
+        explicit Phase(const char* name);
+
+        Phase(const Phase&) = delete;
+        Phase& operator=(const Phase&) = delete;
+
+        /**
+         * Destructor.
+         * @post Adds the phase's totals to its name and to the enclosing phase, which becomes innermost again.
+         */
+        ~Phase();
+
+        /**
+         * @return The totals of this phase so far.
+         */
+        Totals totals() const;
+
+    private:
+        friend class AllocTracker;
+
+        const char* name_;
+        Totals totals_;
+        Phase* parent_;
+    };
+};
+
+#endif // ALLOC_TRACKER_HPP
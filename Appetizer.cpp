@@ -10,6 +10,7 @@
  */
 
 #include "Appetizer.hpp"
+#include "MenuRenderer.hpp"
 #include <string>
 #include <vector>
 
@@ -41,6 +42,7 @@ Appetizer::Appetizer(const std::string& name, const std::vector<std::string>& in
  */
 void Appetizer::setServingStyle(const ServingStyle &serving_style) {
     serving_style_ = serving_style;
+    markDirty();
 }
 
 /**
@@ -57,6 +59,7 @@ Appetizer::ServingStyle Appetizer::getServingStyle() const {
  */
 void Appetizer::setSpicinessLevel(const int &spiciness_level) {
     spiciness_level_ = spiciness_level;
+    markDirty();
 }
 
 /**
@@ -73,6 +76,7 @@ int Appetizer::getSpicinessLevel() const {
  */
 void Appetizer::setVegetarian(const bool &vegetarian) {
     vegetarian_ = vegetarian;
+    markDirty();
 }
 
 /**
@@ -83,11 +87,12 @@ bool Appetizer::isVegetarian() const {
 }
 
 /**
- * Displays the appetizer's details.
- * @post Outputs the appetizer's details, including name, ingredients,
+ * Appends the appetizer's details to a renderer's buffer.
+ * @param out The renderer whose buffer receives the text.
+ * @post Appends the appetizer's details, including name, ingredients,
 preparation time, price, cuisine type, serving style, spiciness level, and
-vegetarian status, to the standard output.
- * The information must be displayed in the following format:
+vegetarian status.
+ * The information is appended in the following format:
  *
  * Dish Name: [Name of the dish]
  * Ingredients: [Comma-separated list of ingredients]
@@ -98,33 +103,42 @@ vegetarian status, to the standard output.
  * Spiciness Level: [Spiciness level]
  * Vegetarian: [Yes/No]
  */
-void Appetizer::display() const
+void Appetizer::render(MenuRenderer& out) const
 {
-    Dish::display();
-    
-    if (serving_style_ == 0)
-    {
-        std::cout << "Serving Style: Plated" << std::endl;
-    }
-    if (serving_style_ == 1)
-    {
-        std::cout << "Serving Style: Family Style" << std::endl;
-    }
-    if (serving_style_ == 2)
-    {
-        std::cout << "Serving Style: Buffet" << std::endl;
-    }
+    Dish::render(out);
 
-    std::cout << "Spiciness Level: " << getSpicinessLevel() << std::endl;
-    
-    if (isVegetarian() == 1)
-    {
-        std::cout << "Vegetarian: Yes" << std::endl;
-    }
-    else
-    {
-        std::cout << "Vegetarian: No" << std::endl;
-    }
+    out.append("Serving Style: ").append(enumInfo(SERVING_STYLE_INFO, serving_style_, PLATED).display_name).append('\n');
+    out.append("Spiciness Level: ").appendInt(spiciness_level_).append('\n');
+    out.append("Vegetarian: ").append(vegetarian_ ? "Yes" : "No").append('\n');
+}
+
+/**
+ * Appends the appetizer as one CSV row in the Dishes.csv schema, with DishType APPETIZER.
+ * @param out The renderer whose buffer receives the text.
+ * @post Appends the row and its line break. AdditionalAttributes are written as SERVING_STYLE;spiciness;vegetarian.
+ */
+void Appetizer::writeCsv(MenuRenderer& out) const
+{
+    out.append("APPETIZER,");
+    Dish::writeCsv(out);
+    out.append(enumInfo(SERVING_STYLE_INFO, serving_style_, PLATED).token).append(';');
+    out.appendInt(spiciness_level_).append(';');
+    out.appendBool(vegetarian_).append('\n');
+}
+
+/**
+ * Appends the appetizer as one JSON object with "type" set to "APPETIZER".
+ * @param out The renderer whose buffer receives the text.
+ * @post Appends the object, including the "serving_style", "spiciness_level" and "vegetarian" members.
+ */
+void Appetizer::writeJson(MenuRenderer& out) const
+{
+    out.append("{\"type\":\"APPETIZER\"");
+    Dish::writeJson(out);
+    out.append(",\"serving_style\":\"").append(enumInfo(SERVING_STYLE_INFO, serving_style_, PLATED).token).append('"');
+    out.append(",\"spiciness_level\":").appendInt(spiciness_level_);
+    out.append(",\"vegetarian\":").appendBool(vegetarian_);
+    out.append('}');
 }
 
 /**
@@ -154,6 +168,8 @@ without substitution.
  */
 void Appetizer::dietaryAccommodations(const DietaryRequest& request)
 {
+    markDirty();
+
 //     - If `request.vegetarian` is true:
 //     - Sets `vegetarian_` to true.
 //     - Searches `ingredients_` for any non-vegetarian
@@ -189,6 +205,7 @@ void Appetizer::dietaryAccommodations(const DietaryRequest& request)
                     {
                         ingredients.erase(ingredients.begin() + i);
                         i--;
+                        break;
                     }
                     substitution_count++;
                 }
@@ -224,6 +241,7 @@ void Appetizer::dietaryAccommodations(const DietaryRequest& request)
                 {
                     ingredients.erase(ingredients.begin() + i);
                     i--;
+                    break;
                 }
             }
         }
@@ -28,6 +28,15 @@ public:
      */
     enum ServingStyle { PLATED, FAMILY_STYLE, BUFFET };
 
+    /**
+     * Metadata of each serving style, indexed by ServingStyle.
+     */
+    static constexpr EnumInfo<ServingStyle> SERVING_STYLE_INFO[] = {
+        {PLATED, "PLATED", "Plated", 0},
+        {FAMILY_STYLE, "FAMILY_STYLE", "Family Style", 0},
+        {BUFFET, "BUFFET", "Buffet", 0},
+    };
+
     /**
      * Default constructor.
      * Initializes all private members with default values.
@@ -84,11 +93,12 @@ public:
     bool isVegetarian() const;
 
 /**
- * Displays the appetizer's details.
- * @post Outputs the appetizer's details, including name, ingredients,
+ * Appends the appetizer's details to a renderer's buffer.
+ * @param out The renderer whose buffer receives the text.
+ * @post Appends the appetizer's details, including name, ingredients,
 preparation time, price, cuisine type, serving style, spiciness level, and
-vegetarian status, to the standard output.
- * The information must be displayed in the following format:
+vegetarian status.
+ * The information is appended in the following format:
  *
  * Dish Name: [Name of the dish]
  * Ingredients: [Comma-separated list of ingredients]
@@ -99,7 +109,21 @@ vegetarian status, to the standard output.
  * Spiciness Level: [Spiciness level]
  * Vegetarian: [Yes/No]
  */
-    void display() const override;
+    void render(MenuRenderer& out) const override;
+
+    /**
+     * Appends the appetizer as one CSV row in the Dishes.csv schema, with DishType APPETIZER.
+     * @param out The renderer whose buffer receives the text.
+     * @post Appends the row and its line break. AdditionalAttributes are written as SERVING_STYLE;spiciness;vegetarian.
+     */
+    void writeCsv(MenuRenderer& out) const override;
+
+    /**
+     * Appends the appetizer as one JSON object with "type" set to "APPETIZER".
+     * @param out The renderer whose buffer receives the text.
+     * @post Appends the object, including the "serving_style", "spiciness_level" and "vegetarian" members.
+     */
+    void writeJson(MenuRenderer& out) const override;
 
 /**
  * Modifies the appetizer based on dietary accommodations.
@@ -135,4 +159,6 @@ private:
     bool vegetarian_; ///< Flag indicating if the appetizer is vegetarian.
 };
 
+static_assert(isIndexedByValue(Appetizer::SERVING_STYLE_INFO), "SERVING_STYLE_INFO must be indexed by ServingStyle");
+
 #endif // APPETIZER_HPP
\ No newline at end of file
@@ -0,0 +1,655 @@
+/**
+ * @file BenchCompare.cpp
+ * @brief This file contains bench-compare, the performance regression gate for the Kitchen microbenchmark suite.
+ *
+ * bench-compare runs kitchenbench several times (or reads result files it already wrote) and reduces every metric to
+ * the median of the repetitions and its median absolute deviation (MAD). The metrics are ns_per_op, allocs_per_op
+ * and bytes_per_op of every benchmark result and allocation phase, keyed by name and size.
+ *
+ * With --update the reduced metrics are written as the baseline file, which is checked in, together with the bench
+ * command. Otherwise the bench is rerun with that same command (unless --bench is given), and the metrics are
+ * compared with the baseline and printed as a table. Allocation metrics are deterministic and regress when they grow
+ * by more than --alloc-threshold-pct percent; they are the gate. A timing metric is flagged "slower" when its median
+ * grows by more than --threshold-pct percent AND by more than --mad-k times the larger of the two scaled MADs, but
+ * the MADs only cover the noise within one invocation, not the drift of a machine from run to run, so timing is
+ * advisory and only fails the gate with --gate-timing (on a quiet, pinned machine). Metrics missing on either side
+ * are listed but do not fail the gate.
+ *
+ * Exit status: 0 when nothing regressed, 1 when a metric regressed, 2 on usage, bench or file errors.
+ *
+ * Usage: ./benchcompare [--baseline FILE] [--update] [--repetitions N] [--bench COMMAND] [--gate-timing]
+ *                       [--threshold-pct P] [--mad-k K] [--alloc-threshold-pct P] [result.json ...]
+ *
+ * @date October 17, 2026
+ * @author Kun Feng Wei
+ */
+
+#include "MenuRenderer.hpp"
+#include "OutputSink.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Scales a MAD to the standard deviation of normally distributed samples
+static const double MAD_TO_SIGMA = 1.4826;
+
+struct Options
+{
+    std::string baseline = "bench_baseline.json";
+    std::string bench = "./kitchenbench Dishes.csv --max-size 10000 --min-time-ms 10";
+    int repetitions = 5;
+    double threshold_pct = 10.0;
+    double mad_k = 3.0;
+    double alloc_threshold_pct = 1.0;
+    bool gate_timing = false;  // timing changes fail the gate instead of being advisory
+    bool update = false;
+    bool bench_given = false;
+    std::vector<std::string> result_files;  // used instead of running the bench when given
+};
+
+// A parsed JSON value; only what the bench files use
+struct Json
+{
+    enum Type {NUL, BOOLEAN, NUMBER, STRING, ARRAY, OBJECT};
+
+    Type type = NUL;
+    double number = 0;
+    std::string text;
+    std::vector<Json> items;
+    std::vector<std::pair<std::string, Json>> members;
+
+    const Json* find(const std::string& key) const
+    {
+        for (const std::pair<std::string, Json>& member : members)
+        {
+            if (member.first == key)
+            {
+                return &member.second;
+            }
+        }
+        return nullptr;
+    }
+
+    double numberAt(const std::string& key) const
+    {
+        const Json* value = find(key);
+        return value != nullptr && value->type == NUMBER ? value->number : 0.0;
+    }
+
+    std::string textAt(const std::string& key) const
+    {
+        const Json* value = find(key);
+        return value != nullptr && value->type == STRING ? value->text : std::string();
+    }
+};
+
+// Recursive descent JSON parser; sets `error` and stops at the first malformed token
+class JsonParser {
+public:
+    explicit JsonParser(const std::string& input) : input_(input), pos_(0), error_() {}
+
+    bool parse(Json& value)
+    {
+        parseValue(value);
+        skipSpace();
+        if (error_.empty() && pos_ != input_.size())
+        {
+            fail("trailing characters");
+        }
+        return error_.empty();
+    }
+
+    const std::string& error() const
+    {
+        return error_;
+    }
+
+private:
+    void fail(const char* message)
+    {
+        if (error_.empty())
+        {
+            error_ = std::string(message) + " at offset " + std::to_string(pos_);
+        }
+    }
+
+    void skipSpace()
+    {
+        while (pos_ < input_.size() && std::strchr(" \t\r\n", input_[pos_]) != nullptr)
+        {
+            pos_++;
+        }
+    }
+
+    bool consume(char c)
+    {
+        skipSpace();
+        if (pos_ < input_.size() && input_[pos_] == c)
+        {
+            pos_++;
+            return true;
+        }
+        return false;
+    }
+
+    bool consumeWord(const char* word)
+    {
+        size_t length = std::strlen(word);
+        if (input_.compare(pos_, length, word) == 0)
+        {
+            pos_ += length;
+            return true;
+        }
+        return false;
+    }
+
+    void parseString(std::string& text)
+    {
+        if (!consume('"'))
+        {
+            fail("expected string");
+            return;
+        }
+        while (pos_ < input_.size() && input_[pos_] != '"')
+        {
+            char c = input_[pos_++];
+            if (c == '\\' && pos_ < input_.size())
+            {
+                char escaped = input_[pos_++];
+                const char* from = "\"\\/bfnrt";
+                const char* to = "\"\\/\b\f\n\r\t";
+                const char* match = std::strchr(from, escaped);
+                if (match == nullptr || escaped == '\0')
+                {
+                    fail("unsupported escape");
+                    return;
+                }
+                c = to[match - from];
+            }
+            text += c;
+        }
+        if (!consume('"'))
+        {
+            fail("unterminated string");
+        }
+    }
+
+    void parseValue(Json& value)
+    {
+        skipSpace();
+        if (pos_ >= input_.size())
+        {
+            fail("unexpected end");
+            return;
+        }
+        char c = input_[pos_];
+        if (c == '{')
+        {
+            pos_++;
+            value.type = Json::OBJECT;
+            if (consume('}'))
+            {
+                return;
+            }
+            do
+            {
+                std::pair<std::string, Json> member;
+                parseString(member.first);
+                if (!consume(':'))
+                {
+                    fail("expected ':'");
+                    return;
+                }
+                parseValue(member.second);
+                value.members.push_back(std::move(member));
+            } while (error_.empty() && consume(','));
+            if (!consume('}'))
+            {
+                fail("expected '}'");
+            }
+        }
+        else if (c == '[')
+        {
+            pos_++;
+            value.type = Json::ARRAY;
+            if (consume(']'))
+            {
+                return;
+            }
+            do
+            {
+                value.items.emplace_back();
+                parseValue(value.items.back());
+            } while (error_.empty() && consume(','));
+            if (!consume(']'))
+            {
+                fail("expected ']'");
+            }
+        }
+        else if (c == '"')
+        {
+            value.type = Json::STRING;
+            parseString(value.text);
+        }
+        else if (consumeWord("true") || consumeWord("false"))
+        {
+            value.type = Json::BOOLEAN;
+            value.number = c == 't' ? 1 : 0;
+        }
+        else if (consumeWord("null"))
+        {
+            value.type = Json::NUL;
+        }
+        else
+        {
+            const char* begin = input_.c_str() + pos_;
+            char* end = nullptr;
+            value.type = Json::NUMBER;
+            value.number = std::strtod(begin, &end);
+            if (end == begin)
+            {
+                fail("unexpected character");
+                return;
+            }
+            pos_ += end - begin;
+        }
+    }
+
+    const std::string& input_;
+    size_t pos_;
+    std::string error_;
+};
+
+// One metric of one benchmark or allocation phase, e.g. {"newOrder@1000", "ns_per_op"}
+struct MetricKey
+{
+    std::string name;
+    std::string metric;
+
+    bool operator<(const MetricKey& other) const
+    {
+        return name != other.name ? name < other.name : metric < other.metric;
+    }
+};
+
+struct Summary
+{
+    double median = 0;
+    double mad = 0;
+};
+
+// Samples of every metric in first-seen order, one sample per repetition
+struct Samples
+{
+    std::vector<MetricKey> order;
+    std::map<MetricKey, std::vector<double>> values;
+
+    void add(const MetricKey& key, double value)
+    {
+        std::vector<double>& samples = values[key];
+        if (samples.empty())
+        {
+            order.push_back(key);
+        }
+        samples.push_back(value);
+    }
+};
+
+static bool isTimingMetric(const std::string& metric)
+{
+    return metric == "ns_per_op";
+}
+
+static double median(std::vector<double> values)
+{
+    if (values.empty())
+    {
+        return 0.0;
+    }
+    std::sort(values.begin(), values.end());
+    size_t middle = values.size() / 2;
+    return values.size() % 2 == 1 ? values[middle] : (values[middle - 1] + values[middle]) / 2.0;
+}
+
+static Summary summarize(const std::vector<double>& values)
+{
+    Summary summary;
+    summary.median = median(values);
+    std::vector<double> deviations;
+    deviations.reserve(values.size());
+    for (double value : values)
+    {
+        deviations.push_back(std::fabs(value - summary.median));
+    }
+    summary.mad = median(deviations);
+    return summary;
+}
+
+static bool readFile(const std::string& filename, std::string& text)
+{
+    std::ifstream input_file(filename);
+    if (!input_file.is_open())
+    {
+        std::cerr << "Failed to open file: " << filename << std::endl;
+        return false;
+    }
+    std::stringstream buffer;
+    buffer << input_file.rdbuf();
+    text = buffer.str();
+    return true;
+}
+
+static bool parseJson(const std::string& text, const std::string& source, Json& value)
+{
+    JsonParser parser(text);
+    if (!parser.parse(value) || value.type != Json::OBJECT)
+    {
+        std::cerr << source << ": invalid JSON: " << (parser.error().empty() ? "not an object" : parser.error()) << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Adds the metrics of one kitchenbench run as one repetition
+static void addRun(const Json& run, Samples& samples)
+{
+    static const char* const METRICS[] = {"ns_per_op", "allocs_per_op", "bytes_per_op"};
+    if (const Json* results = run.find("results"))
+    {
+        for (const Json& result : results->items)
+        {
+            std::string name = result.textAt("name") + "@" + std::to_string(static_cast<long long>(result.numberAt("size")));
+            for (const char* metric : METRICS)
+            {
+                samples.add({name, metric}, result.numberAt(metric));
+            }
+        }
+    }
+    if (const Json* phases = run.find("allocation_phases"))
+    {
+        for (const Json& phase : phases->items)
+        {
+            std::string name = "phase:" + phase.textAt("phase") + "@" + std::to_string(static_cast<long long>(phase.numberAt("size")));
+            samples.add({name, "allocs_per_op"}, phase.numberAt("allocs_per_op"));
+            samples.add({name, "bytes_per_op"}, phase.numberAt("bytes_per_op"));
+        }
+    }
+}
+
+// Runs the bench command and returns its standard output; its progress on stderr passes through
+static bool runBench(const std::string& command, std::string& output)
+{
+    FILE* pipe = popen(command.c_str(), "r");
+    if (pipe == nullptr)
+    {
+        std::cerr << "Failed to run: " << command << std::endl;
+        return false;
+    }
+    char buffer[4096];
+    size_t read_count;
+    while ((read_count = std::fread(buffer, 1, sizeof(buffer), pipe)) > 0)
+    {
+        output.append(buffer, read_count);
+    }
+    int status = pclose(pipe);
+    if (status != 0)
+    {
+        std::cerr << "Bench command failed (status " << status << "): " << command << std::endl;
+        return false;
+    }
+    return true;
+}
+
+static bool collectSamples(const Options& options, Samples& samples)
+{
+    if (!options.result_files.empty())
+    {
+        for (const std::string& filename : options.result_files)
+        {
+            std::string text;
+            Json run;
+            if (!readFile(filename, text) || !parseJson(text, filename, run))
+            {
+                return false;
+            }
+            addRun(run, samples);
+        }
+        return true;
+    }
+    for (int i = 0; i < options.repetitions; i++)
+    {
+        std::cerr << "bench-compare: repetition " << (i + 1) << " of " << options.repetitions << std::endl;
+        std::string text;
+        Json run;
+        if (!runBench(options.bench, text) || !parseJson(text, "bench output", run))
+        {
+            return false;
+        }
+        addRun(run, samples);
+    }
+    return true;
+}
+
+static bool writeBaseline(const Options& options, const Samples& samples)
+{
+    MenuRenderer out;
+    out.append("{\n  \"suite\": \"kitchen\",\n  \"bench\": ").appendJsonString(options.bench);
+    out.append(",\n  \"repetitions\": ").appendInt(static_cast<int>(samples.values.empty() ? 0 : samples.values.begin()->second.size()));
+    out.append(",\n  \"metrics\": [\n");
+    for (size_t i = 0; i < samples.order.size(); i++)
+    {
+        const MetricKey& key = samples.order[i];
+        Summary summary = summarize(samples.values.at(key));
+        out.append(i == 0 ? "" : ",\n");
+        out.append("    {\"name\": ").appendJsonString(key.name);
+        out.append(", \"metric\": ").appendJsonString(key.metric);
+        out.append(", \"median\": ").appendFixed(summary.median, 3);
+        out.append(", \"mad\": ").appendFixed(summary.mad, 3);
+        out.append('}');
+    }
+    out.append("\n  ]\n}\n");
+
+    std::ofstream output_file(options.baseline);
+    if (!output_file.is_open())
+    {
+        std::cerr << "Failed to open file: " << options.baseline << std::endl;
+        return false;
+    }
+    StreamSink sink(output_file);
+    out.emit(sink);
+    std::cerr << "bench-compare: wrote " << samples.order.size() << " metrics to " << options.baseline << std::endl;
+    return output_file.good();
+}
+
+static std::string formatNumber(double value)
+{
+    std::ostringstream text;
+    text << std::fixed << std::setprecision(value < 100 ? 3 : 1) << value;
+    return text.str();
+}
+
+static void printRow(const std::string& name, const std::string& metric, const std::string& baseline,
+                     const std::string& current, const std::string& change, const std::string& allowed,
+                     const std::string& status)
+{
+    std::cout << std::left << std::setw(34) << name << std::setw(15) << metric << std::right << std::setw(14) << baseline
+              << std::setw(14) << current << std::setw(10) << change << std::setw(10) << allowed << "  " << status << '\n';
+}
+
+static std::string formatPercent(double pct)
+{
+    std::ostringstream text;
+    text << std::showpos << std::fixed << std::setprecision(1) << pct << '%';
+    return text.str();
+}
+
+// Prints the comparison table and returns the number of regressed metrics
+static int compare(const Options& options, const Json& baseline, const Samples& samples)
+{
+    int regressions = 0;
+    int improvements = 0;
+    int advisories = 0;
+    std::map<MetricKey, bool> seen;
+    printRow("benchmark", "metric", "baseline", "current", "change", "allowed", "status");
+    printRow(std::string(34 - 1, '-'), std::string(15 - 1, '-'), "--------", "-------", "------", "-------", "------");
+    if (const Json* metrics = baseline.find("metrics"))
+    {
+        for (const Json& entry : metrics->items)
+        {
+            MetricKey key = {entry.textAt("name"), entry.textAt("metric")};
+            seen[key] = true;
+            Summary before = {entry.numberAt("median"), entry.numberAt("mad")};
+            std::map<MetricKey, std::vector<double>>::const_iterator found = samples.values.find(key);
+            if (found == samples.values.end())
+            {
+                printRow(key.name, key.metric, formatNumber(before.median), "-", "", "", "missing");
+                continue;
+            }
+            Summary after = summarize(found->second);
+            double delta = after.median - before.median;
+            double change_pct = before.median != 0 ? 100.0 * delta / before.median : (delta != 0 ? 100.0 : 0.0);
+
+            // The allowed growth: a relative threshold, widened by the noise of timing metrics
+            double allowed;
+            if (isTimingMetric(key.metric))
+            {
+                double noise = options.mad_k * MAD_TO_SIGMA * std::max(before.mad, after.mad);
+                allowed = std::max(before.median * options.threshold_pct / 100.0, noise);
+            }
+            else
+            {
+                allowed = before.median * options.alloc_threshold_pct / 100.0 + 0.001;
+            }
+            double allowed_pct = before.median != 0 ? 100.0 * allowed / before.median : 0.0;
+
+            const char* status = "ok";
+            if (delta > allowed && isTimingMetric(key.metric) && !options.gate_timing)
+            {
+                status = "slower";
+                advisories++;
+            }
+            else if (delta > allowed)
+            {
+                status = "REGRESSED";
+                regressions++;
+            }
+            else if (-delta > allowed)
+            {
+                status = "improved";
+                improvements++;
+            }
+            printRow(key.name, key.metric, formatNumber(before.median), formatNumber(after.median),
+                     formatPercent(change_pct), formatPercent(allowed_pct), status);
+        }
+    }
+    for (const MetricKey& key : samples.order)
+    {
+        if (seen.find(key) == seen.end())
+        {
+            printRow(key.name, key.metric, "-", formatNumber(summarize(samples.values.at(key)).median), "", "", "new");
+        }
+    }
+    std::cout << '\n' << regressions << " regressed, " << improvements << " improved, " << advisories << " slower, "
+              << "timing threshold " << options.threshold_pct << "% or " << options.mad_k << " x MAD"
+              << (options.gate_timing ? "" : " (advisory)") << ", "
+              << "allocation threshold " << options.alloc_threshold_pct << "%" << std::endl;
+    return regressions;
+}
+
+static bool parseOptions(int argc, char* argv[], Options& options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        bool has_value = i + 1 < argc;
+        if (std::strcmp(argv[i], "--baseline") == 0 && has_value)
+        {
+            options.baseline = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--update") == 0)
+        {
+            options.update = true;
+        }
+        else if (std::strcmp(argv[i], "--repetitions") == 0 && has_value)
+        {
+            options.repetitions = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--bench") == 0 && has_value)
+        {
+            options.bench = argv[++i];
+            options.bench_given = true;
+        }
+        else if (std::strcmp(argv[i], "--gate-timing") == 0)
+        {
+            options.gate_timing = true;
+        }
+        else if (std::strcmp(argv[i], "--threshold-pct") == 0 && has_value)
+        {
+            options.threshold_pct = std::atof(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--mad-k") == 0 && has_value)
+        {
+            options.mad_k = std::atof(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--alloc-threshold-pct") == 0 && has_value)
+        {
+            options.alloc_threshold_pct = std::atof(argv[++i]);
+        }
+        else if (argv[i][0] != '-')
+        {
+            options.result_files.push_back(argv[i]);
+        }
+        else
+        {
+            std::cerr << "Usage: " << argv[0] << " [--baseline FILE] [--update] [--repetitions N] [--bench COMMAND]"
+                      << " [--gate-timing] [--threshold-pct P] [--mad-k K] [--alloc-threshold-pct P] [result.json ...]" << std::endl;
+            return false;
+        }
+    }
+    if (options.repetitions < 1)
+    {
+        std::cerr << "--repetitions must be at least 1" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    Samples samples;
+    if (!parseOptions(argc, argv, options))
+    {
+        return 2;
+    }
+    if (options.update)
+    {
+        return collectSamples(options, samples) && writeBaseline(options, samples) ? 0 : 2;
+    }
+
+    std::string text;
+    Json baseline;
+    if (!readFile(options.baseline, text) || !parseJson(text, options.baseline, baseline))
+    {
+        std::cerr << "Create a baseline with --update first." << std::endl;
+        return 2;
+    }
+    // Unless told otherwise, rerun the bench exactly as the baseline was measured
+    if (!options.bench_given && !baseline.textAt("bench").empty())
+    {
+        options.bench = baseline.textAt("bench");
+    }
+    if (!collectSamples(options, samples))
+    {
+        return 2;
+    }
+    return compare(options, baseline, samples) == 0 ? 0 : 1;
+}
@@ -10,6 +10,7 @@
  */
 
 #include "Dessert.hpp"
+#include "MenuRenderer.hpp"
 
 /**
  * Default constructor.
@@ -39,6 +40,7 @@ Dessert::Dessert(const std::string& name, const std::vector<std::string>& ingred
  */
 void Dessert::setFlavorProfile(const FlavorProfile &flavor_profile) {
     flavor_profile_ = flavor_profile;
+    markDirty();
 }
 
 /**
@@ -55,6 +57,7 @@ Dessert::FlavorProfile Dessert::getFlavorProfile() const {
  */
 void Dessert::setSweetnessLevel(const int &sweetness_level) {
     sweetness_level_ = sweetness_level;
+    markDirty();
 }
 
 /**
@@ -71,6 +74,7 @@ int Dessert::getSweetnessLevel() const {
  */
 void Dessert::setContainsNuts(const bool &contains_nuts) {
     contains_nuts_ = contains_nuts;
+    markDirty();
 }
 
 /**
@@ -81,11 +85,12 @@ bool Dessert::containsNuts() const {
 }
 
 /**
- * Displays the dessert's details.
- * @post Outputs the dessert's details, including name, ingredients,
+ * Appends the dessert's details to a renderer's buffer.
+ * @param out The renderer whose buffer receives the text.
+ * @post Appends the dessert's details, including name, ingredients,
 preparation time, price, cuisine type, flavor profile, sweetness level, and
 whether it contains nuts.
- * The information must be displayed in the following format:
+ * The information is appended in the following format:
  *
  * Dish Name: [Name of the dish]
  * Ingredients: [Comma-separated list of ingredients]
@@ -96,42 +101,42 @@ whether it contains nuts.
 * Sweetness Level: [Sweetness level]
 * Contains Nuts: [Yes/No]
 */
-void Dessert::display() const
+void Dessert::render(MenuRenderer& out) const
 {
-    Dish::display();
+    Dish::render(out);
 
-    std::cout << "Flavor Profile: ";
-    if (flavor_profile_== 0)
-    {
-        std::cout << "Sweet" << std::endl;
-    }
-    if (flavor_profile_ == 1)
-    {
-        std::cout << "Bitter" << std::endl;
-    }
-    if (flavor_profile_ == 2)
-    {
-        std::cout << "Sour" << std::endl;
-    }
-    if (flavor_profile_ == 2)
-    {
-        std::cout << "Salty" << std::endl;
-    }
-    if (flavor_profile_ == 3)
-    {
-        std::cout << "Umami" << std::endl;
-    }
+    out.append("Flavor Profile: ").append(enumInfo(FLAVOR_PROFILE_INFO, flavor_profile_, SWEET).display_name).append('\n');
+    out.append("Sweetness Level: ").appendInt(sweetness_level_).append('\n');
+    out.append("Contains Nuts: ").append(contains_nuts_ ? "Yes" : "No").append('\n');
+}
 
-    std::cout << "Sweetness Level: " << getSweetnessLevel() << std::endl;
-    std::cout << "Contains Nuts: ";
-    if (containsNuts() == 1)
-    {
-        std::cout << "Yes" << std::endl;
-    }
-    else
-    {
-        std::cout << "No" << std::endl;
-    }
+/**
+ * Appends the dessert as one CSV row in the Dishes.csv schema, with DishType DESSERT.
+ * @param out The renderer whose buffer receives the text.
+ * @post Appends the row and its line break. AdditionalAttributes are written as FLAVOR_PROFILE;sweetness;contains_nuts.
+ */
+void Dessert::writeCsv(MenuRenderer& out) const
+{
+    out.append("DESSERT,");
+    Dish::writeCsv(out);
+    out.append(enumInfo(FLAVOR_PROFILE_INFO, flavor_profile_, SWEET).token).append(';');
+    out.appendInt(sweetness_level_).append(';');
+    out.appendBool(contains_nuts_).append('\n');
+}
+
+/**
+ * Appends the dessert as one JSON object with "type" set to "DESSERT".
+ * @param out The renderer whose buffer receives the text.
+ * @post Appends the object, including the "flavor_profile", "sweetness_level" and "contains_nuts" members.
+ */
+void Dessert::writeJson(MenuRenderer& out) const
+{
+    out.append("{\"type\":\"DESSERT\"");
+    Dish::writeJson(out);
+    out.append(",\"flavor_profile\":\"").append(enumInfo(FLAVOR_PROFILE_INFO, flavor_profile_, SWEET).token).append('"');
+    out.append(",\"sweetness_level\":").appendInt(sweetness_level_);
+    out.append(",\"contains_nuts\":").appendBool(contains_nuts_);
+    out.append('}');
 }
 
 /**
@@ -154,6 +159,8 @@ needs.
 */
 void Dessert::dietaryAccommodations(const DietaryRequest& request)
 {
+    markDirty();
+
 // - If `request.nut_free` is true:
 //     - Sets `contains_nuts_` to false.
 //     - Removes nuts from `ingredients_`.
@@ -172,6 +179,7 @@ void Dessert::dietaryAccommodations(const DietaryRequest& request)
                 {
                     ingredients.erase(ingredients.begin() + i);
                     i--;
+                    break;
                 }
             }
         }
@@ -205,6 +213,7 @@ void Dessert::dietaryAccommodations(const DietaryRequest& request)
                 {
                     ingredients.erase(ingredients.begin() + i);
                     i--;
+                    break;
                 }
             }
         }
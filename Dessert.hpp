@@ -28,6 +28,17 @@ public:
      */
     enum FlavorProfile { SWEET, BITTER, SOUR, SALTY, UMAMI };
 
+    /**
+     * Metadata of each flavor profile, indexed by FlavorProfile.
+     */
+    static constexpr EnumInfo<FlavorProfile> FLAVOR_PROFILE_INFO[] = {
+        {SWEET, "SWEET", "Sweet", 0},
+        {BITTER, "BITTER", "Bitter", 0},
+        {SOUR, "SOUR", "Sour", 0},
+        {SALTY, "SALTY", "Salty", 0},
+        {UMAMI, "UMAMI", "Umami", 0},
+    };
+
     /**
      * Default constructor.
      * Initializes all private members with default values.
@@ -84,11 +95,12 @@ public:
     bool containsNuts() const;
 
 /**
- * Displays the dessert's details.
- * @post Outputs the dessert's details, including name, ingredients,
+ * Appends the dessert's details to a renderer's buffer.
+ * @param out The renderer whose buffer receives the text.
+ * @post Appends the dessert's details, including name, ingredients,
 preparation time, price, cuisine type, flavor profile, sweetness level, and
 whether it contains nuts.
- * The information must be displayed in the following format:
+ * The information is appended in the following format:
  *
  * Dish Name: [Name of the dish]
  * Ingredients: [Comma-separated list of ingredients]
@@ -99,7 +111,21 @@ whether it contains nuts.
 * Sweetness Level: [Sweetness level]
 * Contains Nuts: [Yes/No]
 */
-    void display() const override;
+    void render(MenuRenderer& out) const override;
+
+    /**
+     * Appends the dessert as one CSV row in the Dishes.csv schema, with DishType DESSERT.
+     * @param out The renderer whose buffer receives the text.
+     * @post Appends the row and its line break. AdditionalAttributes are written as FLAVOR_PROFILE;sweetness;contains_nuts.
+     */
+    void writeCsv(MenuRenderer& out) const override;
+
+    /**
+     * Appends the dessert as one JSON object with "type" set to "DESSERT".
+     * @param out The renderer whose buffer receives the text.
+     * @post Appends the object, including the "flavor_profile", "sweetness_level" and "contains_nuts" members.
+     */
+    void writeJson(MenuRenderer& out) const override;
 
 /**
  * Modifies the dessert based on dietary accommodations.
@@ -128,4 +154,6 @@ private:
     bool contains_nuts_; ///< Flag indicating if the dessert contains nuts.
 };
 
+static_assert(isIndexedByValue(Dessert::FLAVOR_PROFILE_INFO), "FLAVOR_PROFILE_INFO must be indexed by FlavorProfile");
+
 #endif // DESSERT_HPP
\ No newline at end of file
@@ -0,0 +1,937 @@
+/**
+ * @file DiffTest.cpp
+ * @brief This file contains the differential test harness that checks Kitchen against a simple reference model.
+ *
+ * Each run generates a seeded random trace of Kitchen operations (newOrder, serveDish, both releases, dietary
+ * adjustments, and prep time, price and cuisine type changes made through a dish's own setters while it may be in the
+ * kitchen, with no refreshDishHeaders() call) and replays it on a Kitchen and on
+ * ReferenceKitchen side by side, each with its own copies of the dishes. ReferenceKitchen keeps the ArrayBag
+ * semantics (pointer identity, capacity 100, swap-with-last removal) on a plain vector and recomputes every
+ * aggregate and every text from the dishes on each call, with no headers, running totals or render caches. After
+ * every operation all observable results are compared: the operation's return value, every aggregate and tally,
+ * the report, the menu (whole and paged) and both exports.
+ *
+ * On the first mismatch the trace is cut after the failing operation and minimized by removing chunks of operations
+ * for as long as the shortened trace still fails, and the minimal trace is printed with the mismatch.
+ *
+ * Before the runs, a menu far longer than the kitchen's capacity is formatted by ParallelMenuRenderer and must match
+ * MenuRenderer::renderMenu() byte for byte.
+ *
+ * In a `make STATS=1` build a fixed workload runs first and the Kitchen::stats() counters it leaves (calls, items,
+ * rejections and capacity drops) must match the counts the workload is known to produce. A StatsDumper then writes
+ * those counters to a temporary file, and the block read back must hold them.
+ *
+ * Usage: ./difftest [--seed S] [--runs N] [--steps N]
+ * Exit status: 0 when every run matched, 1 on a mismatch, 2 on usage errors.
+ *
+ * @date October 17, 2026
+ * @author Kun Feng Wei
+ */
+
+#include "Kitchen.hpp"
+#include "Appetizer.hpp"
+#include "MainCourse.hpp"
+#include "Dessert.hpp"
+#include "MenuRenderer.hpp"
+#include "OutputSink.hpp"
+#include "ParallelMenuRenderer.hpp"
+#include "StatsDumper.hpp"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+static const int KITCHEN_CAPACITY = 100;
+static const int PARALLEL_THREADS = 3;
+static const int PARALLEL_MENU_DISHES = 2000;
+
+struct Options
+{
+    unsigned long long seed = 1;
+    int runs = 100;
+    int steps = 300;
+};
+
+enum OpType {NEW_ORDER, SERVE_DISH, RELEASE_BELOW_PREP_TIME, RELEASE_CUISINE_TYPE, DIETARY_ADJUSTMENT, SET_PREP_TIME, SET_PRICE, SET_CUISINE_TYPE};
+
+enum DishKind {APPETIZER, MAIN_COURSE, DESSERT};
+
+// Everything needed to build the same dish on both sides
+struct DishSpec
+{
+    DishKind kind;
+    std::string name;
+    std::vector<std::string> ingredients;
+    int prep_time;
+    Cents price_cents;
+    Dish::CuisineType cuisine_type;
+    int style;   // serving style, cooking method or flavor profile
+    int level;   // spiciness or sweetness
+    bool flag;   // vegetarian, gluten free or contains nuts
+    std::string protein_type;
+    std::vector<MainCourse::SideDish> side_dishes;
+};
+
+// One operation; `dish` indexes Trace::dishes, so reusing an index passes the same Dish* again
+struct Op
+{
+    OpType type;
+    int dish;
+    int value;
+    std::string text;
+    Dish::DietaryRequest request;
+};
+
+struct Trace
+{
+    std::vector<DishSpec> dishes;
+    std::vector<Op> ops;
+};
+
+// The first observable result that differed
+struct Mismatch
+{
+    int step = -1;
+    std::string observable;
+    std::string expected;
+    std::string actual;
+};
+
+// Random helpers written out by hand, as in MenuGen: std::mt19937_64 is fully specified, the distributions are not
+static long long uniformInt(std::mt19937_64& rng, long long low, long long high)
+{
+    return low + static_cast<long long>(rng() % static_cast<unsigned long long>(high - low + 1));
+}
+
+static bool chance(std::mt19937_64& rng, int percent)
+{
+    return uniformInt(rng, 0, 99) < percent;
+}
+
+template <size_t N>
+static const char* pick(std::mt19937_64& rng, const char* const (&values)[N])
+{
+    return values[uniformInt(rng, 0, N - 1)];
+}
+
+// Ingredients chosen to trigger every dietary substitution and removal rule
+static const char* const INGREDIENTS[] = {
+    "Meat", "Chicken", "Fish", "Beef", "Pork", "Lamb", "Shrimp", "Bacon", "Wheat", "Flour", "Bread", "Pasta",
+    "Almonds", "Walnuts", "Peanuts", "Cashews", "Pecans", "Sugar", "Honey", "Syrup", "Salt", "Soy Sauce",
+    "Rice", "Carrots", "Onion", "Garlic", "Tomato", "Basil", "Cream", "Eggs", "Butter", "Cheese"};
+
+static const char* const NAMES[] = {"Spring Rolls", "Pot Roast", "Carrot Cake", "Pad Thai", "Tiramisu", "Tacos", "Ratatouille", "Curry"};
+
+static const char* const CUISINE_ARGUMENTS[] = {"ITALIAN", "MEXICAN", "CHINESE", "INDIAN", "AMERICAN", "FRENCH", "OTHER", "italian", "PIZZA", ""};
+
+static DishSpec randomDish(std::mt19937_64& rng)
+{
+    DishSpec spec;
+    spec.kind = static_cast<DishKind>(uniformInt(rng, 0, 2));
+    spec.name = pick(rng, NAMES);
+    int ingredient_count = static_cast<int>(uniformInt(rng, 1, 8));
+    for (int i = 0; i < ingredient_count; i++)
+    {
+        spec.ingredients.push_back(pick(rng, INGREDIENTS));
+    }
+    // Prep times cluster around the 60 minute elaborate threshold
+    spec.prep_time = static_cast<int>(chance(rng, 30) ? uniformInt(rng, 55, 65) : uniformInt(rng, 1, 150));
+    spec.price_cents = uniformInt(rng, 0, 5000);
+    spec.cuisine_type = static_cast<Dish::CuisineType>(uniformInt(rng, 0, 6));
+    spec.style = static_cast<int>(uniformInt(rng, 0, 2));
+    spec.level = static_cast<int>(uniformInt(rng, 0, 10));
+    spec.flag = chance(rng, 50);
+    spec.protein_type = chance(rng, 50) ? "Chicken" : "Beef";
+    if (spec.kind == MAIN_COURSE)
+    {
+        static const char* const SIDES[] = {"Rice", "Bread", "Salad", "Fries", "Soup"};
+        int side_count = static_cast<int>(uniformInt(rng, 0, 3));
+        for (int i = 0; i < side_count; i++)
+        {
+            spec.side_dishes.push_back({pick(rng, SIDES), static_cast<MainCourse::Category>(uniformInt(rng, 0, 7))});
+        }
+    }
+    return spec;
+}
+
+static Dish* buildDish(const DishSpec& spec)
+{
+    Dish* dish;
+    switch (spec.kind)
+    {
+        case APPETIZER:
+            dish = new Appetizer(spec.name, spec.ingredients, spec.prep_time, 0.0, spec.cuisine_type, static_cast<Appetizer::ServingStyle>(spec.style), spec.level, spec.flag);
+            break;
+        case MAIN_COURSE:
+            dish = new MainCourse(spec.name, spec.ingredients, spec.prep_time, 0.0, spec.cuisine_type, static_cast<MainCourse::CookingMethod>(spec.style), spec.protein_type, spec.side_dishes, spec.flag);
+            break;
+        default:
+            dish = new Dessert(spec.name, spec.ingredients, spec.prep_time, 0.0, spec.cuisine_type, static_cast<Dessert::FlavorProfile>(spec.style), spec.level, spec.flag);
+            break;
+    }
+    dish->setPriceCents(spec.price_cents);
+    return dish;
+}
+
+static Trace randomTrace(unsigned long long seed, int steps)
+{
+    std::mt19937_64 rng(seed);
+    Trace trace;
+    for (int step = 0; step < steps; step++)
+    {
+        Op op = {NEW_ORDER, 0, 0, std::string(), {}};
+        int roll = static_cast<int>(uniformInt(rng, 0, 99));
+        bool has_dishes = !trace.dishes.empty();
+        if (roll < 55 || !has_dishes)
+        {
+            op.type = NEW_ORDER;
+            if (has_dishes && chance(rng, 15))
+            {
+                op.dish = static_cast<int>(uniformInt(rng, 0, trace.dishes.size() - 1)); // the same pointer again
+            }
+            else
+            {
+                // A fresh dish, sometimes an equal copy of an earlier one under another pointer
+                trace.dishes.push_back(has_dishes && chance(rng, 10) ? trace.dishes[uniformInt(rng, 0, trace.dishes.size() - 1)] : randomDish(rng));
+                op.dish = static_cast<int>(trace.dishes.size() - 1);
+            }
+        }
+        else if (roll < 72)
+        {
+            op.type = SERVE_DISH;
+            op.dish = static_cast<int>(uniformInt(rng, 0, trace.dishes.size() - 1));
+        }
+        else if (roll < 75)
+        {
+            op.type = RELEASE_BELOW_PREP_TIME;
+            op.value = static_cast<int>(uniformInt(rng, 0, 40));
+        }
+        else if (roll < 78)
+        {
+            op.type = RELEASE_CUISINE_TYPE;
+            op.text = pick(rng, CUISINE_ARGUMENTS);
+        }
+        else if (roll < 84)
+        {
+            op.type = DIETARY_ADJUSTMENT;
+            op.request = {chance(rng, 40), chance(rng, 30), chance(rng, 30), chance(rng, 30), chance(rng, 30), chance(rng, 30)};
+        }
+        else if (roll < 91)
+        {
+            op.type = SET_PREP_TIME;
+            op.dish = static_cast<int>(uniformInt(rng, 0, trace.dishes.size() - 1));
+            op.value = static_cast<int>(uniformInt(rng, 1, 150));
+        }
+        else if (roll < 95)
+        {
+            op.type = SET_PRICE;
+            op.dish = static_cast<int>(uniformInt(rng, 0, trace.dishes.size() - 1));
+            op.value = static_cast<int>(uniformInt(rng, 0, 5000));
+        }
+        else
+        {
+            op.type = SET_CUISINE_TYPE;
+            op.dish = static_cast<int>(uniformInt(rng, 0, trace.dishes.size() - 1));
+            op.value = static_cast<int>(uniformInt(rng, 0, 6));
+        }
+        trace.ops.push_back(op);
+    }
+    return trace;
+}
+
+/**
+ * @class ReferenceKitchen
+ * @brief The obviously correct model: ArrayBag semantics on a vector, every result recomputed from the dishes.
+ */
+class ReferenceKitchen {
+public:
+    bool newOrder(Dish* dish)
+    {
+        if (indexOf(dish) >= 0 || static_cast<int>(items_.size()) == KITCHEN_CAPACITY)
+        {
+            return false;
+        }
+        items_.push_back(dish);
+        return true;
+    }
+
+    bool serveDish(Dish* dish)
+    {
+        int index = indexOf(dish);
+        if (index < 0)
+        {
+            return false;
+        }
+        items_[index] = items_.back();
+        items_.pop_back();
+        return true;
+    }
+
+    // Removes every matching dish in one forward pass; a removed slot is checked again after the last dish moves in
+    template <typename Predicate>
+    int releaseIf(Predicate matches)
+    {
+        int count = 0;
+        size_t i = 0;
+        while (i < items_.size())
+        {
+            if (matches(*items_[i]))
+            {
+                serveDish(items_[i]);
+                count++;
+            }
+            else
+            {
+                i++;
+            }
+        }
+        return count;
+    }
+
+    int releaseDishesBelowPrepTime(int prep_time)
+    {
+        return releaseIf([prep_time](const Dish& dish) { return dish.getPrepTime() < prep_time; });
+    }
+
+    int releaseDishesOfCuisineType(const std::string& cuisine_type)
+    {
+        Dish::CuisineType cuisine;
+        if (!parseCuisine(cuisine_type, cuisine))
+        {
+            return 0;
+        }
+        return releaseIf([cuisine](const Dish& dish) { return dish.getCuisineTypeEnum() == cuisine; });
+    }
+
+    void dietaryAdjustment(const Dish::DietaryRequest& request)
+    {
+        for (Dish* dish : items_)
+        {
+            dish->dietaryAccommodations(request);
+        }
+    }
+
+    int size() const
+    {
+        return static_cast<int>(items_.size());
+    }
+
+    int prepTimeSum() const
+    {
+        int total = 0;
+        for (const Dish* dish : items_)
+        {
+            total += dish->getPrepTime();
+        }
+        return total;
+    }
+
+    int avgPrepTime() const
+    {
+        return items_.empty() ? 0 : static_cast<int>(std::round(static_cast<double>(prepTimeSum()) / items_.size()));
+    }
+
+    int elaborateCount() const
+    {
+        int count = 0;
+        for (const Dish* dish : items_)
+        {
+            count += dish->getIngredientCount() >= 5 && dish->getPrepTime() >= 60 ? 1 : 0;
+        }
+        return count;
+    }
+
+    double elaboratePercentage() const
+    {
+        return items_.empty() ? 0.0 : std::round(static_cast<double>(elaborateCount()) / items_.size() * 10000) / 100;
+    }
+
+    int tally(const std::string& cuisine_type) const
+    {
+        Dish::CuisineType cuisine;
+        int count = 0;
+        for (const Dish* dish : items_)
+        {
+            count += parseCuisine(cuisine_type, cuisine) && dish->getCuisineTypeEnum() == cuisine ? 1 : 0;
+        }
+        return count;
+    }
+
+    Cents priceSum(const std::string* cuisine_type) const
+    {
+        Dish::CuisineType cuisine;
+        if (cuisine_type != nullptr && !parseCuisine(*cuisine_type, cuisine))
+        {
+            return 0;
+        }
+        Cents total = 0;
+        for (const Dish* dish : items_)
+        {
+            total += cuisine_type == nullptr || dish->getCuisineTypeEnum() == cuisine ? dish->getPriceCents() : 0;
+        }
+        return total;
+    }
+
+    Cents avgPriceCents() const
+    {
+        return items_.empty() ? 0 : averageCents(priceSum(nullptr), size());
+    }
+
+    std::string report() const
+    {
+        std::ostringstream out;
+        for (const char* cuisine : {"ITALIAN", "MEXICAN", "CHINESE", "INDIAN", "AMERICAN", "FRENCH", "OTHER"})
+        {
+            out << cuisine << ": " << tally(cuisine) << '\n';
+        }
+        char percentage[32];
+        std::snprintf(percentage, sizeof(percentage), "%.2f", elaboratePercentage());
+        out << "\nAVERAGE PREP TIME: " << avgPrepTime() << "\nELABORATE DISHES: " << percentage << "%\n";
+        return out.str();
+    }
+
+    // Formats every dish afresh with render(), bypassing the dishes' cached text
+    std::string menu(int offset, int limit) const
+    {
+        MenuRenderer out;
+        for (int i = offset; i < size() && i < offset + limit; i++)
+        {
+            items_[i]->render(out);
+        }
+        return out.str();
+    }
+
+    std::string csv() const
+    {
+        MenuRenderer out;
+        out.append("DishType,Name,Ingredients,PreparationTime,Price,CuisineType,AdditionalAttributes\n");
+        for (const Dish* dish : items_)
+        {
+            dish->writeCsv(out);
+        }
+        return out.str();
+    }
+
+    std::string json() const
+    {
+        MenuRenderer out;
+        out.append('[');
+        for (size_t i = 0; i < items_.size(); i++)
+        {
+            out.append(i == 0 ? "\n" : ",\n");
+            items_[i]->writeJson(out);
+        }
+        out.append("\n]\n");
+        return out.str();
+    }
+
+private:
+    static bool parseCuisine(const std::string& text, Dish::CuisineType& cuisine)
+    {
+        return tryEnumFromToken(Dish::CUISINE_TYPE_INFO, text, cuisine);
+    }
+
+    int indexOf(const Dish* dish) const
+    {
+        for (size_t i = 0; i < items_.size(); i++)
+        {
+            if (items_[i] == dish)
+            {
+                return static_cast<int>(i);
+            }
+        }
+        return -1;
+    }
+
+    std::vector<Dish*> items_;
+};
+
+// The dishes of one side, built on first use; dish i of both sides is built from the same DishSpec
+class DishPool {
+public:
+    explicit DishPool(const Trace& trace) : trace_(trace), dishes_(trace.dishes.size()) {}
+
+    Dish* get(int index)
+    {
+        if (!dishes_[index])
+        {
+            dishes_[index].reset(buildDish(trace_.dishes[index]));
+        }
+        return dishes_[index].get();
+    }
+
+    // Hands every dish to `kitchen`'s destructor or keeps it, depending on whether the kitchen still holds it
+    void releaseHeldBy(Kitchen& kitchen)
+    {
+        for (std::unique_ptr<Dish>& dish : dishes_)
+        {
+            if (dish && kitchen.contains(dish.get()))
+            {
+                dish.release();
+            }
+        }
+    }
+
+private:
+    const Trace& trace_;
+    std::vector<std::unique_ptr<Dish>> dishes_;
+};
+
+// Collects named results of one side and compares them with the other side's
+class Observations {
+public:
+    void add(const std::string& name, const std::string& value)
+    {
+        values_.push_back({name, value});
+    }
+
+    void add(const std::string& name, long long value)
+    {
+        add(name, std::to_string(value));
+    }
+
+    void addDouble(const std::string& name, double value)
+    {
+        MenuRenderer text;
+        text.appendDouble(value);
+        add(name, text.str());
+    }
+
+    bool matches(const Observations& actual, Mismatch& mismatch) const
+    {
+        for (size_t i = 0; i < values_.size(); i++)
+        {
+            if (values_[i].second != actual.values_[i].second)
+            {
+                mismatch.observable = values_[i].first;
+                mismatch.expected = values_[i].second;
+                mismatch.actual = actual.values_[i].second;
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    std::vector<std::pair<std::string, std::string>> values_;
+};
+
+static const char* const TALLY_ARGUMENTS[] = {"ITALIAN", "MEXICAN", "CHINESE", "INDIAN", "AMERICAN", "FRENCH", "OTHER", "PIZZA"};
+
+// A page that moves with the step, so paging is checked at many offsets
+static void pageOf(int step, int& offset, int& limit)
+{
+    offset = (step * 7) % 60 - 5;
+    limit = 1 + (step * 13) % 40;
+}
+
+static void observeReference(const ReferenceKitchen& kitchen, int step, Observations& out)
+{
+    out.add("getCurrentSize", kitchen.size());
+    out.add("getPrepTimeSum", kitchen.prepTimeSum());
+    out.add("calculateAvgPrepTime", kitchen.avgPrepTime());
+    out.add("elaborateDishCount", kitchen.elaborateCount());
+    out.addDouble("calculateElaboratePercentage", kitchen.elaboratePercentage());
+    out.add("getPriceCentsSum", kitchen.priceSum(nullptr));
+    out.add("calculateAvgPriceCents", kitchen.avgPriceCents());
+    for (const char* cuisine : TALLY_ARGUMENTS)
+    {
+        std::string argument = cuisine;
+        out.add(std::string("tallyCuisineTypes ") + cuisine, kitchen.tally(argument));
+        out.add(std::string("getPriceCentsSum ") + cuisine, kitchen.priceSum(&argument));
+    }
+    out.add("kitchenReport", kitchen.report());
+    std::string menu = kitchen.menu(0, KITCHEN_CAPACITY);
+    out.add("displayMenu", menu);
+    int offset, limit;
+    pageOf(step, offset, limit);
+    out.add("displayMenu page", kitchen.menu(offset < 0 ? 0 : offset, limit));
+    out.add("exportCsv", kitchen.csv());
+    out.add("exportJson", kitchen.json());
+}
+
+static void observeKitchen(const Kitchen& kitchen, int step, Observations& out)
+{
+    out.add("getCurrentSize", kitchen.getCurrentSize());
+    out.add("getPrepTimeSum", kitchen.getPrepTimeSum());
+    out.add("calculateAvgPrepTime", kitchen.calculateAvgPrepTime());
+    out.add("elaborateDishCount", kitchen.elaborateDishCount());
+    out.addDouble("calculateElaboratePercentage", kitchen.calculateElaboratePercentage());
+    out.add("getPriceCentsSum", kitchen.getPriceCentsSum());
+    out.add("calculateAvgPriceCents", kitchen.calculateAvgPriceCents());
+    for (const char* cuisine : TALLY_ARGUMENTS)
+    {
+        out.add(std::string("tallyCuisineTypes ") + cuisine, kitchen.tallyCuisineTypes(cuisine));
+        out.add(std::string("getPriceCentsSum ") + cuisine, kitchen.getPriceCentsSum(cuisine));
+    }
+    StringSink text;
+    kitchen.kitchenReport(text);
+    out.add("kitchenReport", text.str());
+    text.clear();
+    kitchen.displayMenu(text);
+    out.add("displayMenu", text.str());
+    text.clear();
+    int offset, limit;
+    pageOf(step, offset, limit);
+    kitchen.displayMenu(text, offset, limit);
+    out.add("displayMenu page", text.str());
+    text.clear();
+    kitchen.exportCsv(text);
+    out.add("exportCsv", text.str());
+    text.clear();
+    kitchen.exportJson(text);
+    out.add("exportJson", text.str());
+}
+
+// Replays a trace on both sides and returns false with the first mismatch
+static bool replay(const Trace& trace, Mismatch& mismatch)
+{
+    DishPool reference_dishes(trace);
+    DishPool kitchen_dishes(trace);
+    ReferenceKitchen reference;
+    Kitchen kitchen;
+    bool matched = true;
+    for (size_t step = 0; step < trace.ops.size() && matched; step++)
+    {
+        const Op& op = trace.ops[step];
+        Observations expected, actual;
+        switch (op.type)
+        {
+            case NEW_ORDER:
+                expected.add("newOrder", reference.newOrder(reference_dishes.get(op.dish)));
+                actual.add("newOrder", kitchen.newOrder(kitchen_dishes.get(op.dish)));
+                break;
+            case SERVE_DISH:
+                expected.add("serveDish", reference.serveDish(reference_dishes.get(op.dish)));
+                actual.add("serveDish", kitchen.serveDish(kitchen_dishes.get(op.dish)));
+                break;
+            case RELEASE_BELOW_PREP_TIME:
+                expected.add("releaseDishesBelowPrepTime", reference.releaseDishesBelowPrepTime(op.value));
+                actual.add("releaseDishesBelowPrepTime", kitchen.releaseDishesBelowPrepTime(op.value));
+                break;
+            case RELEASE_CUISINE_TYPE:
+                expected.add("releaseDishesOfCuisineType", reference.releaseDishesOfCuisineType(op.text));
+                actual.add("releaseDishesOfCuisineType", kitchen.releaseDishesOfCuisineType(op.text));
+                break;
+            case DIETARY_ADJUSTMENT:
+                reference.dietaryAdjustment(op.request);
+                kitchen.dietaryAdjustment(op.request);
+                break;
+            case SET_PREP_TIME:
+                reference_dishes.get(op.dish)->setPrepTime(op.value);
+                kitchen_dishes.get(op.dish)->setPrepTime(op.value);
+                break;
+            case SET_PRICE:
+                reference_dishes.get(op.dish)->setPriceCents(op.value);
+                kitchen_dishes.get(op.dish)->setPriceCents(op.value);
+                break;
+            case SET_CUISINE_TYPE:
+                reference_dishes.get(op.dish)->setCuisineType(static_cast<Dish::CuisineType>(op.value));
+                kitchen_dishes.get(op.dish)->setCuisineType(static_cast<Dish::CuisineType>(op.value));
+                break;
+        }
+        observeReference(reference, static_cast<int>(step), expected);
+        observeKitchen(kitchen, static_cast<int>(step), actual);
+        if (!expected.matches(actual, mismatch))
+        {
+            mismatch.step = static_cast<int>(step);
+            matched = false;
+        }
+    }
+    kitchen_dishes.releaseHeldBy(kitchen);
+    return matched;
+}
+
+// Removes chunks of operations, halving the chunk size, for as long as the trace keeps failing
+static Trace minimize(Trace trace, Mismatch& mismatch)
+{
+    trace.ops.resize(mismatch.step + 1);
+    size_t chunk = trace.ops.size() / 2;
+    while (chunk >= 1)
+    {
+        bool removed = false;
+        for (size_t begin = 0; begin < trace.ops.size();)
+        {
+            Trace candidate = trace;
+            size_t end = begin + chunk < candidate.ops.size() ? begin + chunk : candidate.ops.size();
+            candidate.ops.erase(candidate.ops.begin() + begin, candidate.ops.begin() + end);
+            Mismatch candidate_mismatch;
+            if (!candidate.ops.empty() && !replay(candidate, candidate_mismatch))
+            {
+                candidate.ops.resize(candidate_mismatch.step + 1);
+                trace = candidate;
+                mismatch = candidate_mismatch;
+                removed = true;
+            }
+            else
+            {
+                begin += chunk;
+            }
+        }
+        if (!removed)
+        {
+            chunk /= 2;
+        }
+        else if (chunk > trace.ops.size())
+        {
+            chunk = trace.ops.size();
+        }
+    }
+    return trace;
+}
+
+static void describeDish(const DishSpec& spec, std::ostream& out)
+{
+    static const char* const KINDS[] = {"Appetizer", "MainCourse", "Dessert"};
+    out << KINDS[spec.kind] << " \"" << spec.name << "\" prep=" << spec.prep_time << " cents=" << spec.price_cents
+        << ' ' << Dish::CUISINE_TYPE_INFO[spec.cuisine_type].token << " ingredients=";
+    for (size_t i = 0; i < spec.ingredients.size(); i++)
+    {
+        out << (i == 0 ? "" : ";") << spec.ingredients[i];
+    }
+}
+
+static void describeOp(const Trace& trace, const Op& op, std::vector<bool>& described, std::ostream& out)
+{
+    switch (op.type)
+    {
+        case NEW_ORDER: out << "newOrder #" << op.dish; break;
+        case SERVE_DISH: out << "serveDish #" << op.dish; break;
+        case RELEASE_BELOW_PREP_TIME: out << "releaseDishesBelowPrepTime " << op.value; break;
+        case RELEASE_CUISINE_TYPE: out << "releaseDishesOfCuisineType \"" << op.text << '"'; break;
+        case DIETARY_ADJUSTMENT:
+            out << "dietaryAdjustment" << (op.request.vegetarian ? " vegetarian" : "") << (op.request.vegan ? " vegan" : "")
+                << (op.request.gluten_free ? " gluten_free" : "") << (op.request.nut_free ? " nut_free" : "")
+                << (op.request.low_sodium ? " low_sodium" : "") << (op.request.low_sugar ? " low_sugar" : "");
+            return;
+        case SET_PREP_TIME: out << "setPrepTime #" << op.dish << ' ' << op.value; break;
+        case SET_PRICE: out << "setPriceCents #" << op.dish << ' ' << op.value; break;
+        case SET_CUISINE_TYPE: out << "setCuisineType #" << op.dish << ' ' << Dish::CUISINE_TYPE_INFO[op.value].token; break;
+    }
+    if (op.type != RELEASE_BELOW_PREP_TIME && op.type != RELEASE_CUISINE_TYPE && !described[op.dish])
+    {
+        described[op.dish] = true;
+        out << "  (";
+        describeDish(trace.dishes[op.dish], out);
+        out << ')';
+    }
+}
+
+// Narrows two differing texts down to their first differing line
+static void firstDifferingLine(std::string& expected, std::string& actual, int& line_number)
+{
+    std::istringstream expected_lines(expected), actual_lines(actual);
+    std::string expected_line, actual_line;
+    line_number = 1;
+    while (true)
+    {
+        bool has_expected = static_cast<bool>(std::getline(expected_lines, expected_line));
+        bool has_actual = static_cast<bool>(std::getline(actual_lines, actual_line));
+        if (!has_expected || !has_actual || expected_line != actual_line)
+        {
+            expected = has_expected ? expected_line : "<end of text>";
+            actual = has_actual ? actual_line : "<end of text>";
+            return;
+        }
+        line_number++;
+    }
+}
+
+static void report(unsigned long long seed, const Trace& trace, const Mismatch& mismatch)
+{
+    std::cout << "MISMATCH in run with seed " << seed << ", minimized to " << trace.ops.size() << " operations:\n";
+    std::vector<bool> described(trace.dishes.size(), false);
+    for (size_t i = 0; i < trace.ops.size(); i++)
+    {
+        std::cout << "  " << (i + 1) << ": ";
+        describeOp(trace, trace.ops[i], described, std::cout);
+        std::cout << '\n';
+    }
+    std::string expected = mismatch.expected;
+    std::string actual = mismatch.actual;
+    std::cout << "after operation " << (mismatch.step + 1) << ", " << mismatch.observable << " differs";
+    if (expected.find('\n') != std::string::npos || actual.find('\n') != std::string::npos)
+    {
+        int line_number;
+        firstDifferingLine(expected, actual, line_number);
+        std::cout << " at line " << line_number;
+    }
+    std::cout << "\n  reference: " << expected << "\n  kitchen:   " << actual << std::endl;
+}
+
+// Compares one counter with the count the workload is known to produce
+static bool expectCount(const char* operation, const char* field, uint64_t actual, uint64_t expected)
+{
+    if (actual != expected)
+    {
+        std::cout << "Stats mismatch: " << operation << " " << field << " is " << actual << ", expected " << expected << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Runs a fixed workload on a fresh kitchen and checks what Kitchen::stats() counted
+static bool checkStats()
+{
+    const int extra = 5;
+    std::mt19937_64 rng(1);
+    Trace trace;
+    for (int i = 0; i < KITCHEN_CAPACITY + extra; i++)
+    {
+        trace.dishes.push_back(randomDish(rng));
+    }
+    DishPool dishes(trace);
+    Kitchen kitchen;
+    Kitchen::stats().reset();
+    for (int i = 0; i < KITCHEN_CAPACITY + extra; i++)
+    {
+        kitchen.newOrder(dishes.get(i)); // the last `extra` find the kitchen full
+    }
+    kitchen.serveDish(dishes.get(0));
+    kitchen.serveDish(dishes.get(0));     // no longer in the kitchen
+    kitchen.newOrder(dishes.get(1));      // already in the kitchen
+    kitchen.tallyCuisineTypes("ITALIAN");
+    kitchen.tallyCuisineTypes("PIZZA");   // not a cuisine type
+    for (int i = 1; i < KITCHEN_CAPACITY; i++)
+    {
+        kitchen.serveDish(dishes.get(i));
+    }
+    KitchenStats::Snapshot stats = Kitchen::stats().snapshot();
+
+    const KitchenStats::OperationStats& new_order = stats[KitchenStats::NEW_ORDER];
+    const KitchenStats::OperationStats& serve_dish = stats[KitchenStats::SERVE_DISH];
+    const KitchenStats::OperationStats& tally = stats[KitchenStats::TALLY_CUISINE_TYPES];
+    return expectCount("newOrder", "calls", new_order.calls, KITCHEN_CAPACITY + extra + 1)
+        && expectCount("newOrder", "items", new_order.items, KITCHEN_CAPACITY)
+        && expectCount("newOrder", "rejections", new_order.rejections, 1)
+        && expectCount("newOrder", "capacity_drops", new_order.capacity_drops, extra)
+        && expectCount("serveDish", "calls", serve_dish.calls, KITCHEN_CAPACITY + 1)
+        && expectCount("serveDish", "items", serve_dish.items, KITCHEN_CAPACITY)
+        && expectCount("serveDish", "rejections", serve_dish.rejections, 1)
+        && expectCount("tallyCuisineTypes", "calls", tally.calls, 2)
+        && expectCount("tallyCuisineTypes", "rejections", tally.rejections, 1)
+        && expectCount("dietaryAdjustment", "calls", stats[KitchenStats::DIETARY_ADJUSTMENT].calls, 0);
+}
+
+// Lets a StatsDumper write the counters left by checkStats() and reads the block back
+static bool checkStatsDump()
+{
+    std::string filename = "difftest_stats.txt";
+    std::remove(filename.c_str());
+    {
+        StatsDumper dumper(filename, 60000); // stop() writes the one block before the first interval ends
+        dumper.stop();
+    }
+    std::ifstream file(filename);
+    std::stringstream text;
+    text << file.rdbuf();
+    std::remove(filename.c_str());
+
+    std::string expected_counters = "newOrder: calls=" + std::to_string(KITCHEN_CAPACITY + 6) + " ";
+    std::string dump = text.str();
+    if (dump.compare(0, 13, "# elapsed_ms=") != 0 || dump.find("\n" + expected_counters) == std::string::npos
+        || dump.find("serveDish: calls=" + std::to_string(KITCHEN_CAPACITY + 1) + " ") == std::string::npos)
+    {
+        std::cout << "Stats dump mismatch: expected a block with \"" << expected_counters << "...\", read:\n" << dump << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Formats a menu long enough to split on several threads and compares it with the serial rendering
+static bool checkParallelMenu()
+{
+    std::mt19937_64 rng(1);
+    std::vector<std::unique_ptr<Dish>> owned;
+    std::vector<Dish*> dishes;
+    for (int i = 0; i < PARALLEL_MENU_DISHES; i++)
+    {
+        owned.emplace_back(buildDish(randomDish(rng)));
+        dishes.push_back(owned.back().get());
+    }
+    MenuRenderer serial;
+    serial.renderMenu(dishes.data(), PARALLEL_MENU_DISHES);
+    ParallelMenuRenderer parallel(PARALLEL_THREADS);
+    parallel.renderMenu(dishes.data(), PARALLEL_MENU_DISHES);
+    std::string expected = serial.str();
+    std::string actual = parallel.str();
+    if (actual != expected)
+    {
+        int line_number;
+        firstDifferingLine(expected, actual, line_number);
+        std::cout << "Parallel menu mismatch at line " << line_number << ":\n  serial:   " << expected
+                  << "\n  parallel: " << actual << std::endl;
+        return false;
+    }
+    return true;
+}
+
+static bool parseOptions(int argc, char* argv[], Options& options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        bool has_value = i + 1 < argc;
+        if (std::strcmp(argv[i], "--seed") == 0 && has_value)
+        {
+            options.seed = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (std::strcmp(argv[i], "--runs") == 0 && has_value)
+        {
+            options.runs = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--steps") == 0 && has_value)
+        {
+            options.steps = std::atoi(argv[++i]);
+        }
+        else
+        {
+            std::cerr << "Usage: " << argv[0] << " [--seed S] [--runs N] [--steps N]" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (!parseOptions(argc, argv, options))
+    {
+        return 2;
+    }
+    if (KitchenStats::ENABLED)
+    {
+        if (!checkStats() || !checkStatsDump())
+        {
+            return 1;
+        }
+        std::cout << "Kitchen::stats() and its StatsDumper block matched the counts of a known workload" << std::endl;
+    }
+    if (!checkParallelMenu())
+    {
+        return 1;
+    }
+    for (int run = 0; run < options.runs; run++)
+    {
+        unsigned long long seed = options.seed + run;
+        Trace trace = randomTrace(seed, options.steps);
+        Mismatch mismatch;
+        if (!replay(trace, mismatch))
+        {
+            Trace minimal = minimize(trace, mismatch);
+            report(seed, minimal, mismatch);
+            std::cout << "Reproduce with: " << argv[0] << " --seed " << seed << " --runs 1 --steps " << options.steps << std::endl;
+            return 1;
+        }
+    }
+    std::cout << options.runs << " runs of " << options.steps << " operations matched the reference (seeds "
+              << options.seed << " to " << (options.seed + options.runs - 1) << ")" << std::endl;
+    return 0;
+}
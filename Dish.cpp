@@ -12,15 +12,18 @@
  */
 
 #include "Dish.hpp"
+#include "Kitchen.hpp"
+#include "MenuRenderer.hpp"
+#include <string_view>
 
 // Default Constructor
 Dish::Dish() 
-    : name_("UNKNOWN"), ingredients_({}), prep_time_(0), price_(0.0), cuisine_type_(CuisineType::OTHER) {
+    : name_("UNKNOWN"), ingredients_({}), prep_time_(0), price_cents_(0), cuisine_type_(CuisineType::OTHER), rendered_text_(), dirty_(true) {
 }
 
 // Parameterized Constructor
 Dish::Dish(const std::string& name, const std::vector<std::string>& ingredients, int prep_time, double price, CuisineType cuisine_type)
-    : ingredients_(ingredients), prep_time_(prep_time), price_(price), cuisine_type_(cuisine_type) {
+    : ingredients_(ingredients), prep_time_(prep_time), price_cents_(centsFromDouble(price)), cuisine_type_(cuisine_type), rendered_text_(), dirty_(true) {
     setName(name);  // Use setName to validate the name
 }
 
@@ -33,24 +36,28 @@ std::vector<std::string> Dish::getIngredients() const {
     return ingredients_;
 }
 
+size_t Dish::getIngredientCount() const {
+    return ingredients_.size();
+}
+
 int Dish::getPrepTime() const {
     return prep_time_;
 }
 
 double Dish::getPrice() const {
-    return price_;
+    return centsToDouble(price_cents_);
+}
+
+Cents Dish::getPriceCents() const {
+    return price_cents_;
 }
 
 std::string Dish::getCuisineType() const {
-    switch (cuisine_type_) {
-        case CuisineType::ITALIAN: return "ITALIAN";
-        case CuisineType::MEXICAN: return "MEXICAN";
-        case CuisineType::CHINESE: return "CHINESE";
-        case CuisineType::INDIAN: return "INDIAN";
-        case CuisineType::AMERICAN: return "AMERICAN";
-        case CuisineType::FRENCH: return "FRENCH";
-        default: return "OTHER";
-    }
+    return std::string(cuisineTypeName());
+}
+
+Dish::CuisineType Dish::getCuisineTypeEnum() const {
+    return cuisine_type_;
 }
 
 // Mutator Functions
@@ -60,38 +67,139 @@ void Dish::setName(const std::string& name) {
     } else {
         name_ = "UNKNOWN";
     }
+    markDirty();
 }
 
 void Dish::setIngredients(const std::vector<std::string>& ingredients) {
     ingredients_ = ingredients;
+    markDirty();
 }
 
 void Dish::setPrepTime(const int& prep_time) {
     prep_time_ = prep_time;
+    markDirty();
 }
 
 void Dish::setPrice(const double& price) {
-    price_ = price;
+    price_cents_ = centsFromDouble(price);
+    markDirty();
+}
+
+void Dish::setPriceCents(Cents price_cents) {
+    price_cents_ = price_cents;
+    markDirty();
 }
 
 void Dish::setCuisineType(const CuisineType& cuisine_type) {
     cuisine_type_ = cuisine_type;
+    markDirty();
 }
 
 // Display Function
 void Dish::display() const {
-    std::cout << "Dish Name: " << name_ << std::endl;
-    std::cout << "Ingredients: ";
+    StreamSink console(std::cout);
+    display(console);
+}
+
+void Dish::display(OutputSink& out) const {
+    const std::string& text = renderedText();
+    out.write(text.data(), text.size());
+    out.flush();
+}
+
+// Cached Display Text
+const std::string& Dish::renderedText() const {
+    if (dirty_) {
+        // Format into the old cache string so its capacity is reused
+        MenuRenderer renderer;
+        renderer.swap(rendered_text_);
+        renderer.clear();
+        render(renderer);
+        renderer.swap(rendered_text_);
+        dirty_ = false;
+    }
+    return rendered_text_;
+}
+
+bool Dish::isDirty() const {
+    return dirty_;
+}
+
+bool Dish::inKitchen() const {
+    return owner_.kitchen != nullptr;
+}
+
+void Dish::markDirty() {
+    dirty_ = true;
+    if (owner_.kitchen != nullptr) {
+        owner_.kitchen->dishChanged(this);
+    }
+}
+
+void Dish::render(MenuRenderer& out) const {
+    out.append("Dish Name: ").append(name_).append('\n');
+    out.append("Ingredients: ");
     for (size_t i = 0; i < ingredients_.size(); ++i) {
-        std::cout << ingredients_[i];
+        out.append(ingredients_[i]);
         if (i != ingredients_.size() - 1) {
-            std::cout << ", ";
+            out.append(", ");
+        }
+    }
+    out.append('\n');
+    out.append("Preparation Time: ").appendInt(prep_time_).append(" minutes\n");
+    out.append("Price: $").appendPrice(price_cents_).append('\n');
+    out.append("Cuisine Type: ").append(cuisineTypeName()).append('\n');
+}
+
+void Dish::writeCsv(MenuRenderer& out) const {
+    out.appendCsvField(name_).append(',');
+    // Ingredients are joined with ';' inside a single field, so that field is quoted as a whole if needed. The
+    // loader only honors escapes in a quoted field, and reads a quoted "" as one empty ingredient rather than none.
+    bool needs_quotes = false;
+    for (size_t i = 0; i < ingredients_.size() && !needs_quotes; ++i) {
+        needs_quotes = ingredients_[i].empty() || ingredients_[i].find_first_of(",\"\r\n;|:\\") != std::string::npos;
+    }
+    if (!needs_quotes) {
+        for (size_t i = 0; i < ingredients_.size(); ++i) {
+            if (i != 0) {
+                out.append(';');
+            }
+            out.appendCsvItem(ingredients_[i]);
+        }
+    } else {
+        MenuRenderer joined;
+        for (size_t i = 0; i < ingredients_.size(); ++i) {
+            if (i != 0) {
+                joined.append(';');
+            }
+            joined.appendCsvItem(ingredients_[i]);
         }
+        out.appendCsvField(joined.str(), true);
     }
-    std::cout << std::endl;
-    std::cout << "Preparation Time: " << prep_time_ << " minutes" << std::endl;
-    std::cout << std::fixed << std::setprecision(2) << "Price: $" << price_ << std::endl;
-    std::cout << "Cuisine Type: " << getCuisineType() << std::endl;
+    out.append(',');
+    out.appendInt(prep_time_).append(',');
+    out.appendDouble(getPrice()).append(',');
+    out.append(cuisineTypeName()).append(',');
+}
+
+void Dish::writeJson(MenuRenderer& out) const {
+    out.append(",\"name\":").appendJsonString(name_);
+    out.append(",\"ingredients\":[");
+    for (size_t i = 0; i < ingredients_.size(); ++i) {
+        if (i != 0) {
+            out.append(',');
+        }
+        out.appendJsonString(ingredients_[i]);
+    }
+    out.append(']');
+    out.append(",\"prep_time\":").appendInt(prep_time_);
+    out.append(",\"price\":").appendDouble(getPrice());
+    out.append(",\"cuisine_type\":\"").append(cuisineTypeName()).append('"');
+}
+
+// Looks up the cuisine type name without building a string
+std::string_view Dish::cuisineTypeName() const {
+    return enumInfo(CUISINE_TYPE_INFO, cuisine_type_, CuisineType::OTHER).token;
 }
 
 // Helper function to check if the name is valid
@@ -113,7 +221,7 @@ bool Dish::isValidName(const std::string& name) const {
     */
 bool Dish::operator==(const Dish& rhs) const {
     return name_ == rhs.name_ && prep_time_ == rhs.prep_time_ && 
-    price_ == rhs.price_ && cuisine_type_ == rhs.cuisine_type_;
+    price_cents_ == rhs.price_cents_ && cuisine_type_ == rhs.cuisine_type_;
 }
 
     /**
@@ -15,16 +15,37 @@
 #define DISH_HPP
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <iostream>
 #include <iomanip> // For std::fixed and std::setprecision
 #include <cctype>  // For std::isalpha, std::isspace
+#include "EnumTable.hpp"
+#include "Money.hpp"
+
+class Kitchen;
+class MenuRenderer;
+class OutputSink;
 
 class Dish {
 public:
     // CuisineType enum definition
     enum CuisineType { ITALIAN, MEXICAN, CHINESE, INDIAN, AMERICAN, FRENCH, OTHER };
 
+    /**
+     * Metadata of each cuisine type, indexed by CuisineType.
+     * Cuisine types are displayed with their upper-case token.
+     */
+    static constexpr EnumInfo<CuisineType> CUISINE_TYPE_INFO[] = {
+        {ITALIAN, "ITALIAN", "ITALIAN", 0},
+        {MEXICAN, "MEXICAN", "MEXICAN", 0},
+        {CHINESE, "CHINESE", "CHINESE", 0},
+        {INDIAN, "INDIAN", "INDIAN", 0},
+        {AMERICAN, "AMERICAN", "AMERICAN", 0},
+        {FRENCH, "FRENCH", "FRENCH", 0},
+        {OTHER, "OTHER", "OTHER", 0},
+    };
+
 /**
  * Structure to store dietary accommodation details.
  */
@@ -72,21 +93,36 @@ public:
      */
     std::vector<std::string> getIngredients() const;
 
+    /**
+     * @return The number of ingredients, without copying the list.
+     */
+    size_t getIngredientCount() const;
+
     /**
      * @return The preparation time in minutes.
      */
     int getPrepTime() const;
 
     /**
-     * @return The price of the dish.
+     * @return The price of the dish in dollars, converted from the stored cents.
      */
     double getPrice() const;
 
+    /**
+     * @return The price of the dish in cents, exactly as stored.
+     */
+    Cents getPriceCents() const;
+
     /**
      * @return The cuisine type of the dish in string form.
      */
     std::string getCuisineType() const;
 
+    /**
+     * @return The cuisine type of the dish as a CuisineType enum.
+     */
+    CuisineType getCuisineTypeEnum() const;
+
     // Mutators
     /**
      * Sets the name of the dish.
@@ -111,11 +147,18 @@ public:
 
     /**
      * Sets the price of the dish.
-     * @param price The new price of the dish.
-     * @post Sets the private member `price_` to the value of the parameter.
+     * @param price The new price of the dish in dollars.
+     * @post Sets the private member `price_cents_` to the price rounded to the nearest cent.
      */
     void setPrice(const double& price);
 
+    /**
+     * Sets the price of the dish in cents.
+     * @param price_cents The new price of the dish in cents.
+     * @post Sets the private member `price_cents_` to the value of the parameter.
+     */
+    void setPriceCents(Cents price_cents);
+
     /**
      * Sets the cuisine type of the dish.
      * @param cuisine_type The new cuisine type of the dish (a CuisineType enum).
@@ -126,8 +169,39 @@ public:
     // Display function
     /**
      * Displays the details of the dish.
-     * @post Outputs the dish's details, including name, ingredients, preparation time, price, and cuisine type, to the standard output.
-     * The information must be displayed in the following format:
+     * @post Writes renderedText() to the standard output in a single write.
+     */
+    void display() const;
+
+    /**
+     * Displays the details of the dish.
+     * @param out The sink that receives the text.
+     * @post Writes renderedText() to the sink in a single write.
+     */
+    void display(OutputSink& out) const;
+
+    /**
+     * @return The display text of the dish, as produced by render().
+     * @post If the dish is dirty, the text is formatted again and cached, and the dish is no longer dirty.
+     */
+    const std::string& renderedText() const;
+
+    /**
+     * @return True if the dish changed since its display text was last formatted, false otherwise.
+     */
+    bool isDirty() const;
+
+    /**
+     * @return True if a kitchen holds the dish, i.e. it was added by Kitchen::newOrder() and not served since.
+     */
+    bool inKitchen() const;
+
+    /**
+     * Appends the details of the dish to a renderer's buffer.
+     * Must be overridden by derived classes, which call Dish::render() first and then append their own lines.
+     * @param out The renderer whose buffer receives the text.
+     * @post Appends the dish's details, including name, ingredients, preparation time, price, and cuisine type.
+     * The information is appended in the following format:
      *
      * Dish Name: [Name of the dish]
      * Ingredients: [Comma-separated list of ingredients]
@@ -135,11 +209,25 @@ public:
      * Price: $[Price, formatted to two decimal places]
      * Cuisine Type: [Cuisine type]
      */
+    virtual void render(MenuRenderer& out) const = 0;
+
     /**
- * Pure virtual function to display dish details.
- * Must be overridden by derived classes.
- */
-    virtual void display() const = 0;
+     * Appends the dish as one CSV row in the Dishes.csv schema.
+     * Must be overridden by derived classes, which append their DishType column, call Dish::writeCsv(),
+     * then append the AdditionalAttributes column and the line break.
+     * @param out The renderer whose buffer receives the text.
+     * @post Appends "Name,Ingredients,PreparationTime,Price,CuisineType," with ingredients separated by ';'.
+     */
+    virtual void writeCsv(MenuRenderer& out) const = 0;
+
+    /**
+     * Appends the dish as one JSON object.
+     * Must be overridden by derived classes, which open the object with their "type" member, call Dish::writeJson(),
+     * then append their own members and close the object.
+     * @param out The renderer whose buffer receives the text.
+     * @post Appends the "name", "ingredients", "prep_time", "price" and "cuisine_type" members, each preceded by a comma.
+     */
+    virtual void writeJson(MenuRenderer& out) const = 0;
 
     /**
      @param : A const reference to the right-hand side of the `==` operator.
@@ -172,12 +260,43 @@ the dietary accommodations.
 leaks. */
     virtual ~Dish() = default;
 
+    // Copying and moving are member-wise; declared explicitly because the virtual destructor would otherwise suppress the moves
+    Dish(const Dish&) = default;
+    Dish(Dish&&) = default;
+    Dish& operator=(const Dish&) = default;
+    Dish& operator=(Dish&&) = default;
+
+protected:
+    /**
+     * Marks the cached display text as out of date.
+     * @post The next call to renderedText() formats the dish again, and the kitchen holding the dish, if any,
+     * copies its hot fields again before its next aggregate scan.
+     * Derived classes call this from every mutator and from dietaryAccommodations().
+     */
+    void markDirty();
+
 private:
+    friend class Kitchen;
+
+    // The kitchen holding the dish, set by Kitchen::newOrder() and cleared by Kitchen::serveDish().
+    // A copy of a dish is in no kitchen, so copying and assigning leave the link alone.
+    struct OwnerLink
+    {
+        Kitchen* kitchen = nullptr;
+
+        OwnerLink() = default;
+        OwnerLink(const OwnerLink&) {}
+        OwnerLink& operator=(const OwnerLink&) { return *this; }
+    };
+
     std::string name_;
     std::vector<std::string> ingredients_;
     int prep_time_;
-    double price_;
+    Cents price_cents_; // fixed point, so equality and sums are exact
     CuisineType cuisine_type_;
+    mutable std::string rendered_text_; // display text cached by renderedText()
+    mutable bool dirty_; // true when rendered_text_ no longer matches the dish
+    OwnerLink owner_; // told by markDirty() that the dish changed
 
     // Helper function to check if the name is valid
     /**
@@ -186,6 +305,13 @@ private:
      * @return True if the name contains only alphabetic characters and spaces; false otherwise.
      */
     bool isValidName(const std::string& name) const;
+
+    /**
+     * @return The cuisine type name, looked up without constructing a string.
+     */
+    std::string_view cuisineTypeName() const;
 };
 
+static_assert(isIndexedByValue(Dish::CUISINE_TYPE_INFO), "CUISINE_TYPE_INFO must be indexed by CuisineType");
+
 #endif // DISH_HPP
@@ -0,0 +1,43 @@
+/**
+ * @file DishHeader.hpp
+ * @brief This file contains the declaration of the DishHeader structure, the packed hot fields of a dish.
+ *
+ * Aggregate scans (average prep time, cuisine tallies, prep time releases) only need a dish's preparation time,
+ * price and cuisine type. Reading them through `Dish*` touches the vtable pointer's cache line of every heap-allocated
+ * dish. A DishHeader copies those scalars into 16 bytes, so an array of headers packs four dishes per 64-byte cache
+ * line and the names, ingredient vectors and subclass fields stay out of the scan.
+ *
+ * @date October 17, 2026
+ * @author Kun Feng Wei
+ */
+
+#ifndef DISH_HEADER_HPP
+#define DISH_HEADER_HPP
+
+#include "Dish.hpp"
+#include <cstdint>
+
+struct DishHeader
+{
+    int32_t prep_time;     ///< Copy of Dish::getPrepTime().
+    uint8_t cuisine_type;  ///< Copy of Dish::getCuisineTypeEnum().
+    uint8_t reserved_[3];  ///< Padding, kept zero.
+    Cents price_cents;     ///< Copy of Dish::getPriceCents().
+
+    /**
+     * @param dish A reference to the dish to summarize.
+     * @return A header holding the dish's current hot fields.
+     */
+    static DishHeader of(const Dish& dish)
+    {
+        DishHeader header = {};
+        header.prep_time = dish.getPrepTime();
+        header.cuisine_type = static_cast<uint8_t>(dish.getCuisineTypeEnum());
+        header.price_cents = dish.getPriceCents();
+        return header;
+    }
+};
+
+static_assert(sizeof(DishHeader) == 16, "DishHeader must stay 16 bytes so four fit in a cache line");
+
+#endif // DISH_HEADER_HPP
@@ -0,0 +1,146 @@
+/**
+ * @file DishStore.cpp
+ * @brief This file contains the implementation of the DishStore class, a devirtualized alternative to storing `Dish*` in a Kitchen.
+ *
+ * Virtual member functions are called with a qualified name (e.g. `appetizer.Appetizer::dietaryAccommodations()`),
+ * which binds them at compile time because every element of a partition has exactly that type.
+ *
+ * @date October 17, 2026
+ * @author Kun Feng Wei
+ */
+
+#include "DishStore.hpp"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * Default constructor.
+ * Initializes an empty store.
+ */
+DishStore::DishStore() : appetizers_(), main_courses_(), desserts_() {
+}
+
+bool DishStore::add(const Dish& dish) {
+    if (const Appetizer* appetizer = dynamic_cast<const Appetizer*>(&dish)) {
+        appetizers_.push_back(*appetizer);
+    } else if (const MainCourse* main_course = dynamic_cast<const MainCourse*>(&dish)) {
+        main_courses_.push_back(*main_course);
+    } else if (const Dessert* dessert = dynamic_cast<const Dessert*>(&dish)) {
+        desserts_.push_back(*dessert);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void DishStore::add(Appetizer appetizer) {
+    appetizers_.push_back(std::move(appetizer));
+}
+
+void DishStore::add(MainCourse main_course) {
+    main_courses_.push_back(std::move(main_course));
+}
+
+void DishStore::add(Dessert dessert) {
+    desserts_.push_back(std::move(dessert));
+}
+
+void DishStore::addAll(Dish* const* dishes, int count) {
+    for (int i = 0; i < count; i++) {
+        add(*dishes[i]);
+    }
+}
+
+int DishStore::getCurrentSize() const {
+    return static_cast<int>(appetizers_.size() + main_courses_.size() + desserts_.size());
+}
+
+void DishStore::clear() {
+    appetizers_.clear();
+    main_courses_.clear();
+    desserts_.clear();
+}
+
+const std::vector<Appetizer>& DishStore::getAppetizers() const {
+    return appetizers_;
+}
+
+const std::vector<MainCourse>& DishStore::getMainCourses() const {
+    return main_courses_;
+}
+
+const std::vector<Dessert>& DishStore::getDesserts() const {
+    return desserts_;
+}
+
+// Sums a member over one partition; getPrepTime() is not virtual, so this is a plain strided loop
+template <class DishType>
+static long long sumPrepTimes(const std::vector<DishType>& dishes) {
+    long long sum = 0;
+    for (const DishType& dish : dishes) {
+        sum += dish.getPrepTime();
+    }
+    return sum;
+}
+
+long long DishStore::getPrepTimeSum() const {
+    return sumPrepTimes(appetizers_) + sumPrepTimes(main_courses_) + sumPrepTimes(desserts_);
+}
+
+int DishStore::calculateAvgPrepTime() const {
+    if (getCurrentSize() == 0) {
+        return 0;
+    }
+    return static_cast<int>(std::round(static_cast<double>(getPrepTimeSum()) / getCurrentSize()));
+}
+
+template <class DishType>
+static int countCuisine(const std::vector<DishType>& dishes, Dish::CuisineType cuisine_type) {
+    int count = 0;
+    for (const DishType& dish : dishes) {
+        count += dish.getCuisineTypeEnum() == cuisine_type;
+    }
+    return count;
+}
+
+int DishStore::tallyCuisineTypes(Dish::CuisineType cuisine_type) const {
+    return countCuisine(appetizers_, cuisine_type) + countCuisine(main_courses_, cuisine_type) + countCuisine(desserts_, cuisine_type);
+}
+
+template <class DishType>
+static int releaseBelow(std::vector<DishType>& dishes, int prep_time) {
+    size_t before = dishes.size();
+    dishes.erase(std::remove_if(dishes.begin(), dishes.end(),
+                                [prep_time](const DishType& dish) { return dish.getPrepTime() < prep_time; }),
+                 dishes.end());
+    return static_cast<int>(before - dishes.size());
+}
+
+int DishStore::releaseDishesBelowPrepTime(int prep_time) {
+    return releaseBelow(appetizers_, prep_time) + releaseBelow(main_courses_, prep_time) + releaseBelow(desserts_, prep_time);
+}
+
+void DishStore::dietaryAdjustment(const Dish::DietaryRequest& request) {
+    for (Appetizer& appetizer : appetizers_) {
+        appetizer.Appetizer::dietaryAccommodations(request);
+    }
+    for (MainCourse& main_course : main_courses_) {
+        main_course.MainCourse::dietaryAccommodations(request);
+    }
+    for (Dessert& dessert : desserts_) {
+        dessert.Dessert::dietaryAccommodations(request);
+    }
+}
+
+void DishStore::renderMenu(MenuRenderer& out) const {
+    out.clear();
+    for (const Appetizer& appetizer : appetizers_) {
+        out.append(appetizer.renderedText());
+    }
+    for (const MainCourse& main_course : main_courses_) {
+        out.append(main_course.renderedText());
+    }
+    for (const Dessert& dessert : desserts_) {
+        out.append(dessert.renderedText());
+    }
+}
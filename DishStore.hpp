@@ -0,0 +1,151 @@
+/**
+ * @file DishStore.hpp
+ * @brief This file contains the declaration of the DishStore class, a devirtualized alternative to storing `Dish*` in a Kitchen.
+ *
+ * A DishStore keeps dishes by value in three type-partitioned arrays, one per subclass. Batch operations loop over each
+ * array with the concrete type known at compile time, so calls such as dietaryAccommodations() are bound statically
+ * and can be inlined, and the objects sit next to each other in memory instead of being scattered across the heap.
+ * Dishes are kept in insertion order within each partition; appetizers come first, then main courses, then desserts.
+ *
+ * @date October 17, 2026
+ * @author Kun Feng Wei
+ */
+
+#ifndef DISH_STORE_HPP
+#define DISH_STORE_HPP
+
+#include "Appetizer.hpp"
+#include "MainCourse.hpp"
+#include "Dessert.hpp"
+#include "MenuRenderer.hpp"
+#include <vector>
+
+class DishStore {
+public:
+    /**
+     * Default constructor.
+     * Initializes an empty store.
+     */
+    DishStore();
+
+    /**
+     * Adds a copy of a dish to the partition of its type.
+     * @param dish A reference to the dish to copy.
+     * @return True if the dish is an Appetizer, MainCourse or Dessert and was added, false otherwise.
+     */
+    bool add(const Dish& dish);
+
+    /**
+     * Adds an appetizer.
+     * @param appetizer The appetizer to add.
+     */
+    void add(Appetizer appetizer);
+
+    /**
+     * Adds a main course.
+     * @param main_course The main course to add.
+     */
+    void add(MainCourse main_course);
+
+    /**
+     * Adds a dessert.
+     * @param dessert The dessert to add.
+     */
+    void add(Dessert dessert);
+
+    /**
+     * Copies every dish of a `Dish*` range into the store.
+     * @param dishes A pointer to the first `Dish*` of the range.
+     * @param count The number of dishes in the range.
+     */
+    void addAll(Dish* const* dishes, int count);
+
+    /**
+     * @return The number of dishes in the store.
+     */
+    int getCurrentSize() const;
+
+    /**
+     * Removes every dish.
+     */
+    void clear();
+
+    /**
+     * @return A const reference to the appetizer partition.
+     */
+    const std::vector<Appetizer>& getAppetizers() const;
+
+    /**
+     * @return A const reference to the main course partition.
+     */
+    const std::vector<MainCourse>& getMainCourses() const;
+
+    /**
+     * @return A const reference to the dessert partition.
+     */
+    const std::vector<Dessert>& getDesserts() const;
+
+    /**
+     * @return The sum of the preparation times of all dishes.
+     */
+    long long getPrepTimeSum() const;
+
+    /**
+     * @return The average preparation time rounded to the nearest integer, or 0 if the store is empty.
+     * Same rounding as Kitchen::calculateAvgPrepTime().
+     */
+    int calculateAvgPrepTime() const;
+
+    /**
+     * @param cuisine_type The cuisine type to count.
+     * @return The number of dishes of the given cuisine type.
+     */
+    int tallyCuisineTypes(Dish::CuisineType cuisine_type) const;
+
+    /**
+     * Removes all dishes whose preparation time is less than the given time.
+     * @param prep_time The preparation time threshold.
+     * @return The number of dishes removed.
+     */
+    int releaseDishesBelowPrepTime(int prep_time);
+
+    /**
+     * Adjusts every dish to the given dietary request.
+     * @param request A DietaryRequest structure specifying the dietary accommodations.
+     */
+    void dietaryAdjustment(const Dish::DietaryRequest& request);
+
+    /**
+     * Formats every dish, partition by partition, into a renderer.
+     * @param out The renderer whose buffer receives the menu. Previous content is discarded.
+     */
+    void renderMenu(MenuRenderer& out) const;
+
+    /**
+     * Calls a function on every dish with its concrete type.
+     * @param visit A callable accepting `Appetizer&`, `MainCourse&` and `Dessert&`.
+     */
+    template <class Visitor>
+    void forEach(Visitor&& visit)
+    {
+        for (Appetizer& appetizer : appetizers_)
+        {
+            visit(appetizer);
+        }
+        for (MainCourse& main_course : main_courses_)
+        {
+            visit(main_course);
+        }
+        for (Dessert& dessert : desserts_)
+        {
+            visit(dessert);
+        }
+    }
+
+private:
+    std::vector<Appetizer> appetizers_;
+    std::vector<MainCourse> main_courses_;
+    std::vector<Dessert> desserts_;
+};
+
+#endif // DISH_STORE_HPP
@@ -0,0 +1,96 @@
+/**
+ * @file EnumTable.hpp
+ * @brief This file contains the EnumInfo structure and the lookup helpers shared by the dish enum metadata tables.
+ *
+ * Every dish enum has one constexpr table, declared next to the enum, holding for each value its upper-case CSV token,
+ * its display name and a set of property bits. Tables are indexed by the enum value, so value -> metadata is a
+ * direct array access; token -> value scans a table of at most eight entries and never constructs a string.
+ *
+ * @date October 17, 2026
+ * @author Kun Feng Wei
+ */
+
+#ifndef ENUM_TABLE_HPP
+#define ENUM_TABLE_HPP
+
+#include <cstddef>
+#include <string_view>
+
+/**
+ * Metadata of one enum value.
+ */
+template <class Enum>
+struct EnumInfo
+{
+    Enum value;                     ///< The enum value, equal to its index in the table.
+    std::string_view token;         ///< Upper-case token used in the CSV files, e.g. "FAMILY_STYLE".
+    std::string_view display_name;  ///< Name printed by display(), e.g. "Family Style".
+    unsigned properties;            ///< Bit set of enum-specific properties (0 if none).
+};
+
+/**
+ * @param table The metadata table.
+ * @return True if every entry sits at the index equal to its value, false otherwise.
+ * Used in static_asserts so value lookups can index the table directly.
+ */
+template <class Enum, size_t N>
+constexpr bool isIndexedByValue(const EnumInfo<Enum> (&table)[N])
+{
+    for (size_t i = 0; i < N; i++)
+    {
+        if (static_cast<size_t>(table[i].value) != i)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @param table The metadata table.
+ * @param value The enum value to look up.
+ * @param fallback The value whose entry is returned if `value` is out of range.
+ * @return A reference to the metadata of `value`.
+ */
+template <class Enum, size_t N>
+constexpr const EnumInfo<Enum>& enumInfo(const EnumInfo<Enum> (&table)[N], Enum value, Enum fallback)
+{
+    size_t index = static_cast<size_t>(value);
+    return index < N ? table[index] : table[static_cast<size_t>(fallback)];
+}
+
+/**
+ * @param table The metadata table.
+ * @param token The upper-case token to look up. Only an exact match counts.
+ * @param[out] value Receives the matching enum value if one is found.
+ * @return True if `token` matches an entry, false otherwise.
+ */
+template <class Enum, size_t N>
+constexpr bool tryEnumFromToken(const EnumInfo<Enum> (&table)[N], std::string_view token, Enum& value)
+{
+    for (size_t i = 0; i < N; i++)
+    {
+        if (table[i].token == token)
+        {
+            value = table[i].value;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @param table The metadata table.
+ * @param token The upper-case token to look up.
+ * @param fallback The value returned when `token` matches no entry.
+ * @return The matching enum value, or `fallback`.
+ */
+template <class Enum, size_t N>
+constexpr Enum enumFromToken(const EnumInfo<Enum> (&table)[N], std::string_view token, Enum fallback)
+{
+    Enum value = fallback;
+    tryEnumFromToken(table, token, value);
+    return value;
+}
+
+#endif // ENUM_TABLE_HPP
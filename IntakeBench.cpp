@@ -0,0 +1,294 @@
+/**
+ * @file IntakeBench.cpp
+ * @brief This file contains the order intake benchmark, which compares the lock-free OrderQueue with producers serializing on a mutex.
+ *
+ * Several producer threads each submit the same number of pre-built dishes to one kitchen:
+ *
+ *   queue  producers tryPush() into an OrderQueue (yielding and retrying when it is full) while the main thread drains
+ *          it in batches with drainInto()
+ *   mutex  producers lock a mutex around Kitchen::newOrder()
+ *
+ * A Kitchen holds at most 100 dishes, so whenever it is full the kitchen thread (or, with the mutex, the producer that
+ * found it full) replaces it with an empty one, whose destructor deletes the served dishes. Both modes do the same
+ * kitchen work; only the intake path differs. For each mode the producer and consumer throughput are printed, along
+ * with the full-queue retries (the backpressure signal) and the average batch size.
+ *
+ * Usage: ./intakebench [--producers N] [--orders N] [--capacity N] [--batch N] [--mode queue|mutex|both]
+ *
+ * @date October 17, 2026
+ * @author Kun Feng Wei
+ */
+
+#include "OrderQueue.hpp"
+#include "Appetizer.hpp"
+#include "MainCourse.hpp"
+#include "Dessert.hpp"
+#include "MenuRenderer.hpp"
+#include "OutputSink.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct Options
+{
+    int producers = 4;
+    long long orders = 50000;  // per producer
+    size_t capacity = 1024;
+    size_t batch = 64;
+    std::string mode = "both";
+};
+
+// What one mode measured
+struct Measurement
+{
+    double produce_ns = 0;  // until the last producer submitted its last dish
+    double consume_ns = 0;  // until the kitchen took the last dish
+    unsigned long long full_retries = 0;
+    unsigned long long batches = 0;
+};
+
+using Clock = std::chrono::steady_clock;
+
+// Builds a deterministic dish, spreading prep times and cuisines like the Kitchen microbenchmarks
+static Dish* makeDish(long long index)
+{
+    int prep_time = 5 + static_cast<int>((index * 37) % 120);
+    double price = 3.0 + static_cast<double>((index * 7919) % 2000) / 100.0;
+    Dish::CuisineType cuisine = static_cast<Dish::CuisineType>(index % 7);
+    switch (index % 3)
+    {
+        case 0:
+            return new Appetizer("Spring Rolls", {"Cabbage", "Pork", "Flour", "Rice Paper"}, prep_time, price, cuisine, Appetizer::BUFFET, 3, false);
+        case 1:
+            return new MainCourse("Pot Roast", {"Beef", "Carrots", "Butter", "Onion", "Garlic"}, prep_time, price, cuisine, MainCourse::BAKED, "Beef", {{"Rice", MainCourse::GRAIN}, {"Salad", MainCourse::SALAD}}, false);
+        default:
+            return new Dessert("Carrot Cake", {"Flour", "Walnuts", "Sugar", "Cream"}, prep_time, price, cuisine, Dessert::SWEET, 5, true);
+    }
+}
+
+// One vector of dishes per producer, built before the clock starts
+static std::vector<std::vector<Dish*>> makeOrders(const Options& options)
+{
+    std::vector<std::vector<Dish*>> orders(options.producers);
+    for (int producer = 0; producer < options.producers; producer++)
+    {
+        orders[producer].reserve(options.orders);
+        for (long long i = 0; i < options.orders; i++)
+        {
+            orders[producer].push_back(makeDish(producer * options.orders + i));
+        }
+    }
+    return orders;
+}
+
+static double elapsedNs(Clock::time_point begin, Clock::time_point end)
+{
+    return std::chrono::duration<double, std::nano>(end - begin).count();
+}
+
+static Measurement runQueue(const Options& options)
+{
+    std::vector<std::vector<Dish*>> orders = makeOrders(options);
+    OrderQueue queue(options.capacity);
+    std::unique_ptr<Kitchen> kitchen(new Kitchen());
+    std::atomic<bool> go(false);
+    std::atomic<int> producers_left(options.producers);
+    std::atomic<unsigned long long> full_retries(0);
+    Clock::time_point produce_end;
+
+    std::vector<std::thread> producers;
+    for (int producer = 0; producer < options.producers; producer++)
+    {
+        producers.emplace_back([&, producer]() {
+            while (!go.load(std::memory_order_acquire))
+            {
+                std::this_thread::yield();
+            }
+            unsigned long long retries = 0;
+            for (Dish* dish : orders[producer])
+            {
+                while (!queue.tryPush(dish))
+                {
+                    retries++; // backpressure: let the kitchen thread catch up
+                    std::this_thread::yield();
+                }
+            }
+            full_retries.fetch_add(retries, std::memory_order_relaxed);
+            if (producers_left.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                produce_end = Clock::now();
+            }
+        });
+    }
+
+    const long long total = options.orders * options.producers;
+    long long consumed = 0;
+    Clock::time_point begin = Clock::now();
+    go.store(true, std::memory_order_release);
+    while (consumed < total)
+    {
+        int added = queue.drainInto(*kitchen, options.batch);
+        consumed += added;
+        if (kitchen->getCurrentSize() == Kitchen::getCapacity())
+        {
+            kitchen.reset(new Kitchen()); // serve the full kitchen
+        }
+        if (added == 0)
+        {
+            std::this_thread::yield();
+        }
+    }
+    Clock::time_point consume_end = Clock::now();
+    for (std::thread& producer : producers)
+    {
+        producer.join();
+    }
+
+    Measurement measurement;
+    measurement.produce_ns = elapsedNs(begin, produce_end);
+    measurement.consume_ns = elapsedNs(begin, consume_end);
+    measurement.full_retries = full_retries.load();
+    measurement.batches = queue.counters().batches;
+    return measurement;
+}
+
+static Measurement runMutex(const Options& options)
+{
+    std::vector<std::vector<Dish*>> orders = makeOrders(options);
+    std::mutex kitchen_mutex;
+    std::unique_ptr<Kitchen> kitchen(new Kitchen());
+    std::atomic<bool> go(false);
+
+    std::vector<std::thread> producers;
+    for (int producer = 0; producer < options.producers; producer++)
+    {
+        producers.emplace_back([&, producer]() {
+            while (!go.load(std::memory_order_acquire))
+            {
+                std::this_thread::yield();
+            }
+            for (Dish* dish : orders[producer])
+            {
+                std::lock_guard<std::mutex> lock(kitchen_mutex);
+                if (!kitchen->newOrder(dish))
+                {
+                    kitchen.reset(new Kitchen()); // serve the full kitchen
+                    kitchen->newOrder(dish);
+                }
+            }
+        });
+    }
+
+    Clock::time_point begin = Clock::now();
+    go.store(true, std::memory_order_release);
+    for (std::thread& producer : producers)
+    {
+        producer.join();
+    }
+    Clock::time_point end = Clock::now();
+
+    // Every dish is in the kitchen as soon as its producer's lock is released
+    Measurement measurement;
+    measurement.produce_ns = elapsedNs(begin, end);
+    measurement.consume_ns = measurement.produce_ns;
+    return measurement;
+}
+
+static void appendRate(MenuRenderer& out, const char* label, long long total, double ns)
+{
+    out.append("  ").append(label).append(": ").appendInt(total).append(" orders in ").appendFixed(ns / 1e6, 3);
+    out.append(" ms, ").appendFixed(ns > 0 ? total / ns * 1e9 : 0.0, 0).append(" orders/s");
+}
+
+static void appendMeasurement(MenuRenderer& out, const Options& options, const char* mode, const Measurement& measurement)
+{
+    long long total = options.orders * options.producers;
+    out.append(mode).append(": ").appendInt(options.producers).append(" producers x ").appendInt(options.orders).append(" orders");
+    if (std::strcmp(mode, "queue") == 0)
+    {
+        out.append(", capacity ").appendInt(static_cast<long long>(options.capacity)).append(", batch ").appendInt(static_cast<long long>(options.batch));
+    }
+    out.append('\n');
+    appendRate(out, "produce", total, measurement.produce_ns);
+    if (std::strcmp(mode, "queue") == 0)
+    {
+        out.append(", ").appendInt(static_cast<long long>(measurement.full_retries)).append(" full retries");
+    }
+    out.append('\n');
+    appendRate(out, "consume", total, measurement.consume_ns);
+    if (measurement.batches > 0)
+    {
+        out.append(", ").appendInt(static_cast<long long>(measurement.batches)).append(" batches (");
+        out.appendFixed(static_cast<double>(total) / measurement.batches, 1).append(" per batch)");
+    }
+    out.append('\n');
+}
+
+static bool parseOptions(int argc, char* argv[], Options& options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        bool has_value = i + 1 < argc;
+        if (std::strcmp(argv[i], "--producers") == 0 && has_value)
+        {
+            options.producers = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--orders") == 0 && has_value)
+        {
+            options.orders = std::atoll(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--capacity") == 0 && has_value)
+        {
+            options.capacity = static_cast<size_t>(std::atoll(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--batch") == 0 && has_value)
+        {
+            options.batch = static_cast<size_t>(std::atoll(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--mode") == 0 && has_value)
+        {
+            options.mode = argv[++i];
+        }
+        else
+        {
+            options.producers = 0; // reported below
+            break;
+        }
+    }
+    if (options.producers < 1 || options.orders < 1 || options.batch < 1 ||
+        (options.mode != "queue" && options.mode != "mutex" && options.mode != "both"))
+    {
+        std::cerr << "Usage: " << argv[0] << " [--producers N] [--orders N] [--capacity N] [--batch N] [--mode queue|mutex|both]" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (!parseOptions(argc, argv, options))
+    {
+        return 1;
+    }
+
+    MenuRenderer out;
+    if (options.mode != "mutex")
+    {
+        appendMeasurement(out, options, "queue", runQueue(options));
+    }
+    if (options.mode != "queue")
+    {
+        appendMeasurement(out, options, "mutex", runMutex(options));
+    }
+    StreamSink console(std::cout);
+    out.emit(console);
+    return 0;
+}
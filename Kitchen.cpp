@@ -16,17 +16,339 @@
 #include <vector>
 #include <string>
 #include <iostream>
+#include <stdexcept>
+#include <algorithm>
 #include "Appetizer.hpp"
 #include "MainCourse.hpp"
 #include "Dessert.hpp"
 #include "ArrayBag.hpp"
 #include "Dish.hpp"
+#include "StationScheduler.hpp"
+#include "OrderLog.hpp"
+#include "Tracer.hpp"
+
+/**
+ * Reads the next comma separated field of a CSV line.
+ * @param input The stream positioned at the start of the field.
+ * @param field The string that receives the field.
+ * @return True if the field was quoted, i.e. its nested lists may hold backslash escapes.
+ * @post A field wrapped in double quotes (as written by exportCsv()) is unquoted
+ * and its doubled quotes are collapsed; any other field is read up to the next comma.
+ */
+static bool readCsvField(std::istream& input, std::string& field)
+{
+    if (input.peek() != '"')
+    {
+        std::getline(input, field, ',');
+        return false;
+    }
+    field.clear();
+    input.get();
+    char c;
+    while (input.get(c))
+    {
+        if (c == '"')
+        {
+            if (input.peek() != '"')
+            {
+                break;
+            }
+            input.get();
+        }
+        field.push_back(c);
+    }
+    if (input.peek() == ',')
+    {
+        input.get();
+    }
+    return true;
+}
+
+// True if the item ends in an odd run of backslashes, i.e. std::getline() stopped at an escaped separator
+static bool endsInEscape(const std::string& item)
+{
+    size_t backslashes = 0;
+    while (backslashes < item.size() && item[item.size() - 1 - backslashes] == '\\')
+    {
+        backslashes++;
+    }
+    return backslashes % 2 != 0;
+}
+
+/**
+ * Reads the next item of a list nested in a CSV field, like std::getline().
+ * @param input The stream positioned at the start of the item.
+ * @param item The string that receives the item.
+ * @param separator The separator of the list: ';', '|' or ':'.
+ * @param escaped True if the list comes from a quoted field; exportCsv() quotes every field it escaped.
+ * @param unescape False to keep the backslash escapes, for an item that holds a nested list of its own.
+ * @return False if the input was already exhausted.
+ * @post In an escaped list, a separator escaped with a backslash (as written by MenuRenderer::appendCsvItem())
+ * is part of the item. A list from an unquoted field is split like std::getline(), backslashes included.
+ */
+static bool readCsvItem(std::istream& input, std::string& item, char separator, bool escaped, bool unescape = true)
+{
+    if (!std::getline(input, item, separator))
+    {
+        return false;
+    }
+    if (!escaped)
+    {
+        return true;
+    }
+    std::string rest;
+    while (endsInEscape(item) && !input.eof())
+    {
+        item.push_back(separator);
+        if (std::getline(input, rest, separator))
+        {
+            item += rest;
+        }
+    }
+    if (unescape && item.find('\\') != std::string::npos)
+    {
+        size_t out = 0;
+        for (size_t i = 0; i < item.size(); i++)
+        {
+            if (item[i] == '\\' && i + 1 < item.size())
+            {
+                i++;
+            }
+            item[out++] = item[i];
+        }
+        item.resize(out);
+    }
+    return true;
+}
+
+// The number of CSV rows covered by one "load.chunk" trace span
+static const int LOAD_CHUNK_ROWS = 64;
+
+// Reads one row of the CSV file, counted as the loader's read stage. A quoted field may hold a line break
+// (exportCsv() writes one as is), so while the row has an odd number of quotes the next line belongs to it.
+static bool readLine(std::istream& input, std::string& line)
+{
+    KitchenStats::Scope stats_scope(KitchenStats::LOAD_READ);
+    if (!std::getline(input, line))
+    {
+        return false;
+    }
+    if (line.find('"') != std::string::npos)
+    {
+        std::string continuation;
+        while (std::count(line.begin(), line.end(), '"') % 2 != 0 && std::getline(input, continuation))
+        {
+            line.push_back('\n');
+            line += continuation;
+        }
+    }
+    stats_scope.addItems(1);
+    return true;
+}
+
+// The fields of one row of Dishes.csv, before a dish is built from them
+struct DishRow
+{
+    std::string dish_type;
+    std::string name;
+    std::string ingredients;
+    int prep_time;
+    Cents price_cents;
+    std::string cuisine_type;
+    std::string additional_attributes;
+    bool ingredients_quoted;
+    bool attributes_quoted;
+};
+
+/**
+ * Splits one CSV row into its fields.
+ * @param line A row in the Dishes.csv schema, without the line break.
+ * @param row The fields that receive the row.
+ * @throws std::invalid_argument or std::out_of_range if the prep time or price is not a number.
+ */
+static void readDishRow(const std::string& line, DishRow& row)
+{
+    std::stringstream input_string(line);
+    std::string temp_string;
+    readCsvField(input_string, row.dish_type);
+    readCsvField(input_string, row.name);
+    row.ingredients_quoted = readCsvField(input_string, row.ingredients);
+
+    readCsvField(input_string, temp_string);
+    row.prep_time = std::stoi(temp_string);
+
+    readCsvField(input_string, temp_string);
+    if (!parseCents(temp_string, row.price_cents))
+    {
+        throw std::invalid_argument("Invalid price: " + temp_string);
+    }
+
+    readCsvField(input_string, row.cuisine_type);
+    row.attributes_quoted = readCsvField(input_string, row.additional_attributes);
+}
+
+/**
+ * Splits the ingredients field of a row into its ingredients.
+ * @param row The fields of the row.
+ * @param ingredients The vector that receives the ingredients.
+ * @post A quoted field holds one ingredient more than it has separators, so a quoted "" is one empty
+ * ingredient and a trailing separator ends in an empty one; an unquoted "" holds no ingredients.
+ */
+static void readIngredients(const DishRow& row, std::vector<std::string>& ingredients)
+{
+    std::stringstream ingredient_ss(row.ingredients);
+    std::string ingredient;
+    while (readCsvItem(ingredient_ss, ingredient, ';', row.ingredients_quoted))
+    {
+        ingredients.push_back(ingredient);
+    }
+    if (row.ingredients_quoted && (row.ingredients.empty()
+        || (row.ingredients.back() == ';' && !endsInEscape(row.ingredients.substr(0, row.ingredients.size() - 1)))))
+    {
+        ingredients.push_back("");
+    }
+}
+
+/**
+ * Builds the dish a row describes.
+ * @param row The fields of the row.
+ * @return A new dish owned by the caller, or nullptr if the dish type is unknown.
+ * @throws std::invalid_argument or std::out_of_range if a numeric attribute is not a number.
+ */
+static Dish* buildDish(const DishRow& row)
+{
+    Dish* dish = nullptr; //Create a pointer to a dish object
+
+//Using if statements to create the dish object based on the dish type
+    if (row.dish_type == "APPETIZER")
+    {
+//Parsing the additional attributes
+        std::stringstream ss(row.additional_attributes);
+        std::string _serving_style_;
+        int _spiciness_level_;
+        bool _vegetarian_;
+        std::string temp_string;
+        readCsvItem(ss, _serving_style_, ';', row.attributes_quoted);
+
+        readCsvItem(ss, temp_string, ';', row.attributes_quoted);
+        _spiciness_level_ = std::stoi(temp_string);
+                                
+        readCsvItem(ss, temp_string, ';', row.attributes_quoted);
+        _vegetarian_ = (temp_string == "true");
+
+//Parsing the ingredients vector            
+        std::vector<std::string>ingredient_strings;
+        readIngredients(row, ingredient_strings);
+
+//Parsing the cuisine type enums
+        Dish::CuisineType cuisine_type_enum = enumFromToken(Dish::CUISINE_TYPE_INFO, row.cuisine_type, Dish::CuisineType::OTHER);
+
+//Parsing the serving style enums from the additional attributes
+        Appetizer::ServingStyle serving_style_enum = enumFromToken(Appetizer::SERVING_STYLE_INFO, _serving_style_, Appetizer::ServingStyle::PLATED);
+
+        dish = new Appetizer(row.name, ingredient_strings, row.prep_time, 0.0, cuisine_type_enum, serving_style_enum, _spiciness_level_, _vegetarian_);
+    }
+
+
+//Using if statements to create the dish object based on the dish type
+    else if (row.dish_type == "MAINCOURSE")
+    {
+//Parsing the additional attributes
+        std::stringstream ss(row.additional_attributes);
+        std::string _cooking_method_, _protein_type_, _side_dishes_;
+        bool _gluten_free_;
+        std::string temp_string;
+        readCsvItem(ss, _cooking_method_, ';', row.attributes_quoted);
+        readCsvItem(ss, _protein_type_, ';', row.attributes_quoted);
+        readCsvItem(ss, _side_dishes_, ';', row.attributes_quoted, false); // unescaped item by item below
+
+        readCsvItem(ss, temp_string, ';', row.attributes_quoted);
+        _gluten_free_ = (temp_string == "true");
+
+//Parsing the ingredients vector
+        std::vector<std::string>ingredient_strings;
+        readIngredients(row, ingredient_strings);
+
+//Parsing the side dishes vector from the additional attributes
+        std::vector<MainCourse::SideDish>side_dishes_strings;
+        std::stringstream side_dish_ss(_side_dishes_);
+        std::string side_dishes;
+        while (readCsvItem(side_dish_ss, side_dishes, '|', row.attributes_quoted, false))
+        {
+//Parsing the category enums from the side dishes
+            MainCourse::SideDish side_dishes_enum;
+            std::stringstream side_dishes_info(side_dishes);
+
+            std::string side_dishes_name, side_dishes_category;
+            readCsvItem(side_dishes_info, side_dishes_name, ':', row.attributes_quoted);
+            readCsvItem(side_dishes_info, side_dishes_category, ':', row.attributes_quoted);
+
+            side_dishes_enum.name = side_dishes_name;
+            side_dishes_enum.category = enumFromToken(MainCourse::CATEGORY_INFO, side_dishes_category, MainCourse::Category::GRAIN);
+            side_dishes_strings.push_back(side_dishes_enum);
+        }
+
+//Parsing the cuisine type enums
+        Dish::CuisineType cuisine_type_enum = enumFromToken(Dish::CUISINE_TYPE_INFO, row.cuisine_type, Dish::CuisineType::OTHER);
+
+//Parsing the cooking method enums from the additional attributes
+        MainCourse::CookingMethod cooking_method_enum = enumFromToken(MainCourse::COOKING_METHOD_INFO, _cooking_method_, MainCourse::CookingMethod::GRILLED);
+
+        dish = new MainCourse(row.name, ingredient_strings, row.prep_time, 0.0, cuisine_type_enum, cooking_method_enum, _protein_type_, side_dishes_strings, _gluten_free_);
+    }
+
+
+//Using if statements to create the dish object based on the dish type
+    else if (row.dish_type == "DESSERT")
+    {
+//Parsing the additional attributes
+        std::stringstream ss(row.additional_attributes);
+        std::string _flavor_profile_;
+        int _sweetness_level_;
+        bool _contains_nuts_; 
+        std::string temp_string;
+        readCsvItem(ss, _flavor_profile_, ';', row.attributes_quoted);
+
+        readCsvItem(ss, temp_string, ';', row.attributes_quoted);
+        _sweetness_level_ = std::stoi(temp_string);    
+        
+        readCsvItem(ss, temp_string, ';', row.attributes_quoted);
+        _contains_nuts_ = (temp_string == "true");
+
+//Parsing the ingredients vector
+        std::vector<std::string>ingredient_strings;
+        readIngredients(row, ingredient_strings);
+
+//Parsing the cuisine type enums
+        Dish::CuisineType cuisine_type_enum = enumFromToken(Dish::CUISINE_TYPE_INFO, row.cuisine_type, Dish::CuisineType::OTHER);
+
+//Parsing the flavor profile enums from the additional attributes
+        Dessert::FlavorProfile flavor_profile_enum = enumFromToken(Dessert::FLAVOR_PROFILE_INFO, _flavor_profile_, Dessert::FlavorProfile::SWEET);
+        dish = new Dessert(row.name, ingredient_strings, row.prep_time, 0.0, cuisine_type_enum, flavor_profile_enum, _sweetness_level_, _contains_nuts_);
+    }
+
+//Setting the parsed price directly, so it does not round-trip through a double
+    if (dish != nullptr)
+    {
+        dish->setPriceCents(row.price_cents);
+    }
+    return dish;
+}
+
+// Counts a row that readDishRow() or buildDish() threw on, keeping the first reason
+static void noteMalformedRow(Kitchen::LoadResult& result, const std::exception& error)
+{
+    if (result.malformed++ == 0)
+    {
+        result.first_error = "row " + std::to_string(result.rows) + ": " + error.what();
+    }
+}
 
 /**
  * Default constructor.
  * Default-initializes all private members.
  */
-Kitchen::Kitchen() : ArrayBag<Dish*>(), total_prep_time_(0), count_elaborate_(0) {
+Kitchen::Kitchen() : ArrayBag<Dish*>(), total_prep_time_(0), count_elaborate_(0), headers_(), headers_stale_(false), cursors_(), schedulers_(), logs_(), menu_renderer_() {
 
 }
 
@@ -40,21 +362,88 @@ kitchen, false otherwise. Hint: Use the above definition of equality to help det
 */
 bool Kitchen::newOrder(Dish *new_dish)
 {
+    KitchenStats::Scope stats_scope(KitchenStats::NEW_ORDER);
+    Tracer::Span trace_span("kitchen.newOrder", "aggregate");
     if (add(new_dish))
     {
+        stats_scope.addItems(1);
+        headers_[item_count_ - 1] = DishHeader::of(*new_dish);
+        new_dish->owner_.kitchen = this;
         total_prep_time_ += (*new_dish).getPrepTime();
         //std::cout<< "Dish added: "<<new_dish.getName() << std::endl;
         //if the new dish has 5 or more ingredients AND takes an hour or more to prepare, increment count_elaborate_
-        if ((*new_dish).getIngredients().size() >= 5 && (*new_dish).getPrepTime() >= 60)
+        if ((*new_dish).getIngredientCount() >= 5 && (*new_dish).getPrepTime() >= 60)
         {
             //std::cout << "Elaborate dish added: "<<new_dish.getName() << std::endl;
             count_elaborate_++;
         }
+        for (StationScheduler* scheduler : schedulers_)
+        {
+            scheduler->dishAdded(new_dish);
+        }
+        for (OrderLog* log : logs_)
+        {
+            log->dishAdded(new_dish);
+        }
         return true;
     }
+    // add() refuses a dish already in the kitchen first, and any other dish once the kitchen is full
+    if (contains(new_dish))
+    {
+        stats_scope.reject();
+    }
+    else
+    {
+        stats_scope.dropCapacityFull();
+    }
     return false;
 }
 
+/**
+ * @param dishes The dishes to add, in order.
+ * @param count The number of dishes.
+ * @post Adds dishes[0], dishes[1], ... exactly as newOrder() would, stopping at
+ * the first dish the kitchen refuses (full, or already in the kitchen).
+ * @return The number of dishes added; the kitchen owns dishes[0..n) and the
+ * caller still owns the rest.
+ */
+int Kitchen::newOrders(Dish* const* dishes, int count)
+{
+    KitchenStats::Scope stats_scope(KitchenStats::NEW_ORDERS);
+    Tracer::Span trace_span("kitchen.newOrders", "aggregate");
+    int added = 0;
+    while (added < count && add(dishes[added]))
+    {
+        const Dish& new_dish = *dishes[added];
+        headers_[item_count_ - 1] = DishHeader::of(new_dish);
+        dishes[added]->owner_.kitchen = this;
+        total_prep_time_ += new_dish.getPrepTime();
+        if (new_dish.getIngredientCount() >= 5 && new_dish.getPrepTime() >= 60)
+        {
+            count_elaborate_++;
+        }
+        for (StationScheduler* scheduler : schedulers_)
+        {
+            scheduler->dishAdded(&new_dish);
+        }
+        for (OrderLog* log : logs_)
+        {
+            log->dishAdded(&new_dish);
+        }
+        added++;
+    }
+    stats_scope.addItems(added);
+    if (added < count && contains(dishes[added]))
+    {
+        stats_scope.reject();
+    }
+    else if (added < count)
+    {
+        stats_scope.dropCapacityFull();
+    }
+    return added;
+}
+
 /**
   * @param : A reference to a `Dish` leaving the kitchen.
   * @return : Returns true if a dish was successfully removed from the kitchen (i.e., items_), false otherwise.
@@ -62,19 +451,48 @@ bool Kitchen::newOrder(Dish *new_dish)
 */
 bool Kitchen::serveDish(Dish *dish_to_remove)
 {
+    KitchenStats::Scope stats_scope(KitchenStats::SERVE_DISH);
+    Tracer::Span trace_span("kitchen.serveDish", "aggregate");
     if (getCurrentSize() == 0)
     {
+        stats_scope.reject();
         return false;
     }
-    if (remove(dish_to_remove))
+    int found_index = getIndexOf(dish_to_remove);
+    if (found_index > -1)
     {
+        stats_scope.addItems(1);
+        int last_index = getCurrentSize() - 1;
+        for (MenuCursor* cursor : cursors_)
+        {
+            cursor->dishRemoved(found_index, last_index);
+        }
+        for (StationScheduler* scheduler : schedulers_)
+        {
+            scheduler->dishRemoved(dish_to_remove);
+        }
+
+        // Same swap-with-last removal as ArrayBag::remove(), applied to the headers as well
+        items_[found_index] = items_[last_index];
+        headers_[found_index] = headers_[last_index];
+        item_count_--;
+        if (dish_to_remove->owner_.kitchen == this)
+        {
+            dish_to_remove->owner_.kitchen = nullptr;
+        }
+
         total_prep_time_ -= (*dish_to_remove).getPrepTime();
-        if ((*dish_to_remove).getIngredients().size() >= 5 && (*dish_to_remove).getPrepTime() >= 60)
+        if ((*dish_to_remove).getIngredientCount() >= 5 && (*dish_to_remove).getPrepTime() >= 60)
         {
             count_elaborate_--;
         }
+        for (OrderLog* log : logs_)
+        {
+            log->dishRemoved(found_index);
+        }
         return true;
     }
+    stats_scope.reject();
     return false;
 }
 
@@ -84,6 +502,7 @@ currently in the kitchen.
 */
 int Kitchen::getPrepTimeSum() const
 {
+    syncDishHeaders();
     if (getCurrentSize() == 0)
     {
         return 0;
@@ -99,14 +518,18 @@ rounded to the NEAREST integer.
 */
 int Kitchen::calculateAvgPrepTime() const
 {
+    KitchenStats::Scope stats_scope(KitchenStats::CALCULATE_AVG_PREP_TIME);
+    Tracer::Span trace_span("kitchen.calculateAvgPrepTime", "aggregate");
+    stats_scope.addItems(getCurrentSize());
     if (getCurrentSize() == 0)
     {
         return 0;
     }
+    syncDishHeaders();
     double total_prep_time_ = 0;
     for (int i = 0; i < getCurrentSize(); i++)
     {
-        total_prep_time_ += (*items_[i]).getPrepTime();
+        total_prep_time_ += headers_[i].prep_time;
     }
     total_prep_time_ = total_prep_time_ / getCurrentSize();
     // std::cout<< "Total prep time: "<<total_prep_time_ << std::endl;
@@ -114,11 +537,65 @@ int Kitchen::calculateAvgPrepTime() const
     return round(total_prep_time_);
 }
 
+/**
+  * @return : The exact sum, in cents, of the prices of all the dishes
+currently in the kitchen.
+*/
+Cents Kitchen::getPriceCentsSum() const
+{
+    syncDishHeaders();
+    // Integer addition is associative, so the compiler may split this loop into vector lanes without changing the result
+    Cents total = 0;
+    for (int i = 0; i < getCurrentSize(); i++)
+    {
+        total += headers_[i].price_cents;
+    }
+    return total;
+}
+
+/**
+  * @param : A reference to a string representing a cuisine type, matched
+exactly as in tallyCuisineTypes().
+  * @return : The exact sum, in cents, of the prices of the dishes of the
+given cuisine type, or zero if the string is not a cuisine type.
+*/
+Cents Kitchen::getPriceCentsSum(const std::string& cuisine_type) const
+{
+    Dish::CuisineType cuisine_type_enum;
+    if (!tryEnumFromToken(Dish::CUISINE_TYPE_INFO, cuisine_type, cuisine_type_enum))
+    {
+        return 0;
+    }
+    syncDishHeaders();
+    Cents total = 0;
+    for (int i = 0; i < getCurrentSize(); i++)
+    {
+        // Select instead of branching so the loop has no data-dependent jumps
+        total += headers_[i].cuisine_type == cuisine_type_enum ? headers_[i].price_cents : 0;
+    }
+    return total;
+}
+
+/**
+  * @return : The average price, in cents, of all the dishes in the kitchen
+rounded to the NEAREST cent (halves away from zero), or 0 if the kitchen is
+empty.
+*/
+Cents Kitchen::calculateAvgPriceCents() const
+{
+    if (getCurrentSize() == 0)
+    {
+        return 0;
+    }
+    return averageCents(getPriceCentsSum(), getCurrentSize());
+}
+
 /**
   * @return : The integer count of the elaborate dishes in the kitchen.
 */
 int Kitchen::elaborateDishCount() const
 {
+    syncDishHeaders();
     if (getCurrentSize() == 0 || count_elaborate_ == 0)
     {
         return 0;
@@ -149,6 +626,7 @@ double Kitchen::calculateElaboratePercentage() const
     // std::cout << percentage << std::endl;
 
     // return percentage;
+    syncDishHeaders();
     if (getCurrentSize() == 0 || count_elaborate_ == 0)
     {
         return 0;
@@ -171,10 +649,20 @@ cuisine types, the tally is zero.
 uppercase input will match.
 */
 int Kitchen::tallyCuisineTypes(const std::string& cuisine_type) const{
+    KitchenStats::Scope stats_scope(KitchenStats::TALLY_CUISINE_TYPES);
+    Tracer::Span trace_span("kitchen.tallyCuisineTypes", "aggregate");
+    stats_scope.addItems(getCurrentSize());
+    Dish::CuisineType cuisine_type_enum;
+    if (!tryEnumFromToken(Dish::CUISINE_TYPE_INFO, cuisine_type, cuisine_type_enum))
+    {
+        stats_scope.reject();
+        return 0;
+    }
+    syncDishHeaders();
     int count = 0;
     for (int i = 0; i < getCurrentSize(); i++)
     {
-        if ((*items_[i]).getCuisineType() == cuisine_type)
+        if (headers_[i].cuisine_type == cuisine_type_enum)
         {
             count++;
         }
@@ -191,15 +679,45 @@ less than the given time.
 */
 int Kitchen::releaseDishesBelowPrepTime(const int& prep_time)
 {
+    return releaseBelowPrepTime(prep_time, nullptr);
+}
+
+/**
+ * Same as releaseDishesBelowPrepTime(prep_time), and hands the removed
+ * dishes to the caller.
+ * @param prep_time The preparation time threshold.
+ * @param released Receives the removed dishes; the caller deletes them.
+ * @return The number of dishes removed from the kitchen.
+ */
+int Kitchen::releaseDishesBelowPrepTime(const int& prep_time, std::vector<Dish*>& released)
+{
+    return releaseBelowPrepTime(prep_time, &released);
+}
+
+int Kitchen::releaseBelowPrepTime(int prep_time, std::vector<Dish*>* released)
+{
+    KitchenStats::Scope stats_scope(KitchenStats::RELEASE_BELOW_PREP_TIME);
+    Tracer::Span trace_span("kitchen.releaseDishesBelowPrepTime", "aggregate");
     int count = 0;
-    int num= getCurrentSize();
-    for (int i = 0; i < num; i++)
+    stats_scope.addItems(getCurrentSize());
+    syncDishHeaders();
+    // serveDish() moves the last dish into the freed slot, so that slot is checked again before moving on
+    int i = 0;
+    while (i < getCurrentSize())
     {
-        if ((*items_[i]).getPrepTime() < prep_time)
+        if (headers_[i].prep_time < prep_time)
         {
             count++;
+            if (released != nullptr)
+            {
+                released->push_back(items_[i]);
+            }
             serveDish(items_[i]);
         }
+        else
+        {
+            i++;
+        }
     }
     return count;
 }
@@ -219,14 +737,51 @@ types, do not remove any dishes.
 */
 int Kitchen::releaseDishesOfCuisineType(const std::string& cuisine_type)
 {
+    return releaseOfCuisineType(cuisine_type, nullptr);
+}
+
+/**
+ * Same as releaseDishesOfCuisineType(cuisine_type), and hands the removed
+ * dishes to the caller.
+ * @param cuisine_type The cuisine type token.
+ * @param released Receives the removed dishes; the caller deletes them.
+ * @return The number of dishes removed from the kitchen.
+ */
+int Kitchen::releaseDishesOfCuisineType(const std::string& cuisine_type, std::vector<Dish*>& released)
+{
+    return releaseOfCuisineType(cuisine_type, &released);
+}
+
+int Kitchen::releaseOfCuisineType(const std::string& cuisine_type, std::vector<Dish*>* released)
+{
+    KitchenStats::Scope stats_scope(KitchenStats::RELEASE_CUISINE_TYPE);
+    Tracer::Span trace_span("kitchen.releaseDishesOfCuisineType", "aggregate");
+    Dish::CuisineType cuisine_type_enum;
+    if (!tryEnumFromToken(Dish::CUISINE_TYPE_INFO, cuisine_type, cuisine_type_enum))
+    {
+        stats_scope.reject();
+        return 0;
+    }
+    stats_scope.addItems(getCurrentSize());
+    syncDishHeaders();
     int count = 0;
-    for (int i = 0; i < getCurrentSize(); i++)
+    // serveDish() moves the last dish into the freed slot, so that slot is checked again before moving on
+    int i = 0;
+    while (i < getCurrentSize())
     {
-        if ((*items_[i]).getCuisineType() == cuisine_type)
+        if (headers_[i].cuisine_type == cuisine_type_enum)
         {
             count++;
+            if (released != nullptr)
+            {
+                released->push_back(items_[i]);
+            }
             serveDish(items_[i]);
         }
+        else
+        {
+            i++;
+        }
     }
     return count;
 }
@@ -250,374 +805,154 @@ ELABORATE DISHES: 53.85%
 */
 void Kitchen::kitchenReport() const
 {
-    std::cout << "ITALIAN: " << tallyCuisineTypes("ITALIAN") << std::endl;
-    std::cout << "MEXICAN: " << tallyCuisineTypes("MEXICAN") << std::endl;
-    std::cout << "CHINESE: " << tallyCuisineTypes("CHINESE") << std::endl;
-    std::cout << "INDIAN: " << tallyCuisineTypes("INDIAN") << std::endl;
-    std::cout << "AMERICAN: " << tallyCuisineTypes("AMERICAN") << std::endl;
-    std::cout << "FRENCH: " << tallyCuisineTypes("FRENCH") << std::endl;
-    std::cout << "OTHER: " << tallyCuisineTypes("OTHER") << std::endl<<std::endl;
-    std::cout << "AVERAGE PREP TIME: " << calculateAvgPrepTime() << std::endl;
-    std::cout << "ELABORATE DISHES: " << calculateElaboratePercentage() << "%" << std::endl;
+    StreamSink console(std::cout);
+    kitchenReport(console);
+}
+
+/**
+ * Writes the kitchen report to the given sink.
+ * @param out The sink that receives the report.
+ * @post Outputs the same text as kitchenReport() to `out` in a single write.
+ * The percentage is always printed with 2 decimal places and no stream
+ * formatting state is changed.
+ */
+void Kitchen::kitchenReport(OutputSink& out) const
+{
+    KitchenStats::Scope stats_scope(KitchenStats::KITCHEN_REPORT);
+    Tracer::Span trace_span("kitchen.kitchenReport", "render");
+    stats_scope.addItems(getCurrentSize());
+    // Tally every cuisine type in a single pass instead of one scan per type
+    const int cuisine_count = sizeof(Dish::CUISINE_TYPE_INFO) / sizeof(Dish::CUISINE_TYPE_INFO[0]);
+    int tally[cuisine_count] = {};
+    syncDishHeaders();
+    for (int i = 0; i < getCurrentSize(); i++)
+    {
+        tally[enumInfo(Dish::CUISINE_TYPE_INFO, static_cast<Dish::CuisineType>(headers_[i].cuisine_type), Dish::CuisineType::OTHER).value]++;
+    }
+
+    menu_renderer_.clear();
+    for (int i = 0; i < cuisine_count; i++)
+    {
+        menu_renderer_.append(Dish::CUISINE_TYPE_INFO[i].token).append(": ").appendInt(tally[i]).append('\n');
+    }
+    menu_renderer_.append('\n');
+    menu_renderer_.append("AVERAGE PREP TIME: ").appendInt(calculateAvgPrepTime()).append('\n');
+    menu_renderer_.append("ELABORATE DISHES: ").appendFixed(calculateElaboratePercentage(), 2).append("%\n");
+    menu_renderer_.emit(out);
 }
 
 /**
  * Parameterized constructor.
  * @param filename The name of the input CSV file containing dish
 information.
- * @pre The CSV file must be properly formatted.
  * @post Initializes the kitchen by reading dishes from the CSV file and
-storing them as `Dish*`.
+storing them as `Dish*`. Malformed rows are skipped and reported on
+std::cerr.
+ */
+Kitchen::Kitchen(const std::string& filename) : Kitchen()
+{
+    LoadResult result;
+    load(filename, result);
+    if (result.malformed > 0)
+    {
+        std::cerr << filename << ": skipped " << result.malformed << " malformed rows, first at " << result.first_error << std::endl;
+    }
+}
+
+/**
+ * Parameterized constructor that reports what happened to each row.
+ * @param filename The name of the input CSV file containing dish
+information.
+ * @param result Receives the row counts.
+ * @post Initializes the kitchen from the rows that parse, up to its
+capacity; malformed rows and rows of an unknown dish type are skipped.
+ */
+Kitchen::Kitchen(const std::string& filename, LoadResult& result) : Kitchen()
+{
+    load(filename, result);
+}
+
+/**
+ * Adds the dishes of a CSV file, counting what happens to each row.
+ * @param filename The name of the input CSV file.
+ * @param result Receives the row counts.
+ * @post A row that fails to parse is counted and skipped, so a bad row
+never unwinds past dishes the kitchen already owns.
  */
-Kitchen::Kitchen(const std::string& filename) : ArrayBag<Dish*>(), total_prep_time_(0), count_elaborate_(0)
+void Kitchen::load(const std::string& filename, LoadResult& result)
 {
-    std::ifstream input_file(filename); //Open the file
+    result = LoadResult();
+    std::ifstream input_file;
+    {
+        Tracer::Span open_span("load.open", "io");
+        input_file.open(filename); //Open the file
+    }
     if (!input_file.is_open()) //Test to see if the file is open
     {
         std::cerr << "Failed to open file: " << filename << std::endl;
         return;
     }
+    result.opened = true;
 
     std::string line; //Variable to hold each line read from the file
     std::getline(input_file, line); //Skip header
-    while (std::getline(input_file, line)) //Read each line from the file
+    Tracer::Span chunk_span("load.chunk", "parse"); // one span per LOAD_CHUNK_ROWS rows
+    int chunk_rows = 0;
+    DishRow row; // reused, so the field strings keep their buffers from row to row
+    while (readLine(input_file, line)) //Read each line from the file
     {
-        std::stringstream input_string(line);
-        std::string temp_string;
-        std::string _dishtype_, _name_, _ingredients_, _cuisine_type_, _additional_attributes_;
-        int _prep_time_;
-        double _price_;
+        if (chunk_rows++ == LOAD_CHUNK_ROWS)
+        {
+            chunk_span.restart();
+            chunk_rows = 1;
+        }
+        result.rows++;
 
 //Parsing the line by limiters
-        std::getline(input_string, _dishtype_, ',');
-        std::getline(input_string, _name_, ',');
-        std::getline(input_string, _ingredients_, ',');
-
-        std::getline(input_string, temp_string, ',');
-        _prep_time_ = std::stoi(temp_string); 
-        
-        std::getline(input_string, temp_string, ',');
-        _price_ = std::stod(temp_string);
-
-        std::getline(input_string, _cuisine_type_, ',');
-        std::getline(input_string, _additional_attributes_, ',');
-
-        Dish* dish = nullptr; //Create a pointer to a dish object
-
-//Using if statements to create the dish object based on the dish type
-        if (_dishtype_ == "APPETIZER")
         {
-//Parsing the additional attributes
-            std::stringstream ss(_additional_attributes_);
-            std::string _serving_style_;
-            int _spiciness_level_;
-            bool _vegetarian_;
-            std::string temp_string;
-            std::getline(ss, _serving_style_, ';');
-
-            std::getline(ss, temp_string, ';');
-            _spiciness_level_ = std::stoi(temp_string);
-                                    
-            std::getline(ss, temp_string, ';');
-            _vegetarian_ = (temp_string == "true");
-
-//Parsing the ingredients vector            
-            std::vector<std::string>ingredient_strings;
-            std::stringstream ingredient_ss(_ingredients_);
-            std::string ingredients;
-            while (std::getline(ingredient_ss, ingredients, ';'))
-            {
-                ingredient_strings.push_back(ingredients);
-            }
-
-//Parsing the cuisine type enums
-            Dish::CuisineType cuisine_type_enum;
-            if (_cuisine_type_ == "ITALIAN")
-            {
-                cuisine_type_enum = Dish::CuisineType::ITALIAN;
-            }
-            else if (_cuisine_type_ == "MEXICAN")
-            {
-                cuisine_type_enum = Dish::CuisineType::MEXICAN;
-            }
-            else if (_cuisine_type_ == "CHINESE")
-            {
-                cuisine_type_enum = Dish::CuisineType::CHINESE;
-            }
-            else if (_cuisine_type_ == "INDIAN")
-            {
-                cuisine_type_enum = Dish::CuisineType::INDIAN;
-            }
-            else if (_cuisine_type_ == "AMERICAN")
+            KitchenStats::Scope parse_scope(KitchenStats::LOAD_PARSE);
+            parse_scope.addItems(1);
+            try
             {
-                cuisine_type_enum = Dish::CuisineType::AMERICAN;
+                readDishRow(line, row);
             }
-            else if (_cuisine_type_ == "FRENCH")
+            catch (const std::exception& error)
             {
-                cuisine_type_enum = Dish::CuisineType::FRENCH;
+                parse_scope.reject();
+                noteMalformedRow(result, error);
+                continue;
             }
-            else
-            {
-                cuisine_type_enum = Dish::CuisineType::OTHER;
-            }
-
-//Parsing the serving style enums from the additional attributes
-            Appetizer::ServingStyle serving_style_enum;
-            if (_serving_style_ == "PLATED")
-            {
-                serving_style_enum = Appetizer::ServingStyle::PLATED;
-            }
-            else if (_serving_style_ == "FAMILY_STYLE")
-            {
-                serving_style_enum = Appetizer::ServingStyle::FAMILY_STYLE;
-            }
-            else if (_serving_style_ == "BUFFET")
-            {
-                serving_style_enum = Appetizer::ServingStyle::BUFFET;
-            }
-            else
-            {
-                serving_style_enum = Appetizer::ServingStyle::PLATED;
-            }
-
-            dish = new Appetizer(_name_, ingredient_strings, _prep_time_, _price_, cuisine_type_enum, serving_style_enum, _spiciness_level_, _vegetarian_);
         }
 
-
-//Using if statements to create the dish object based on the dish type
-        else if (_dishtype_ == "MAINCOURSE")
+        KitchenStats::Scope build_scope(KitchenStats::LOAD_BUILD);
+        Tracer::Span build_span("dish.build", "build");
+        Dish* dish = nullptr;
+        try
         {
-//Parsing the additional attributes
-            std::stringstream ss(_additional_attributes_);
-            std::string _cooking_method_, _protein_type_, _side_dishes_;
-            bool _gluten_free_;
-            std::string temp_string;
-            std::getline(ss, _cooking_method_, ';');
-            std::getline(ss, _protein_type_, ';');
-            std::getline(ss, _side_dishes_, ';');
-
-            std::getline(ss, temp_string, ';');
-            _gluten_free_ = (temp_string == "true");
-
-//Parsing the ingredients vector
-            std::vector<std::string>ingredient_strings;
-            std::stringstream ingredient_ss(_ingredients_);
-            std::string ingredients;
-            while (std::getline(ingredient_ss, ingredients, ';'))
-            {
-                ingredient_strings.push_back(ingredients);
-            }
-
-//Parsing the side dishes vector from the additional attributes
-            std::vector<MainCourse::SideDish>side_dishes_strings;
-            std::stringstream side_dish_ss(_side_dishes_);
-            std::string side_dishes;
-            while (std::getline(side_dish_ss, side_dishes, '|'))
-            {
-//Parsing the category enums from the side dishes
-                MainCourse::SideDish side_dishes_enum;
-                std::stringstream side_dishes_info(side_dishes);
-
-                std::string side_dishes_name, side_dishes_category;
-                std::getline(side_dishes_info, side_dishes_name, ':');
-                std::getline(side_dishes_info, side_dishes_category, ':');
-
-                side_dishes_enum.name = side_dishes_name;
-                if (side_dishes_category == "GRAIN")
-                {
-                    side_dishes_enum.category = MainCourse::Category::GRAIN;
-                }
-                else if (side_dishes_category == "PASTA")
-                {
-                    side_dishes_enum.category = MainCourse::Category::PASTA;
-                }
-                else if (side_dishes_category == "LEGUME")
-                {
-                    side_dishes_enum.category = MainCourse::Category::LEGUME;
-                }
-                else if (side_dishes_category == "BREAD")
-                {
-                    side_dishes_enum.category = MainCourse::Category::BREAD;
-                }
-                else if (side_dishes_category == "SALAD")
-                {
-                    side_dishes_enum.category = MainCourse::Category::SALAD;
-                }
-                else if (side_dishes_category == "SOUP")
-                {
-                    side_dishes_enum.category = MainCourse::Category::SOUP;
-                }
-                else if (side_dishes_category == "STARCHES")
-                {
-                    side_dishes_enum.category = MainCourse::Category::STARCHES;
-                }
-                else if (side_dishes_category == "VEGETABLE")
-                {
-                    side_dishes_enum.category = MainCourse::Category::VEGETABLE;
-                }
-                else
-                {
-                    side_dishes_enum.category = MainCourse::Category::GRAIN;
-                }
-                side_dishes_strings.push_back(side_dishes_enum);
-            }
-
-//Parsing the cuisine type enums
-            Dish::CuisineType cuisine_type_enum;
-            if (_cuisine_type_ == "ITALIAN")
-            {
-                cuisine_type_enum = Dish::CuisineType::ITALIAN;
-            }
-            else if (_cuisine_type_ == "MEXICAN")
-            {
-                cuisine_type_enum = Dish::CuisineType::MEXICAN;
-            }
-            else if (_cuisine_type_ == "CHINESE")
-            {
-                cuisine_type_enum = Dish::CuisineType::CHINESE;
-            }
-            else if (_cuisine_type_ == "INDIAN")
-            {
-                cuisine_type_enum = Dish::CuisineType::INDIAN;
-            }
-            else if (_cuisine_type_ == "AMERICAN")
-            {
-                cuisine_type_enum = Dish::CuisineType::AMERICAN;
-            }
-            else if (_cuisine_type_ == "FRENCH")
-            {
-                cuisine_type_enum = Dish::CuisineType::FRENCH;
-            }
-            else
-            {
-                cuisine_type_enum = Dish::CuisineType::OTHER;
-            }
-
-//Parsing the cooking method enums from the additional attributes
-            MainCourse::CookingMethod cooking_method_enum;
-            if (_cooking_method_ == "GRILLED")
-            {
-                cooking_method_enum = MainCourse::CookingMethod::GRILLED;
-            }
-            else if (_cooking_method_ == "BAKED")
-            {
-                cooking_method_enum = MainCourse::CookingMethod::BAKED;
-            }
-            else if (_cooking_method_ == "BOILED")
-            {
-                cooking_method_enum = MainCourse::CookingMethod::BOILED;
-            }
-            else if (_cooking_method_ == "FRIED")
-            {
-                cooking_method_enum = MainCourse::CookingMethod::FRIED;
-            }
-            else if (_cooking_method_ == "STEAMED")
-            {
-                cooking_method_enum = MainCourse::CookingMethod::STEAMED;
-            }
-            else if (_cooking_method_ == "RAW")
-            {
-                cooking_method_enum = MainCourse::CookingMethod::RAW;
-            }
-            else
-            {
-                cooking_method_enum = MainCourse::CookingMethod::GRILLED;
-            }
-
-            dish = new MainCourse(_name_, ingredient_strings, _prep_time_, _price_, cuisine_type_enum, cooking_method_enum, _protein_type_, side_dishes_strings, _gluten_free_);
+            dish = buildDish(row);
         }
-
-
-//Using if statements to create the dish object based on the dish type
-        else if (_dishtype_ == "DESSERT")
+        catch (const std::exception& error)
         {
-//Parsing the additional attributes
-            std::stringstream ss(_additional_attributes_);
-            std::string _flavor_profile_;
-            int _sweetness_level_;
-            bool _contains_nuts_; 
-            std::string temp_string;
-            std::getline(ss, _flavor_profile_, ';');
-
-            std::getline(ss, temp_string, ';');
-            _sweetness_level_ = std::stoi(temp_string);    
-            
-            std::getline(ss, temp_string, ';');
-            _contains_nuts_ = (temp_string == "true");
-
-//Parsing the ingredients vector
-            std::vector<std::string>ingredient_strings;
-            std::stringstream ingredient_ss(_ingredients_);
-            std::string ingredients;
-            while (std::getline(ingredient_ss, ingredients, ';'))
-            {
-                ingredient_strings.push_back(ingredients);
-            }
-
-//Parsing the cuisine type enums
-            Dish::CuisineType cuisine_type_enum;
-            if (_cuisine_type_ == "ITALIAN")
-            {
-                cuisine_type_enum = Dish::CuisineType::ITALIAN;
-            }
-            else if (_cuisine_type_ == "MEXICAN")
-            {
-                cuisine_type_enum = Dish::CuisineType::MEXICAN;
-            }
-            else if (_cuisine_type_ == "CHINESE")
-            {
-                cuisine_type_enum = Dish::CuisineType::CHINESE;
-            }
-            else if (_cuisine_type_ == "INDIAN")
-            {
-                cuisine_type_enum = Dish::CuisineType::INDIAN;
-            }
-            else if (_cuisine_type_ == "AMERICAN")
-            {
-                cuisine_type_enum = Dish::CuisineType::AMERICAN;
-            }
-            else if (_cuisine_type_ == "FRENCH")
-            {
-                cuisine_type_enum = Dish::CuisineType::FRENCH;
-            }
-            else
-            {
-                cuisine_type_enum = Dish::CuisineType::OTHER;
-            }
-
-//Parsing the flavor profile enums from the additional attributes
-            Dessert::FlavorProfile flavor_profile_enum;
-            if (_flavor_profile_ == "SWEET")
-            {
-                flavor_profile_enum = Dessert::FlavorProfile::SWEET;
-            }
-            else if (_flavor_profile_ == "BITTER")
-            {
-                flavor_profile_enum = Dessert::FlavorProfile::BITTER;
-            }
-            else if (_flavor_profile_ == "SOUR")
-            {
-                flavor_profile_enum = Dessert::FlavorProfile::SOUR;
-            }
-            else if (_flavor_profile_ == "SALTY")
-            {
-                flavor_profile_enum = Dessert::FlavorProfile::SALTY;
-            }
-            else if (_flavor_profile_ == "UMAMI")
-            {
-                flavor_profile_enum = Dessert::FlavorProfile::UMAMI;
-            }
-            else
-            {
-                flavor_profile_enum = Dessert::FlavorProfile::SWEET;
-            }
-            dish = new Dessert(_name_, ingredient_strings, _prep_time_, _price_, cuisine_type_enum, flavor_profile_enum, _sweetness_level_, _contains_nuts_);
+            build_scope.reject();
+            noteMalformedRow(result, error);
+            continue;
         }
 
 //Adding the dish to the kitchen
-        if (dish != nullptr)
+        if (dish == nullptr)
+        {
+            build_scope.reject(); // unknown dish type
+            result.unknown_type++;
+        }
+        else if (this->newOrder(dish))
         {
-            this->newOrder(dish);
+            build_scope.addItems(1);
+            result.added++;
+        }
+        else
+        {
+            delete dish; // a freshly built dish is never a duplicate, so the kitchen is full; newOrder() counted the drop
+            result.full++;
         }
     }
 }
@@ -632,32 +967,297 @@ kitchen to adjust them accordingly.
  */
 void Kitchen::dietaryAdjustment(const Dish::DietaryRequest& request)
 {
+    KitchenStats::Scope stats_scope(KitchenStats::DIETARY_ADJUSTMENT);
+    Tracer::Span trace_span("kitchen.dietaryAdjustment", "adjust");
+    stats_scope.addItems(getCurrentSize());
     for (int i = 0; i < getCurrentSize(); i++)
     {
         items_[i]->dietaryAccommodations(request);
     }
+    // Each adjusted dish marked the headers stale through markDirty(), so they are recounted once, on demand
+    for (OrderLog* log : logs_)
+    {
+        log->kitchenAdjusted(request);
+    }
+}
+
+/**
+ * Copies the hot fields of every dish into the header array again.
+ * @post Each header matches the current prep time, price and cuisine type of its dish,
+ * and the prep time sum and elaborate dish count are recounted from the dishes.
+ */
+void Kitchen::refreshDishHeaders()
+{
+    recountDishHeaders();
+    for (StationScheduler* scheduler : schedulers_)
+    {
+        scheduler->kitchenRefreshed();
+    }
+}
+
+/**
+ * Called by Dish::markDirty() when a dish in the kitchen changed.
+ * @param dish The dish that changed.
+ * @post The headers and running totals are recounted before the next aggregate,
+ * and each scheduler following the kitchen rereads that one dish's prep time.
+ */
+void Kitchen::dishChanged(const Dish* dish)
+{
+    headers_stale_ = true;
+    for (StationScheduler* scheduler : schedulers_)
+    {
+        scheduler->dishChanged(dish);
+    }
+}
+
+/**
+ * Recounts the headers and running totals if a dish changed since the last recount.
+ */
+void Kitchen::syncDishHeaders() const
+{
+    if (headers_stale_)
+    {
+        recountDishHeaders();
+    }
+}
+
+/**
+ * Copies every dish's hot fields into its header and recounts the running totals.
+ */
+void Kitchen::recountDishHeaders() const
+{
+    Tracer::Span trace_span("kitchen.refreshDishHeaders", "aggregate");
+    // A dietary adjustment can drop ingredients and a mutator can change the prep time,
+    // so the running totals kept by newOrder() and serveDish() are rebuilt here too
+    total_prep_time_ = 0;
+    count_elaborate_ = 0;
+    for (int i = 0; i < getCurrentSize(); i++)
+    {
+        headers_[i] = DishHeader::of(*items_[i]);
+        total_prep_time_ += items_[i]->getPrepTime();
+        if (items_[i]->getIngredientCount() >= 5 && items_[i]->getPrepTime() >= 60)
+        {
+            count_elaborate_++;
+        }
+    }
+    headers_stale_ = false;
 }
 
 /**
  * Displays all dishes currently in the kitchen.
- * @post Calls the `display()` method of each dish.
+ * @post Formats every dish into the kitchen's reusable menu buffer with `render()`
+ * and writes the whole menu to the standard output in a single write.
  */
 void Kitchen::displayMenu() const
 {
-    for (int i = 0; i < getCurrentSize(); i++)
+    StreamSink console(std::cout);
+    displayMenu(console);
+}
+
+/**
+ * Displays all dishes currently in the kitchen.
+ * @param out The sink that receives the menu.
+ * @post Formats every dish into the kitchen's reusable menu buffer with `render()`
+ * and writes the whole menu to `out` in a single write.
+ */
+void Kitchen::displayMenu(OutputSink& out) const
+{
+    KitchenStats::Scope stats_scope(KitchenStats::DISPLAY_MENU);
+    Tracer::Span trace_span("kitchen.displayMenu", "render");
+    stats_scope.addItems(getCurrentSize());
+    menu_renderer_.renderMenu(items_, getCurrentSize());
+    menu_renderer_.emit(out);
+}
+
+/**
+ * Displays only the dishes that changed since they were last rendered.
+ * @param out The sink that receives the changed dishes.
+ * @post Writes the display text of every dish that was added, modified by a
+ * mutator or adjusted by dietaryAdjustment() since it was last rendered, in
+ * kitchen order. Those dishes are no longer dirty afterwards.
+ * @return The number of dishes written.
+ */
+int Kitchen::displayMenuChanges(OutputSink& out) const
+{
+    KitchenStats::Scope stats_scope(KitchenStats::DISPLAY_MENU);
+    Tracer::Span trace_span("kitchen.displayMenu", "render");
+    int changed = menu_renderer_.renderChanged(items_, getCurrentSize());
+    stats_scope.addItems(changed);
+    menu_renderer_.emit(out);
+    return changed;
+}
+
+/**
+ * Displays one page of the menu.
+ * @param out The sink that receives the page.
+ * @param offset The index of the first dish on the page.
+ * @param limit The maximum number of dishes on the page.
+ * @post Writes the dishes in [offset, offset + limit) that exist, in kitchen
+ * order, in a single write. Only the dishes on the page are touched.
+ * @return The number of dishes written.
+ */
+int Kitchen::displayMenu(OutputSink& out, int offset, int limit) const
+{
+    KitchenStats::Scope stats_scope(KitchenStats::DISPLAY_MENU);
+    Tracer::Span trace_span("kitchen.displayMenu", "render");
+    if (offset < 0)
+    {
+        offset = 0;
+    }
+    int count = getCurrentSize() - offset;
+    if (count > limit)
+    {
+        count = limit;
+    }
+    if (count < 0)
+    {
+        count = 0;
+    }
+    stats_scope.addItems(count);
+    menu_renderer_.renderMenu(items_ + offset, count);
+    menu_renderer_.emit(out);
+    return count;
+}
+
+void Kitchen::attachCursor(MenuCursor* cursor) const
+{
+    cursors_.push_back(cursor);
+}
+
+void Kitchen::detachCursor(MenuCursor* cursor) const
+{
+    for (size_t i = 0; i < cursors_.size(); i++)
+    {
+        if (cursors_[i] == cursor)
+        {
+            cursors_.erase(cursors_.begin() + i);
+            return;
+        }
+    }
+}
+
+void Kitchen::attachScheduler(StationScheduler* scheduler) const
+{
+    schedulers_.push_back(scheduler);
+}
+
+void Kitchen::detachScheduler(StationScheduler* scheduler) const
+{
+    for (size_t i = 0; i < schedulers_.size(); i++)
+    {
+        if (schedulers_[i] == scheduler)
+        {
+            schedulers_.erase(schedulers_.begin() + i);
+            return;
+        }
+    }
+}
+
+void Kitchen::attachLog(OrderLog* log)
+{
+    logs_.push_back(log);
+}
+
+void Kitchen::detachLog(OrderLog* log)
+{
+    for (size_t i = 0; i < logs_.size(); i++)
     {
-        items_[i]->display();
+        if (logs_[i] == log)
+        {
+            logs_.erase(logs_.begin() + i);
+            return;
+        }
     }
 }
 
+KitchenStats& Kitchen::stats()
+{
+    return KitchenStats::instance();
+}
+
+/**
+ * Exports all dishes currently in the kitchen as CSV.
+ * @param out The sink that receives the CSV text.
+ * @post Writes a header line and one row per dish in the same schema as
+ * Dishes.csv, so the output can be loaded back with Kitchen(filename).
+ * Fields containing a comma, a double quote or a line break are quoted, and
+ * ';', '|', ':' and '\' inside an ingredient, protein type or side dish name
+ * are escaped with a backslash. A field holding an escape or an empty
+ * ingredient is quoted too, since Kitchen(filename) only removes escapes
+ * from quoted fields and reads an unquoted empty field as no ingredients.
+ */
+void Kitchen::exportCsv(OutputSink& out) const
+{
+    KitchenStats::Scope stats_scope(KitchenStats::EXPORT);
+    Tracer::Span trace_span("kitchen.exportCsv", "render");
+    stats_scope.addItems(getCurrentSize());
+    menu_renderer_.renderCsv(items_, getCurrentSize());
+    menu_renderer_.emit(out);
+}
+
+/**
+ * Exports all dishes currently in the kitchen as JSON.
+ * @param out The sink that receives the JSON text.
+ * @post Writes a JSON array with one object per dish, including the
+ * subclass attributes.
+ */
+void Kitchen::exportJson(OutputSink& out) const
+{
+    KitchenStats::Scope stats_scope(KitchenStats::EXPORT);
+    Tracer::Span trace_span("kitchen.exportJson", "render");
+    stats_scope.addItems(getCurrentSize());
+    menu_renderer_.renderJson(items_, getCurrentSize());
+    menu_renderer_.emit(out);
+}
+
 /**
  * Destructor.
  * @post Deallocates all dynamically allocated dishes to prevent memory
 leaks. */
 Kitchen::~Kitchen()
 {
+    for (MenuCursor* cursor : cursors_)
+    {
+        cursor->kitchenDestroyed();
+    }
+    for (StationScheduler* scheduler : schedulers_)
+    {
+        scheduler->kitchenDestroyed();
+    }
+    for (OrderLog* log : logs_)
+    {
+        log->kitchenDestroyed();
+    }
     for (int i = 0; i < getCurrentSize(); i++)
     {
         delete items_[i];
     }
 }
+
+/**
+ * @param line One row in the Dishes.csv schema, without the line break.
+ * @return A new dish owned by the caller, or nullptr if the dish type is unknown.
+ * @throws std::invalid_argument or std::out_of_range if a numeric field is not a number.
+ */
+Dish* Kitchen::parseDish(const std::string& line)
+{
+    DishRow row;
+    readDishRow(line, row);
+    return buildDish(row);
+}
+
+/**
+ * @param name The name of the dish to find.
+ * @return The first dish in the kitchen with that name, or nullptr if there is none.
+ */
+Dish* Kitchen::findDish(const std::string& name) const
+{
+    for (int i = 0; i < getCurrentSize(); i++)
+    {
+        if (items_[i]->getName() == name)
+        {
+            return items_[i];
+        }
+    }
+    return nullptr;
+}
@@ -15,9 +15,19 @@
 
 #include "ArrayBag.hpp"
 #include "Dish.hpp"
+#include "MenuRenderer.hpp"
+#include "OutputSink.hpp"
+#include "MenuCursor.hpp"
+#include "DishHeader.hpp"
+#include "KitchenStats.hpp"
+#include <string>
+#include <vector>
 // for round
 #include <cmath>
 
+class StationScheduler;
+class OrderLog;
+
 //The Kitchen class is a subclass of ArrayBag that stores Dish objects.
 class Kitchen : public ArrayBag<Dish*> {
     public:
@@ -37,6 +47,22 @@ kitchen, false otherwise. Hint: Use the above definition of equality to help det
 */
         bool newOrder(Dish* new_dish);
 
+/**
+ * Adds a batch of dishes under one statistics scope and trace span.
+ * @param dishes The dishes to add, in order.
+ * @param count The number of dishes.
+ * @post Adds dishes[0], dishes[1], ... exactly as newOrder() would, stopping
+ * at the first dish the kitchen refuses (full, or already in the kitchen).
+ * @return The number of dishes added; the kitchen owns dishes[0..n) and the
+ * caller still owns the rest.
+ */
+        int newOrders(Dish* const* dishes, int count);
+
+/**
+ * @return The most dishes the kitchen can hold.
+ */
+        static int getCapacity() { return DEFAULT_CAPACITY; }
+
 /**
   * @param : A reference to a `Dish*` leaving the kitchen.
   * @return : Returns true if a dish was successfully removed from the kitchen (i.e., items_), false otherwise.
@@ -58,6 +84,27 @@ rounded to the NEAREST integer.
 */
         int calculateAvgPrepTime() const;
 
+/**
+  * @return : The exact sum, in cents, of the prices of all the dishes
+currently in the kitchen.
+*/
+        Cents getPriceCentsSum() const;
+
+/**
+  * @param : A reference to a string representing a cuisine type, matched
+exactly as in tallyCuisineTypes().
+  * @return : The exact sum, in cents, of the prices of the dishes of the
+given cuisine type, or zero if the string is not a cuisine type.
+*/
+        Cents getPriceCentsSum(const std::string& cuisine_type) const;
+
+/**
+  * @return : The average price, in cents, of all the dishes in the kitchen
+rounded to the NEAREST cent (halves away from zero), or 0 if the kitchen is
+empty.
+*/
+        Cents calculateAvgPriceCents() const;
+
 /**
   * @return : The integer count of the elaborate dishes in the kitchen.
 */
@@ -94,6 +141,16 @@ less than the given time.
 */
         int releaseDishesBelowPrepTime(const int& prep_time);
 
+/**
+ * Same as releaseDishesBelowPrepTime(prep_time), and hands the removed
+ * dishes to the caller.
+ * @param prep_time The preparation time threshold.
+ * @param released Receives the removed dishes, which the kitchen no
+longer owns; the caller deletes them.
+ * @return The number of dishes removed from the kitchen.
+ */
+        int releaseDishesBelowPrepTime(const int& prep_time, std::vector<Dish*>& released);
+
 /**
   * @param : A reference to a string representing a cuisine type with a
 value in
@@ -109,6 +166,16 @@ types, do not remove any dishes.
 */
         int releaseDishesOfCuisineType(const std::string& cuisine_type);
 
+/**
+ * Same as releaseDishesOfCuisineType(cuisine_type), and hands the removed
+ * dishes to the caller.
+ * @param cuisine_type The cuisine type token.
+ * @param released Receives the removed dishes, which the kitchen no
+longer owns; the caller deletes them.
+ * @return The number of dishes removed from the kitchen.
+ */
+        int releaseDishesOfCuisineType(const std::string& cuisine_type, std::vector<Dish*>& released);
+
 /**
   * @post : Outputs a report of the dishes currently in the kitchen in the
 form: "ITALIAN: {x}\nMEXICAN: {x}\nCHINESE: {x}\nINDIAN: {x}\nAMERICAN: {x}\nFRENCH: {x}\nOTHER: {x}\n\n AVERAGE PREP TIME: {x}\ELABORATE: {x}%\n"
@@ -127,16 +194,67 @@ AVERAGE PREP TIME: 62
 ELABORATE DISHES: 53.85%
 */
         void kitchenReport() const;
+
+/**
+ * Writes the kitchen report to the given sink.
+ * @param out The sink that receives the report.
+ * @post Outputs the same text as kitchenReport() to `out` in a single write.
+ * The percentage is always printed with 2 decimal places and no stream
+ * formatting state is changed.
+ */
+        void kitchenReport(OutputSink& out) const;
+/**
+ * What Kitchen(filename, result) did with each row of the file.
+ */
+        struct LoadResult
+        {
+            bool opened = false;      ///< False if the file could not be opened.
+            int rows = 0;             ///< Rows read, not counting the header.
+            int added = 0;            ///< Dishes the kitchen kept.
+            int full = 0;             ///< Rows dropped because the kitchen was full.
+            int unknown_type = 0;     ///< Rows skipped for an unknown dish type.
+            int malformed = 0;        ///< Rows skipped because a field did not parse.
+            std::string first_error;  ///< "row N: reason" for the first malformed row.
+        };
+
 /**
  * Parameterized constructor.
  * @param filename The name of the input CSV file containing dish
 information.
- * @pre The CSV file must be properly formatted.
  * @post Initializes the kitchen by reading dishes from the CSV file and
-storing them as `Dish*`.
+storing them as `Dish*`. Malformed rows are skipped and reported on
+std::cerr.
  */
         Kitchen(const std::string& filename);
 
+/**
+ * Parameterized constructor that reports what happened to each row.
+ * @param filename The name of the input CSV file containing dish
+information.
+ * @param result Receives the row counts.
+ * @post Initializes the kitchen from the rows that parse, up to its
+capacity; malformed rows and rows of an unknown dish type are skipped.
+Never throws on a bad row, so no dish built from an earlier row is leaked.
+ */
+        Kitchen(const std::string& filename, LoadResult& result);
+
+/**
+ * Builds one dish from a row of the CSV schema read by Kitchen(filename).
+ * @param line One row in the Dishes.csv schema, without the line break.
+ * @return A new dish owned by the caller, or nullptr if the dish type is
+ * unknown.
+ * @throws std::invalid_argument or std::out_of_range if a numeric field is
+ * not a number.
+ */
+        static Dish* parseDish(const std::string& line);
+
+/**
+ * @param name The name of the dish to find.
+ * @return The first dish in the kitchen with that name, or nullptr if there
+ * is none. The kitchen still owns it.
+ */
+        Dish* findDish(const std::string& name) const;
+
 /**
  * Adjusts all dishes in the kitchen based on the specified dietary
 accommodation.
@@ -147,12 +265,81 @@ kitchen to adjust them accordingly.
  */
         void dietaryAdjustment(const Dish::DietaryRequest& request);
 
+/**
+ * Copies the hot fields of every dish into the header array again.
+ * @post Each header matches the current prep time, price and cuisine type of its dish,
+ * and the prep time sum and elaborate dish count are recounted from the dishes.
+ * A dish changed through its own mutators while it is in the kitchen tells the
+ * kitchen, which does this itself before its next aggregate, so calling it is
+ * never required; it only makes the recount happen now instead of on demand.
+ */
+        void refreshDishHeaders();
+
 /**
  * Displays all dishes currently in the kitchen.
- * @post Calls the `display()` method of each dish.
+ * @post Formats every dish into the kitchen's reusable menu buffer with `render()`
+ * and writes the whole menu to the standard output in a single write.
  */
         void displayMenu() const;
 
+/**
+ * Displays all dishes currently in the kitchen.
+ * @param out The sink that receives the menu.
+ * @post Formats every dish into the kitchen's reusable menu buffer with `render()`
+ * and writes the whole menu to `out` in a single write.
+ */
+        void displayMenu(OutputSink& out) const;
+
+/**
+ * Displays only the dishes that changed since they were last rendered.
+ * @param out The sink that receives the changed dishes.
+ * @post Writes the display text of every dish that was added, modified by a
+ * mutator or adjusted by dietaryAdjustment() since it was last rendered, in
+ * kitchen order. Those dishes are no longer dirty afterwards.
+ * @return The number of dishes written.
+ */
+        int displayMenuChanges(OutputSink& out) const;
+
+/**
+ * Displays one page of the menu.
+ * @param out The sink that receives the page.
+ * @param offset The index of the first dish on the page.
+ * @param limit The maximum number of dishes on the page.
+ * @post Writes the dishes in [offset, offset + limit) that exist, in kitchen
+ * order, in a single write. Only the dishes on the page are touched.
+ * @return The number of dishes written.
+ */
+        int displayMenu(OutputSink& out, int offset, int limit) const;
+
+/**
+ * @return The hot-path statistics shared by all kitchens (calls, time,
+ * items, rejections and capacity drops per operation). Take a snapshot() to
+ * read them and reset() to start over. They only count when the program is
+ * built with `make STATS=1`; otherwise every snapshot reads zero.
+ */
+        static KitchenStats& stats();
+
+/**
+ * Exports all dishes currently in the kitchen as CSV.
+ * @param out The sink that receives the CSV text.
+ * @post Writes a header line and one row per dish in the same schema as
+ * Dishes.csv, so the output can be loaded back with Kitchen(filename).
+ * Fields containing a comma, a double quote or a line break are quoted, and
+ * ';', '|', ':' and '\' inside an ingredient, protein type or side dish name
+ * are escaped with a backslash. A field holding an escape or an empty
+ * ingredient is quoted too, since Kitchen(filename) only removes escapes
+ * from quoted fields and reads an unquoted empty field as no ingredients.
+ */
+        void exportCsv(OutputSink& out) const;
+
+/**
+ * Exports all dishes currently in the kitchen as JSON.
+ * @param out The sink that receives the JSON text.
+ * @post Writes a JSON array with one object per dish, including the
+ * subclass attributes.
+ */
+        void exportJson(OutputSink& out) const;
+
 /**
  * Destructor.
  * @post Deallocates all dynamically allocated dishes to prevent memory
@@ -160,8 +347,88 @@ leaks. */
         ~Kitchen();
 
     private:
-        int total_prep_time_;
-        int count_elaborate_;
+        friend class MenuCursor;
+        friend class StationScheduler;
+        friend class OrderLog;
+        friend class Dish;
+
+/**
+ * Adds the dishes of a CSV file, counting what happens to each row.
+ * @param filename The name of the input CSV file.
+ * @param result Receives the row counts.
+ */
+        void load(const std::string& filename, LoadResult& result);
+
+// The release loops; `released`, if set, receives the removed dishes
+        int releaseBelowPrepTime(int prep_time, std::vector<Dish*>* released);
+        int releaseOfCuisineType(const std::string& cuisine_type, std::vector<Dish*>* released);
+
+/**
+ * Registers a cursor so it is told about removed dishes.
+ * @param cursor The cursor to register.
+ */
+        void attachCursor(MenuCursor* cursor) const;
+
+/**
+ * Unregisters a cursor.
+ * @param cursor The cursor to unregister.
+ */
+        void detachCursor(MenuCursor* cursor) const;
+
+/**
+ * Registers a scheduler so it is told about added, removed and refreshed dishes.
+ * @param scheduler The scheduler to register.
+ */
+        void attachScheduler(StationScheduler* scheduler) const;
+
+/**
+ * Unregisters a scheduler.
+ * @param scheduler The scheduler to unregister.
+ */
+        void detachScheduler(StationScheduler* scheduler) const;
+
+/**
+ * Registers a log so it records every mutation.
+ * @param log The log to register.
+ */
+        void attachLog(OrderLog* log);
+
+/**
+ * Unregisters a log.
+ * @param log The log to unregister.
+ */
+        void detachLog(OrderLog* log);
+
+/**
+ * Called by Dish::markDirty() when a dish in the kitchen changed.
+ * @param dish The dish that changed.
+ * @post The headers and running totals are recounted before the next aggregate,
+ * and each scheduler following the kitchen rereads that one dish's prep time.
+ */
+        void dishChanged(const Dish* dish);
+
+/**
+ * Recounts the headers and running totals if a dish changed since the last recount.
+ */
+        void syncDishHeaders() const;
+
+/**
+ * Copies every dish's hot fields into its header and recounts the running totals.
+ */
+        void recountDishHeaders() const;
+
+        // The running totals and headers are caches of the dishes, recounted on demand by const aggregates
+        mutable int total_prep_time_;
+        mutable int count_elaborate_;
+        // Hot fields of items_[i] in headers_[i], kept in the same order so aggregate scans never dereference a Dish*.
+        // newOrder() and serveDish() keep it in order; a dish changed in place sets headers_stale_ through dishChanged().
+        // Calling ArrayBag::add/remove/clear directly bypasses both.
+        mutable DishHeader headers_[DEFAULT_CAPACITY];
+        mutable bool headers_stale_;
+        mutable std::vector<MenuCursor*> cursors_; // open cursors, notified by serveDish()
+        mutable std::vector<StationScheduler*> schedulers_; // schedulers following the kitchen, notified by newOrder(), newOrders(), serveDish(), dishChanged() and refreshDishHeaders()
+        std::vector<OrderLog*> logs_; // logs recording the kitchen, notified by newOrder(), newOrders(), serveDish() and dietaryAdjustment() after the change
+        mutable MenuRenderer menu_renderer_; // reused by displayMenu() and kitchenReport() so the buffer is only allocated once
     
 };
 
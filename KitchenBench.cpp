@@ -0,0 +1,587 @@
+/**
+ * @file KitchenBench.cpp
+ * @brief This file contains the Kitchen microbenchmark suite run by `make bench`.
+ *
+ * Every public Kitchen operation that matters for throughput is measured at sizes from 10^2 to 10^6 dishes:
+ * CSV load, newOrder, serveDish, tallyCuisineTypes, calculateAvgPrepTime, releaseDishesBelowPrepTime,
+ * dietaryAdjustment, kitchenReport and displayMenu (the last two to a NullSink). displayMenu is measured twice:
+ * displayMenu.cached with every dish's text already cached, which only copies the texts into the menu buffer, and
+ * displayMenu.dirty with every dish changed before each round, which formats every dish again. A Kitchen holds at
+ * most 100 dishes, so a size of N dishes is N / 100 full kitchens, each processed in turn. The StationScheduler
+ * benchmarks schedule all N dishes on 8 stations at once, with a full rebalance and with one add and one remove per
+ * dish.
+ *
+ * Each benchmark repeats rounds (untimed setup, timed run, untimed teardown) until the timed part reaches the
+ * minimum time. Allocations and bytes in the timed part are counted by AllocTracker, which replaces the global
+ * operator new in this binary only. A second section loads kitchens from the CSV file and runs the adjustment,
+ * display and report paths once each inside AllocTracker phases, giving allocations per row and per dish.
+ * Results are written to stdout as JSON, progress to stderr.
+ *
+ * Usage: ./kitchenbench [csv_file] [--max-size N] [--min-time-ms M] [--filter NAME]
+ *
+ * @date October 17, 2026
+ * @author Kun Feng Wei
+ */
+
+#include "Kitchen.hpp"
+#include "AllocTracker.hpp"
+#include "Appetizer.hpp"
+#include "MainCourse.hpp"
+#include "Dessert.hpp"
+#include "MenuRenderer.hpp"
+#include "OutputSink.hpp"
+#include "StationScheduler.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+static const int KITCHEN_CAPACITY = 100;
+static const int MAX_ROUNDS = 100000;
+static const int PREP_TIME_THRESHOLD = 30;
+static const int SCHEDULER_STATIONS = 8;
+
+// Results of read-only operations are added here so the compiler cannot drop the calls
+static volatile long long checksum = 0;
+
+struct Options
+{
+    std::string filename = "Dishes.csv";
+    long long max_size = 1000000;
+    double min_time_ns = 20e6;
+    double max_wall_ns = 2e9;  // stop repeating rounds once setup and run together take this long
+    std::string filter;
+};
+
+// Totals of one benchmark at one size
+struct Measurement
+{
+    long long rounds = 0;
+    long long ops = 0;
+    double ns = 0;
+    unsigned long long allocations = 0;
+    unsigned long long bytes = 0;
+};
+
+using Kitchens = std::vector<std::unique_ptr<Kitchen>>;
+
+// Builds a deterministic dish; prep times spread over 5..124 minutes so releases remove about a fifth of the dishes
+static Dish* makeDish(long long index)
+{
+    int prep_time = 5 + static_cast<int>((index * 37) % 120);
+    double price = 3.0 + static_cast<double>((index * 7919) % 2000) / 100.0;
+    Dish::CuisineType cuisine = static_cast<Dish::CuisineType>(index % 7);
+    switch (index % 3)
+    {
+        case 0:
+            return new Appetizer("Spring Rolls", {"Cabbage", "Pork", "Flour", "Rice Paper"}, prep_time, price, cuisine, Appetizer::BUFFET, 3, false);
+        case 1:
+            return new MainCourse("Pot Roast", {"Beef", "Carrots", "Butter", "Onion", "Garlic"}, prep_time, price, cuisine, MainCourse::BAKED, "Beef", {{"Rice", MainCourse::GRAIN}, {"Salad", MainCourse::SALAD}}, false);
+        default:
+            return new Dessert("Carrot Cake", {"Flour", "Walnuts", "Sugar", "Cream"}, prep_time, price, cuisine, Dessert::SWEET, 5, true);
+    }
+}
+
+static long long kitchenCount(long long size)
+{
+    return (size + KITCHEN_CAPACITY - 1) / KITCHEN_CAPACITY;
+}
+
+static std::vector<Dish*> makeDishes(long long size)
+{
+    std::vector<Dish*> dishes;
+    dishes.reserve(size);
+    for (long long i = 0; i < size; i++)
+    {
+        dishes.push_back(makeDish(i));
+    }
+    return dishes;
+}
+
+static void makeEmptyKitchens(Kitchens& kitchens, long long size)
+{
+    kitchens.clear();
+    for (long long i = 0; i < kitchenCount(size); i++)
+    {
+        kitchens.emplace_back(new Kitchen());
+    }
+}
+
+// Puts dish i into kitchen i / 100; the kitchens own the dishes from then on
+static void fillKitchens(Kitchens& kitchens, const std::vector<Dish*>& dishes)
+{
+    makeEmptyKitchens(kitchens, dishes.size());
+    for (size_t i = 0; i < dishes.size(); i++)
+    {
+        kitchens[i / KITCHEN_CAPACITY]->newOrder(dishes[i]);
+    }
+}
+
+// Serves every dish still in the kitchens, then deletes all of them; serveDish() leaves ownership with the caller
+static void emptyKitchens(Kitchens& kitchens, std::vector<Dish*>& dishes)
+{
+    for (size_t i = 0; i < dishes.size(); i++)
+    {
+        kitchens[i / KITCHEN_CAPACITY]->serveDish(dishes[i]);
+    }
+    for (Dish* dish : dishes)
+    {
+        delete dish;
+    }
+    dishes.clear();
+    kitchens.clear();
+}
+
+// Repeats untimed setup, timed run and untimed teardown; run returns the number of operations it performed
+template <class Setup, class Run, class Teardown>
+static Measurement measure(const Options& options, Setup setup, Run run, Teardown teardown)
+{
+    Measurement measurement;
+    std::chrono::steady_clock::time_point wall_begin = std::chrono::steady_clock::now();
+    double wall_ns = 0;
+    do
+    {
+        setup();
+        AllocTracker::Totals before = AllocTracker::current();
+        std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+        measurement.ops += run();
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+        AllocTracker::Totals after = AllocTracker::current();
+        measurement.allocations += after.allocations - before.allocations;
+        measurement.bytes += after.bytes - before.bytes;
+        measurement.ns += std::chrono::duration<double, std::nano>(end - begin).count();
+        measurement.rounds++;
+        teardown();
+        wall_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - wall_begin).count();
+    } while (measurement.ns < options.min_time_ns && measurement.rounds < MAX_ROUNDS && wall_ns < options.max_wall_ns);
+    return measurement;
+}
+
+// Measures an operation that leaves the kitchens as it found them, on kitchens filled once.
+// One untimed warm-up run fills the display caches, so the rounds measure the steady state.
+template <class Run>
+static Measurement measureReadOnly(const Options& options, long long size, Run run)
+{
+    Kitchens kitchens;
+    std::vector<Dish*> dishes = makeDishes(size);
+    fillKitchens(kitchens, dishes);
+    run(kitchens);
+    return measure(options, []() {}, [&]() { return run(kitchens); }, []() {});
+}
+
+static Measurement benchCsvLoad(const Options& options, long long size)
+{
+    Kitchens kitchens;
+    return measure(options, []() {},
+        [&]() {
+            long long rows = 0;
+            for (long long i = 0; i < kitchenCount(size); i++)
+            {
+                Kitchen::LoadResult result;
+                kitchens.emplace_back(new Kitchen(options.filename, result));
+                rows += result.rows;
+            }
+            return rows;
+        },
+        [&]() { kitchens.clear(); });
+}
+
+static Measurement benchNewOrder(const Options& options, long long size)
+{
+    Kitchens kitchens;
+    std::vector<Dish*> dishes;
+    return measure(options,
+        [&]() {
+            dishes = makeDishes(size);
+            makeEmptyKitchens(kitchens, size);
+        },
+        [&]() {
+            for (size_t i = 0; i < dishes.size(); i++)
+            {
+                kitchens[i / KITCHEN_CAPACITY]->newOrder(dishes[i]);
+            }
+            return static_cast<long long>(dishes.size());
+        },
+        [&]() {
+            dishes.clear();
+            kitchens.clear();
+        });
+}
+
+static Measurement benchServeDish(const Options& options, long long size)
+{
+    Kitchens kitchens;
+    std::vector<Dish*> dishes;
+    return measure(options,
+        [&]() {
+            dishes = makeDishes(size);
+            fillKitchens(kitchens, dishes);
+        },
+        [&]() {
+            for (size_t i = 0; i < dishes.size(); i++)
+            {
+                kitchens[i / KITCHEN_CAPACITY]->serveDish(dishes[i]);
+            }
+            return static_cast<long long>(dishes.size());
+        },
+        [&]() { emptyKitchens(kitchens, dishes); });
+}
+
+static Measurement benchReleaseDishes(const Options& options, long long size)
+{
+    Kitchens kitchens;
+    std::vector<Dish*> dishes;
+    return measure(options,
+        [&]() {
+            dishes = makeDishes(size);
+            fillKitchens(kitchens, dishes);
+        },
+        [&]() {
+            for (std::unique_ptr<Kitchen>& kitchen : kitchens)
+            {
+                kitchen->releaseDishesBelowPrepTime(PREP_TIME_THRESHOLD);
+            }
+            return static_cast<long long>(dishes.size());
+        },
+        [&]() { emptyKitchens(kitchens, dishes); });
+}
+
+static Measurement benchDietaryAdjustment(const Options& options, long long size)
+{
+    Kitchens kitchens;
+    Dish::DietaryRequest request = {true, true, true, true, true, true};
+    return measure(options,
+        [&]() { fillKitchens(kitchens, makeDishes(size)); },
+        [&]() {
+            for (std::unique_ptr<Kitchen>& kitchen : kitchens)
+            {
+                kitchen->dietaryAdjustment(request);
+            }
+            return size;
+        },
+        [&]() { kitchens.clear(); });
+}
+
+static Measurement benchTallyCuisineTypes(const Options& options, long long size)
+{
+    return measureReadOnly(options, size, [&](Kitchens& kitchens) {
+        for (std::unique_ptr<Kitchen>& kitchen : kitchens)
+        {
+            checksum = checksum + kitchen->tallyCuisineTypes("ITALIAN");
+        }
+        return size;
+    });
+}
+
+static Measurement benchAvgPrepTime(const Options& options, long long size)
+{
+    return measureReadOnly(options, size, [&](Kitchens& kitchens) {
+        for (std::unique_ptr<Kitchen>& kitchen : kitchens)
+        {
+            checksum = checksum + kitchen->calculateAvgPrepTime();
+        }
+        return size;
+    });
+}
+
+static Measurement benchKitchenReport(const Options& options, long long size)
+{
+    NullSink sink;
+    return measureReadOnly(options, size, [&](Kitchens& kitchens) {
+        for (std::unique_ptr<Kitchen>& kitchen : kitchens)
+        {
+            kitchen->kitchenReport(sink);
+        }
+        return size;
+    });
+}
+
+// Every dish's text is cached by the warm-up run, so this measures copying the texts into the buffer and the write
+static Measurement benchDisplayMenuCached(const Options& options, long long size)
+{
+    NullSink sink;
+    return measureReadOnly(options, size, [&](Kitchens& kitchens) {
+        for (std::unique_ptr<Kitchen>& kitchen : kitchens)
+        {
+            kitchen->displayMenu(sink);
+        }
+        return size;
+    });
+}
+
+// Every dish is marked changed before each round, so every dish is formatted again; an untimed first run sizes
+// the buffers, so the rounds measure formatting rather than first-time allocation
+static Measurement benchDisplayMenuDirty(const Options& options, long long size)
+{
+    NullSink sink;
+    Kitchens kitchens;
+    std::vector<Dish*> dishes = makeDishes(size);
+    fillKitchens(kitchens, dishes);
+    for (std::unique_ptr<Kitchen>& kitchen : kitchens)
+    {
+        kitchen->displayMenu(sink);
+    }
+    return measure(options,
+        [&]() {
+            // Setting a field to its own value invalidates the cached text without changing the menu
+            for (Dish* dish : dishes)
+            {
+                dish->setPrepTime(dish->getPrepTime());
+            }
+        },
+        [&]() {
+            for (std::unique_ptr<Kitchen>& kitchen : kitchens)
+            {
+                kitchen->displayMenu(sink);
+            }
+            return size;
+        },
+        []() {});
+}
+
+// Schedules every dish on SCHEDULER_STATIONS stations from scratch
+static Measurement benchScheduleRebalance(const Options& options, long long size)
+{
+    std::vector<Dish*> dishes = makeDishes(size);
+    StationScheduler scheduler(SCHEDULER_STATIONS, StationScheduler::LPT);
+    for (Dish* dish : dishes)
+    {
+        scheduler.add(dish);
+    }
+    Measurement measurement = measure(options, []() {},
+        [&]() {
+            scheduler.rebalance();
+            checksum = checksum + scheduler.makespan();
+            return size;
+        },
+        []() {});
+    for (Dish* dish : dishes)
+    {
+        delete dish;
+    }
+    return measurement;
+}
+
+// Adds every dish to an empty schedule one at a time, then removes them all
+static Measurement benchScheduleIncremental(const Options& options, long long size)
+{
+    std::vector<Dish*> dishes = makeDishes(size);
+    Measurement measurement = measure(options, []() {},
+        [&]() {
+            StationScheduler scheduler(SCHEDULER_STATIONS, StationScheduler::LPT);
+            for (Dish* dish : dishes)
+            {
+                scheduler.add(dish);
+            }
+            checksum = checksum + scheduler.makespan();
+            for (Dish* dish : dishes)
+            {
+                scheduler.remove(dish);
+            }
+            return 2 * size;
+        },
+        []() {});
+    for (Dish* dish : dishes)
+    {
+        delete dish;
+    }
+    return measurement;
+}
+
+// One entry of the suite; `unit` names what a single op is
+struct Benchmark
+{
+    const char* name;
+    const char* unit;
+    Measurement (*run)(const Options&, long long);
+};
+
+static const Benchmark BENCHMARKS[] = {
+    {"csvLoad", "row", benchCsvLoad},
+    {"newOrder", "call", benchNewOrder},
+    {"serveDish", "call", benchServeDish},
+    {"tallyCuisineTypes", "dish", benchTallyCuisineTypes},
+    {"calculateAvgPrepTime", "dish", benchAvgPrepTime},
+    {"releaseDishesBelowPrepTime", "dish", benchReleaseDishes},
+    {"dietaryAdjustment", "dish", benchDietaryAdjustment},
+    {"kitchenReport", "dish", benchKitchenReport},
+    {"displayMenu.cached", "dish", benchDisplayMenuCached},
+    {"displayMenu.dirty", "dish", benchDisplayMenuDirty},
+    {"scheduleRebalance", "dish", benchScheduleRebalance},
+    {"scheduleIncremental", "call", benchScheduleIncremental},
+};
+
+static void appendResult(MenuRenderer& out, const Benchmark& benchmark, long long size, const Measurement& measurement)
+{
+    double ops = static_cast<double>(measurement.ops > 0 ? measurement.ops : 1);
+    double ns_per_op = measurement.ns / ops;
+    out.append("    {\"name\": ").appendJsonString(benchmark.name);
+    out.append(", \"size\": ").appendInt(size);
+    out.append(", \"unit\": ").appendJsonString(benchmark.unit);
+    out.append(", \"rounds\": ").appendInt(measurement.rounds);
+    out.append(", \"ops\": ").appendInt(measurement.ops);
+    out.append(", \"ns_per_op\": ").appendFixed(ns_per_op, 3);
+    out.append(", \"ops_per_sec\": ").appendFixed(ns_per_op > 0 ? 1e9 / ns_per_op : 0.0, 1);
+    out.append(", \"allocs_per_op\": ").appendFixed(static_cast<double>(measurement.allocations) / ops, 3);
+    out.append(", \"bytes_per_op\": ").appendFixed(static_cast<double>(measurement.bytes) / ops, 1);
+    out.append('}');
+}
+
+// The phases of the allocation section, in the order they run; `unit` is what the counts are divided by
+struct AllocationPhase
+{
+    const char* name;
+    const char* unit;
+};
+
+static const AllocationPhase ALLOCATION_PHASES[] = {
+    {"load", "row"},
+    {"dietaryAdjustment", "dish"},
+    {"displayMenu.first", "dish"},
+    {"displayMenu.cached", "dish"},
+    {"kitchenReport", "dish"},
+};
+
+// Loads size / 100 kitchens from the CSV file and runs each path once inside its own phase; `rows` counts the
+// rows the loader read and `dishes` the dishes the kitchens kept
+static void runAllocationPhases(const Options& options, long long size, long long& rows, long long& dishes)
+{
+    Dish::DietaryRequest request = {true, true, true, true, true, true};
+    NullSink sink;
+    Kitchens kitchens;
+    kitchens.reserve(kitchenCount(size));
+    AllocTracker::resetPhases();
+    rows = 0;
+    dishes = 0;
+    {
+        AllocTracker::Phase phase("load");
+        for (long long i = 0; i < kitchenCount(size); i++)
+        {
+            Kitchen::LoadResult result;
+            kitchens.emplace_back(new Kitchen(options.filename, result));
+            rows += result.rows;
+            dishes += kitchens.back()->getCurrentSize();
+        }
+    }
+    {
+        AllocTracker::Phase phase("dietaryAdjustment");
+        for (std::unique_ptr<Kitchen>& kitchen : kitchens)
+        {
+            kitchen->dietaryAdjustment(request);
+        }
+    }
+    for (const char* name : {"displayMenu.first", "displayMenu.cached"})
+    {
+        AllocTracker::Phase phase(name);
+        for (std::unique_ptr<Kitchen>& kitchen : kitchens)
+        {
+            kitchen->displayMenu(sink);
+        }
+    }
+    {
+        AllocTracker::Phase phase("kitchenReport");
+        for (std::unique_ptr<Kitchen>& kitchen : kitchens)
+        {
+            kitchen->kitchenReport(sink);
+        }
+    }
+}
+
+static void appendPhases(MenuRenderer& out, long long size, long long rows, long long dishes, bool& first)
+{
+    for (const AllocationPhase& phase : ALLOCATION_PHASES)
+    {
+        long long ops = std::strcmp(phase.unit, "row") == 0 ? rows : dishes;
+        double count = static_cast<double>(ops > 0 ? ops : 1);
+        AllocTracker::Totals totals = AllocTracker::phaseTotals(phase.name);
+        out.append(first ? "" : ",\n");
+        first = false;
+        out.append("    {\"phase\": ").appendJsonString(phase.name);
+        out.append(", \"size\": ").appendInt(size);
+        out.append(", \"unit\": ").appendJsonString(phase.unit);
+        out.append(", \"ops\": ").appendInt(ops);
+        out.append(", \"allocs_per_op\": ").appendFixed(static_cast<double>(totals.allocations) / count, 3);
+        out.append(", \"bytes_per_op\": ").appendFixed(static_cast<double>(totals.bytes) / count, 1);
+        out.append(", \"frees_per_op\": ").appendFixed(static_cast<double>(totals.frees) / count, 3);
+        out.append('}');
+    }
+}
+
+static bool parseOptions(int argc, char* argv[], Options& options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        bool has_value = i + 1 < argc;
+        if (std::strcmp(argv[i], "--max-size") == 0 && has_value)
+        {
+            options.max_size = std::atoll(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--min-time-ms") == 0 && has_value)
+        {
+            options.min_time_ns = std::atof(argv[++i]) * 1e6;
+        }
+        else if (std::strcmp(argv[i], "--filter") == 0 && has_value)
+        {
+            options.filter = argv[++i];
+        }
+        else if (argv[i][0] != '-')
+        {
+            options.filename = argv[i];
+        }
+        else
+        {
+            std::cerr << "Usage: " << argv[0] << " [csv_file] [--max-size N] [--min-time-ms M] [--filter NAME]" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (!parseOptions(argc, argv, options))
+    {
+        return 1;
+    }
+
+    MenuRenderer out;
+    out.append("{\n  \"suite\": \"kitchen\",\n  \"results\": [\n");
+    bool first = true;
+    for (const Benchmark& benchmark : BENCHMARKS)
+    {
+        if (!options.filter.empty() && options.filter != benchmark.name)
+        {
+            continue;
+        }
+        for (long long size = 100; size <= options.max_size; size *= 10)
+        {
+            std::cerr << benchmark.name << " @ " << size << std::endl;
+            Measurement measurement = benchmark.run(options, size);
+            if (!first)
+            {
+                out.append(",\n");
+            }
+            first = false;
+            appendResult(out, benchmark, size, measurement);
+        }
+    }
+    out.append("\n  ],\n  \"allocation_phases\": [\n");
+    first = true;
+    for (long long size = 100; size <= options.max_size && options.filter.empty(); size *= 10)
+    {
+        std::cerr << "allocation phases @ " << size << std::endl;
+        long long rows = 0;
+        long long dishes = 0;
+        runAllocationPhases(options, size, rows, dishes);
+        appendPhases(out, size, rows, dishes, first);
+    }
+    out.append("\n  ]\n}\n");
+
+    StreamSink console(std::cout);
+    out.emit(console);
+    return 0;
+}
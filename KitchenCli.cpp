@@ -0,0 +1,651 @@
+/**
+ * @file KitchenCli.cpp
+ * @brief This file contains the implementation of the KitchenCli class, the command-line driver of `main`.
+ *
+ * @date October 17, 2026
+ * @author Kun Feng Wei
+ */
+
+#include "KitchenCli.hpp"
+#include "MenuRenderer.hpp"
+#include "OutputSink.hpp"
+#include "KitchenServer.hpp"
+#include "KitchenSimulator.hpp"
+#include "StationScheduler.hpp"
+#include "StatsDumper.hpp"
+#include "TraceReplay.hpp"
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+const KitchenCli::Command KitchenCli::COMMANDS[] = {
+    {"load", "load FILE", &KitchenCli::load},
+    {"menu", "menu [--offset N] [--limit N]", &KitchenCli::menu},
+    {"report", "report", &KitchenCli::report},
+    {"query", "query [--cuisine TYPE]", &KitchenCli::query},
+    {"adjust", "adjust [--vegetarian] [--vegan] [--gluten-free] [--nut-free] [--low-sodium] [--low-sugar] [--all]", &KitchenCli::adjust},
+    {"release", "release --below MINUTES | --cuisine TYPE", &KitchenCli::release},
+    {"export", "export [--format csv|json] [--output FILE]", &KitchenCli::exportMenu},
+    {"schedule", "schedule [--stations N] [--policy LPT|EDF] [--list]", &KitchenCli::schedule},
+    {"simulate", "simulate [--stations N|MIN-MAX] [--policy FIFO|SPT|LPT|EDF] [--rate ORDERS_PER_HOUR | --arrivals FILE] [--days D] [--sla MINUTES] [--seed S]", &KitchenCli::simulate},
+    {"replay", "replay TRACE [--rate OPS_PER_SEC] [--repeat N] [--show-reports]", &KitchenCli::replay},
+    {"journal", "journal FILE [--group N] [--group-ms MS] [--no-sync] [--snapshot-every N]", &KitchenCli::journal},
+    {"checkpoint", "checkpoint", &KitchenCli::checkpoint},
+    {"serve", "serve SOCKET [--exit-after N]", &KitchenCli::serve},
+};
+
+KitchenCli::Arguments::Arguments(const std::vector<std::string>& words, size_t begin) : words_(words), pos_(begin) {
+}
+
+bool KitchenCli::Arguments::takeFlag(const char* option) {
+    if (!done() && words_[pos_] == option) {
+        pos_++;
+        return true;
+    }
+    return false;
+}
+
+bool KitchenCli::Arguments::takeValue(const char* option, std::string& value) {
+    if (pos_ + 1 < words_.size() && words_[pos_] == option) {
+        value = words_[pos_ + 1];
+        pos_ += 2;
+        return true;
+    }
+    return false;
+}
+
+bool KitchenCli::Arguments::takePositional(std::string& value) {
+    if (!done() && words_[pos_].compare(0, 2, "--") != 0) {
+        value = words_[pos_++];
+        return true;
+    }
+    return false;
+}
+
+bool KitchenCli::Arguments::done() const {
+    return pos_ >= words_.size();
+}
+
+bool KitchenCli::Arguments::finished() const {
+    return done() || findCommand(words_[pos_]) != nullptr;
+}
+
+std::string KitchenCli::Arguments::next() const {
+    return done() ? std::string() : words_[pos_];
+}
+
+size_t KitchenCli::Arguments::position() const {
+    return pos_;
+}
+
+/**
+ * Default constructor.
+ * @post The kitchen is empty and timing is off.
+ */
+KitchenCli::KitchenCli() : kitchen_(new Kitchen()), log_(), time_(false) {
+}
+
+const KitchenCli::Command* KitchenCli::findCommand(const std::string& name) {
+    for (const Command& command : COMMANDS) {
+        if (name == command.name) {
+            return &command;
+        }
+    }
+    return nullptr;
+}
+
+int KitchenCli::printUsage(const char* program) const {
+    std::cerr << "Usage: " << program << " [--time] [--stats-every MS] [--stats-file FILE] COMMAND [OPTIONS] [COMMAND [OPTIONS]]...\n"
+              << "Commands run in order on one kitchen:\n";
+    for (const Command& command : COMMANDS) {
+        std::cerr << "  " << command.usage << '\n';
+    }
+    std::cerr.flush();
+    return 2;
+}
+
+// Parses a whole non-negative number, rejecting trailing characters
+static bool parseCount(const std::string& text, int& value) {
+    char* end = nullptr;
+    long parsed = std::strtol(text.c_str(), &end, 10);
+    if (text.empty() || *end != '\0' || parsed < 0 || parsed > 1000000000) {
+        return false;
+    }
+    value = static_cast<int>(parsed);
+    return true;
+}
+
+// The server stopped by SIGINT and SIGTERM while `serve` runs
+static KitchenServer* signal_server = nullptr;
+
+static void stopServer(int) {
+    if (signal_server != nullptr) {
+        signal_server->stop();
+    }
+}
+
+// Parses a positive real number, rejecting trailing characters
+static bool parsePositive(const std::string& text, double& value) {
+    char* end = nullptr;
+    value = std::strtod(text.c_str(), &end);
+    return !text.empty() && *end == '\0' && value > 0.0;
+}
+
+int KitchenCli::run(int argc, char* argv[]) {
+    std::vector<std::string> words(argv + 1, argv + argc);
+    size_t pos = 0;
+    int stats_every_ms = 0;
+    std::string stats_file = "kitchen_stats.txt";
+    while (pos < words.size() && words[pos].compare(0, 2, "--") == 0) {
+        bool has_value = pos + 1 < words.size();
+        if (words[pos] == "--time") {
+            time_ = true;
+        } else if (words[pos] == "--stats-every" && has_value && parseCount(words[pos + 1], stats_every_ms) && stats_every_ms > 0) {
+            pos++;
+        } else if (words[pos] == "--stats-file" && has_value) {
+            stats_file = words[++pos];
+        } else {
+            return printUsage(argv[0]);
+        }
+        pos++;
+    }
+    if (pos == words.size()) {
+        return printUsage(argv[0]);
+    }
+
+    // Appends a block to the stats file every interval and once more when run() returns
+    std::unique_ptr<StatsDumper> dumper;
+    if (stats_every_ms > 0) {
+        if (!KitchenStats::ENABLED) {
+            std::cerr << "--stats-every: the counters are compiled out, so every dump reads zero; build with make STATS=1" << std::endl;
+        }
+        dumper.reset(new StatsDumper(stats_file, stats_every_ms));
+    }
+
+    std::chrono::steady_clock::duration total = std::chrono::steady_clock::duration::zero();
+    while (pos < words.size()) {
+        const Command* command = findCommand(words[pos]);
+        if (command == nullptr) {
+            std::cerr << "Unknown command: " << words[pos] << std::endl;
+            return printUsage(argv[0]);
+        }
+        Arguments arguments(words, pos + 1);
+        long long items = 0;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        int status = (this->*(command->run))(arguments, items);
+        std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - start;
+        std::cout.flush();
+        if (status == 2) {
+            if (!arguments.finished()) {
+                std::cerr << command->name << ": unexpected argument " << arguments.next() << std::endl;
+            }
+            std::cerr << "Usage: " << command->usage << std::endl;
+            return status;
+        }
+        if (status != 0) {
+            return status;
+        }
+        if (log_ != nullptr && !log_->commitIfDue()) {
+            std::cerr << "journal: " << log_->error() << std::endl;
+            return 1;
+        }
+        total += elapsed;
+
+        if (time_) {
+            double ms = std::chrono::duration<double, std::milli>(elapsed).count();
+            MenuRenderer line;
+            line.append("time: ").append(command->name).append(' ').appendFixed(ms, 3).append(" ms, ");
+            line.appendInt(items).append(" dishes, ").appendFixed(ms > 0 ? items / ms * 1000.0 : 0.0, 0).append(" dishes/s\n");
+            StreamSink err(std::cerr);
+            line.emit(err);
+        }
+        pos = arguments.position();
+    }
+    if (time_) {
+        MenuRenderer line;
+        line.append("time: total ").appendFixed(std::chrono::duration<double, std::milli>(total).count(), 3).append(" ms\n");
+        if (KitchenStats::ENABLED) {
+            Kitchen::stats().snapshot().writeText(line);
+        }
+        StreamSink err(std::cerr);
+        line.emit(err);
+    }
+    return 0;
+}
+
+int KitchenCli::load(Arguments& arguments, long long& items) {
+    std::string filename;
+    if (!arguments.takePositional(filename) || !arguments.finished()) {
+        return 2;
+    }
+    if (!std::ifstream(filename).is_open()) {
+        std::cerr << "Failed to open file: " << filename << std::endl;
+        return 1;
+    }
+    Kitchen::LoadResult result;
+    kitchen_.reset(new Kitchen(filename, result));
+    items = result.rows; // --time measures parsing, whether or not the kitchen kept the dish
+    if (result.malformed > 0) {
+        std::cerr << filename << ": " << result.first_error << " (" << result.malformed << " malformed rows)" << std::endl;
+        kitchen_.reset(new Kitchen());
+        return 1;
+    }
+    if (result.added != result.rows) {
+        std::cerr << "load: " << filename << ": " << result.rows << " rows read, " << result.added << " dishes kept";
+        if (result.full > 0) {
+            std::cerr << ", " << result.full << " dropped because the kitchen is full (capacity " << Kitchen::getCapacity() << ")";
+        }
+        if (result.unknown_type > 0) {
+            std::cerr << ", " << result.unknown_type << " of an unknown dish type";
+        }
+        std::cerr << std::endl;
+    }
+    if (log_ != nullptr) {
+        log_->follow(*kitchen_); // the loaded dishes are the journal's new snapshot
+    }
+    return 0;
+}
+
+int KitchenCli::menu(Arguments& arguments, long long& items) {
+    std::string offset_text, limit_text;
+    int offset = 0;
+    int limit = kitchen_->getCurrentSize();
+    while (arguments.takeValue("--offset", offset_text) || arguments.takeValue("--limit", limit_text)) {
+    }
+    if (!arguments.finished() || (!offset_text.empty() && !parseCount(offset_text, offset)) ||
+        (!limit_text.empty() && !parseCount(limit_text, limit))) {
+        return 2;
+    }
+    StreamSink out(std::cout);
+    items = kitchen_->displayMenu(out, offset, limit);
+    return 0;
+}
+
+int KitchenCli::report(Arguments& arguments, long long& items) {
+    if (!arguments.finished()) {
+        return 2;
+    }
+    StreamSink out(std::cout);
+    kitchen_->kitchenReport(out);
+    items = kitchen_->getCurrentSize();
+    return 0;
+}
+
+int KitchenCli::query(Arguments& arguments, long long& items) {
+    std::string cuisine_type;
+    MenuRenderer out;
+    items = kitchen_->getCurrentSize();
+    bool by_cuisine = arguments.takeValue("--cuisine", cuisine_type);
+    if (!arguments.finished()) {
+        return 2;
+    }
+    if (by_cuisine) {
+        Dish::CuisineType cuisine;
+        if (!tryEnumFromToken(Dish::CUISINE_TYPE_INFO, cuisine_type, cuisine)) {
+            std::cerr << "Unknown cuisine type: " << cuisine_type << std::endl;
+            return 1;
+        }
+        out.append(cuisine_type).append(": ").appendInt(kitchen_->tallyCuisineTypes(cuisine_type));
+        out.append(" dishes, price sum $").appendPrice(kitchen_->getPriceCentsSum(cuisine_type)).append('\n');
+    } else {
+        out.append("DISHES: ").appendInt(kitchen_->getCurrentSize()).append('\n');
+        out.append("PREP TIME SUM: ").appendInt(kitchen_->getPrepTimeSum()).append('\n');
+        out.append("AVERAGE PREP TIME: ").appendInt(kitchen_->calculateAvgPrepTime()).append('\n');
+        out.append("ELABORATE DISHES: ").appendInt(kitchen_->elaborateDishCount());
+        out.append(" (").appendFixed(kitchen_->calculateElaboratePercentage(), 2).append("%)\n");
+        out.append("PRICE SUM: $").appendPrice(kitchen_->getPriceCentsSum()).append('\n');
+        out.append("AVERAGE PRICE: $").appendPrice(kitchen_->calculateAvgPriceCents()).append('\n');
+    }
+    StreamSink sink(std::cout);
+    out.emit(sink);
+    return 0;
+}
+
+int KitchenCli::adjust(Arguments& arguments, long long& items) {
+    Dish::DietaryRequest request = {false, false, false, false, false, false};
+    bool any = false;
+    while (true) {
+        if (arguments.takeFlag("--vegetarian")) {
+            request.vegetarian = true;
+        } else if (arguments.takeFlag("--vegan")) {
+            request.vegan = true;
+        } else if (arguments.takeFlag("--gluten-free")) {
+            request.gluten_free = true;
+        } else if (arguments.takeFlag("--nut-free")) {
+            request.nut_free = true;
+        } else if (arguments.takeFlag("--low-sodium")) {
+            request.low_sodium = true;
+        } else if (arguments.takeFlag("--low-sugar")) {
+            request.low_sugar = true;
+        } else if (arguments.takeFlag("--all")) {
+            request = {true, true, true, true, true, true};
+        } else {
+            break;
+        }
+        any = true;
+    }
+    if (!any || !arguments.finished()) {
+        return 2;
+    }
+    kitchen_->dietaryAdjustment(request);
+    items = kitchen_->getCurrentSize();
+    return 0;
+}
+
+int KitchenCli::release(Arguments& arguments, long long& items) {
+    std::string below, cuisine_type;
+    bool by_prep_time = arguments.takeValue("--below", below);
+    bool by_cuisine = !by_prep_time && arguments.takeValue("--cuisine", cuisine_type);
+    int prep_time = 0;
+    if (!arguments.finished() || (!by_prep_time && !by_cuisine) || (by_prep_time && !parseCount(below, prep_time))) {
+        return 2;
+    }
+    Dish::CuisineType cuisine;
+    if (by_cuisine && !tryEnumFromToken(Dish::CUISINE_TYPE_INFO, cuisine_type, cuisine)) {
+        std::cerr << "Unknown cuisine type: " << cuisine_type << std::endl;
+        return 1;
+    }
+    items = kitchen_->getCurrentSize();
+    std::vector<Dish*> dishes;
+    int released = by_prep_time ? kitchen_->releaseDishesBelowPrepTime(prep_time, dishes) : kitchen_->releaseDishesOfCuisineType(cuisine_type, dishes);
+    for (Dish* dish : dishes) {
+        delete dish; // released, so the kitchen no longer owns it
+    }
+    std::cout << "Released " << released << " dishes" << std::endl;
+    return 0;
+}
+
+int KitchenCli::exportMenu(Arguments& arguments, long long& items) {
+    std::string format = "csv";
+    std::string filename;
+    while (arguments.takeValue("--format", format) || arguments.takeValue("--output", filename)) {
+    }
+    if (!arguments.finished() || (format != "csv" && format != "json")) {
+        return 2;
+    }
+    items = kitchen_->getCurrentSize();
+
+    std::ofstream output_file;
+    if (!filename.empty()) {
+        output_file.open(filename);
+        if (!output_file.is_open()) {
+            std::cerr << "Failed to open file: " << filename << std::endl;
+            return 1;
+        }
+    }
+    StreamSink out(filename.empty() ? std::cout : output_file);
+    if (format == "csv") {
+        kitchen_->exportCsv(out);
+    } else {
+        kitchen_->exportJson(out);
+    }
+    out.flush();
+    if (!filename.empty() && !output_file.good()) {
+        std::cerr << "Failed to write file: " << filename << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+int KitchenCli::schedule(Arguments& arguments, long long& items) {
+    std::string stations_text, policy_text = "LPT";
+    bool list_dishes = false;
+    while (true) {
+        if (arguments.takeFlag("--list")) {
+            list_dishes = true;
+        } else if (!arguments.takeValue("--stations", stations_text) && !arguments.takeValue("--policy", policy_text)) {
+            break;
+        }
+    }
+    int stations = 4;
+    StationScheduler::Policy policy;
+    if (!arguments.finished() || (!stations_text.empty() && (!parseCount(stations_text, stations) || stations == 0)) ||
+        !tryEnumFromToken(StationScheduler::POLICY_INFO, policy_text, policy)) {
+        return 2;
+    }
+    StationScheduler scheduler(*kitchen_, stations, policy);
+    MenuRenderer out;
+    scheduler.writeText(out, list_dishes);
+    StreamSink sink(std::cout);
+    out.emit(sink);
+    items = scheduler.size();
+    return 0;
+}
+
+// Parses a station count "N" or range "MIN-MAX", each at least 1
+static bool parseStationRange(const std::string& text, int& min_stations, int& max_stations) {
+    size_t dash = text.find('-');
+    if (dash == std::string::npos) {
+        return parseCount(text, min_stations) && parseCount(text, max_stations) && min_stations > 0;
+    }
+    return parseCount(text.substr(0, dash), min_stations) && parseCount(text.substr(dash + 1), max_stations) &&
+           min_stations > 0 && max_stations >= min_stations;
+}
+
+int KitchenCli::simulate(Arguments& arguments, long long& items) {
+    std::string stations_text, policy_text = "FIFO", rate_text, arrivals_file, days_text, sla_text, seed_text;
+    while (arguments.takeValue("--stations", stations_text) || arguments.takeValue("--policy", policy_text) ||
+           arguments.takeValue("--rate", rate_text) || arguments.takeValue("--arrivals", arrivals_file) ||
+           arguments.takeValue("--days", days_text) || arguments.takeValue("--sla", sla_text) ||
+           arguments.takeValue("--seed", seed_text)) {
+    }
+    // A trace runs to its last order unless --days cuts it short
+    KitchenSimulator::Config config = {4, KitchenSimulator::FIFO, arrivals_file.empty() ? 7.0 : 0.0, 6.0, 15.0, 1};
+    int min_stations = 4, max_stations = 4, sla = 15, seed = 1;
+    if (!arguments.finished() || !tryEnumFromToken(KitchenSimulator::POLICY_INFO, policy_text, config.policy) ||
+        (!stations_text.empty() && !parseStationRange(stations_text, min_stations, max_stations)) ||
+        (!rate_text.empty() && (!arrivals_file.empty() || !parsePositive(rate_text, config.rate_per_hour))) ||
+        (!days_text.empty() && !parsePositive(days_text, config.days)) || (!sla_text.empty() && !parseCount(sla_text, sla)) ||
+        (!seed_text.empty() && !parseCount(seed_text, seed))) {
+        return 2;
+    }
+    config.sla_minutes = sla;
+    config.seed = static_cast<uint64_t>(seed);
+
+    KitchenSimulator simulator(*kitchen_);
+    if (simulator.menuSize() == 0) {
+        std::cerr << "simulate: the kitchen has no dishes; load a menu first" << std::endl;
+        return 1;
+    }
+    if (!arrivals_file.empty()) {
+        std::ifstream input_file(arrivals_file);
+        if (!input_file.is_open()) {
+            std::cerr << "Failed to open file: " << arrivals_file << std::endl;
+            return 1;
+        }
+        std::string error;
+        if (!simulator.loadArrivals(input_file, error)) {
+            std::cerr << arrivals_file << ": " << error << std::endl;
+            return 1;
+        }
+    }
+
+    MenuRenderer out;
+    out.append("simulate: ").append(KitchenSimulator::POLICY_INFO[config.policy].token).append(", ").appendInt(static_cast<long long>(simulator.menuSize()));
+    out.append(" dishes on the menu, ");
+    if (simulator.hasTrace()) {
+        out.append("arrivals from ").append(arrivals_file);
+    } else {
+        out.appendFixed(config.rate_per_hour, 1).append(" orders/h");
+    }
+    out.append(", SLA ").appendFixed(config.sla_minutes, 0).append(" min\n");
+    std::unique_ptr<KitchenSimulator::Result> result(new KitchenSimulator::Result()); // the histograms are too big for the stack
+    for (int stations = min_stations; stations <= max_stations; stations++) {
+        config.stations = stations;
+        simulator.run(config, *result);
+        result->writeText(out, config);
+        items += result->orders;
+    }
+    StreamSink sink(std::cout);
+    out.emit(sink);
+    return 0;
+}
+
+int KitchenCli::replay(Arguments& arguments, long long& items) {
+    std::string filename, rate_text, repeat_text;
+    if (!arguments.takePositional(filename)) {
+        return 2;
+    }
+    bool show_reports = false;
+    while (true) {
+        if (arguments.takeFlag("--show-reports")) {
+            show_reports = true;
+        } else if (!arguments.takeValue("--rate", rate_text) && !arguments.takeValue("--repeat", repeat_text)) {
+            break;
+        }
+    }
+    TraceReplay::Options options = {0.0, 1};
+    char* end = nullptr;
+    if (!rate_text.empty()) {
+        options.rate = std::strtod(rate_text.c_str(), &end);
+    }
+    if (!arguments.finished() || (!rate_text.empty() && (*end != '\0' || !(options.rate > 0.0))) ||
+        (!repeat_text.empty() && (!parseCount(repeat_text, options.repeat) || options.repeat == 0))) {
+        return 2;
+    }
+
+    std::ifstream input_file(filename);
+    if (!input_file.is_open()) {
+        std::cerr << "Failed to open file: " << filename << std::endl;
+        return 1;
+    }
+    TraceReplay trace;
+    std::string error;
+    if (!trace.load(input_file, error)) {
+        std::cerr << filename << ": " << error << std::endl;
+        return 1;
+    }
+
+    StreamSink out(std::cout);
+    NullSink discard;
+    std::unique_ptr<TraceReplay::Result> result(new TraceReplay::Result()); // the histograms are too big for the stack
+    trace.run(*kitchen_, options, show_reports ? static_cast<OutputSink&>(out) : discard, *result);
+    MenuRenderer text;
+    result->writeText(text, options);
+    text.emit(out);
+    items = result->ops;
+    return 0;
+}
+
+int KitchenCli::journal(Arguments& arguments, long long& items) {
+    std::string filename, group_text, group_ms_text, snapshot_text;
+    if (!arguments.takePositional(filename)) {
+        return 2;
+    }
+    OrderLog::Options options = {64, 5.0, true, 0};
+    while (true) {
+        if (arguments.takeFlag("--no-sync")) {
+            options.sync = false;
+        } else if (!arguments.takeValue("--group", group_text) && !arguments.takeValue("--group-ms", group_ms_text) &&
+                   !arguments.takeValue("--snapshot-every", snapshot_text)) {
+            break;
+        }
+    }
+    int group_ms = 5, snapshot_every = 0;
+    if (!arguments.finished() || (!group_text.empty() && (!parseCount(group_text, options.group_records) || options.group_records == 0)) ||
+        (!group_ms_text.empty() && !parseCount(group_ms_text, group_ms)) || (!snapshot_text.empty() && !parseCount(snapshot_text, snapshot_every))) {
+        return 2;
+    }
+    options.group_ms = group_ms;
+    options.snapshot_records = snapshot_every;
+    if (log_ != nullptr) {
+        std::cerr << "journal: a journal is already open" << std::endl;
+        return 1;
+    }
+
+    // Recovering rebuilds the kitchen from scratch; a new journal starts from the current one
+    std::unique_ptr<OrderLog> log(new OrderLog(filename, options));
+    std::unique_ptr<Kitchen> recovered;
+    if (OrderLog::exists(filename)) {
+        recovered.reset(new Kitchen());
+    }
+    OrderLog::Recovery recovery;
+    std::string error;
+    if (!log->open(recovered != nullptr ? *recovered : *kitchen_, recovery, error)) {
+        std::cerr << "journal: " << error << std::endl;
+        return 1;
+    }
+    if (recovered != nullptr) {
+        kitchen_ = std::move(recovered);
+    }
+    log_ = std::move(log);
+
+    MenuRenderer out;
+    recovery.writeText(out);
+    StreamSink sink(std::cout);
+    out.emit(sink);
+    items = recovery.snapshot_dishes;
+    for (int type = 0; type < OrderLog::RECORD_TYPE_COUNT; type++) {
+        items += recovery.records[type];
+    }
+    return 0;
+}
+
+int KitchenCli::checkpoint(Arguments& arguments, long long& items) {
+    if (!arguments.finished()) {
+        return 2;
+    }
+    if (log_ == nullptr) {
+        std::cerr << "checkpoint: no journal is open" << std::endl;
+        return 1;
+    }
+    if (!log_->snapshot()) {
+        return 1; // run() prints the journal's error
+    }
+    const OrderLog::Counters& counters = log_->counters();
+    MenuRenderer out;
+    out.append("checkpoint: generation ").appendInt(static_cast<long long>(log_->generation())).append(", ");
+    out.appendInt(kitchen_->getCurrentSize()).append(" dishes; ").appendInt(counters.records).append(" records in ");
+    out.appendInt(counters.commits).append(" commits, ").appendInt(counters.syncs).append(" syncs, ");
+    out.appendInt(counters.snapshots).append(" snapshots\n");
+    StreamSink sink(std::cout);
+    out.emit(sink);
+    items = kitchen_->getCurrentSize();
+    return 0;
+}
+
+int KitchenCli::serve(Arguments& arguments, long long& items) {
+    std::string path, exit_after_text;
+    if (!arguments.takePositional(path)) {
+        return 2;
+    }
+    arguments.takeValue("--exit-after", exit_after_text);
+    int exit_after = 0;
+    if (!arguments.finished() || (!exit_after_text.empty() && !parseCount(exit_after_text, exit_after))) {
+        return 2;
+    }
+    KitchenServer server(*kitchen_, path);
+    server.setLog(log_.get());
+    std::string error;
+    if (!server.start(error)) {
+        std::cerr << "serve: " << error << std::endl;
+        return 1;
+    }
+    std::cerr << "serve: listening on " << path << std::endl;
+    signal_server = &server;
+    std::signal(SIGINT, stopServer);
+    std::signal(SIGTERM, stopServer);
+    bool stopped = server.run(exit_after, error);
+    std::signal(SIGINT, SIG_DFL);
+    std::signal(SIGTERM, SIG_DFL);
+    signal_server = nullptr;
+    if (!stopped) {
+        std::cerr << "serve: " << error << std::endl;
+        return 1;
+    }
+
+    const KitchenServer::Counters& counters = server.counters();
+    MenuRenderer out;
+    counters.writeText(out);
+    StreamSink sink(std::cout);
+    out.emit(sink);
+    items = 0;
+    for (int opcode = 0; opcode < KitchenServer::OPCODE_COUNT; opcode++) {
+        items += counters.requests[opcode];
+    }
+    return 0;
+}
@@ -0,0 +1,166 @@
+/**
+ * @file KitchenCli.hpp
+ * @brief This file contains the declaration of the KitchenCli class, the command-line driver of `main`.
+ *
+ * The commands run in order on one kitchen, so a single invocation can load a menu, change it and report on it:
+ *
+ *   ./main load Dishes.csv adjust --vegan --nut-free release --below 30 report
+ *   ./main --time load big_Dishes.csv query --cuisine ITALIAN export --format json --output menu.json
+ *   ./main load Dishes.csv replay orders.trace --rate 2000 --repeat 10
+ *   ./main --stats-every 1000 load Dishes.csv replay orders.trace --repeat 1000     (built with make STATS=1)
+ *   ./main journal kitchen.log release --below 30     (later: ./main journal kitchen.log report)
+ *   ./main load Dishes.csv serve /tmp/kitchen.sock report
+ *
+ * Commands:
+ *   load FILE                          replace the kitchen with the dishes of a CSV file; warns on stderr when
+ *                                      rows are dropped (kitchen full, unknown dish type) and fails on a
+ *                                      malformed row
+ *   menu [--offset N] [--limit N]      print the menu, or one page of it
+ *   report                             print the kitchen report
+ *   query [--cuisine TYPE]             print the aggregates, or the tally and price sum of one cuisine type
+ *   adjust [--vegetarian] [--vegan] [--gluten-free] [--nut-free] [--low-sodium] [--low-sugar] [--all]
+ *                                      apply a dietary request to every dish
+ *   release --below MINUTES | --cuisine TYPE
+ *                                      remove dishes and print how many were removed
+ *   export [--format csv|json] [--output FILE]
+ *                                      write the kitchen as CSV (the Dishes.csv schema) or JSON
+ *   schedule [--stations N] [--policy LPT|EDF] [--list]
+ *                                      assign the dishes to N cook stations (default 4, LPT; see StationScheduler.hpp)
+ *                                      and print the makespan and station loads, or every dish's slot with --list
+ *   simulate [--stations N|MIN-MAX] [--policy FIFO|SPT|LPT|EDF] [--rate ORDERS_PER_HOUR | --arrivals FILE]
+ *            [--days D] [--sla MINUTES] [--seed S]
+ *                                      simulate orders for the menu on N stations (default 4 stations, FIFO, 6
+ *                                      orders/h for 7 days, 15 min SLA; see KitchenSimulator.hpp) and print the
+ *                                      throughput, queue depth and wait percentiles for each station count
+ *   replay TRACE [--rate OPS_PER_SEC] [--repeat N] [--show-reports]
+ *                                      replay a trace of order traffic (see TraceReplay.hpp) flat out or at a fixed
+ *                                      rate, then print the ops/s and the latency percentiles of each operation type
+ *   journal FILE [--group N] [--group-ms MS] [--no-sync] [--snapshot-every N]
+ *                                      rebuild the kitchen from a journal (see OrderLog.hpp), or start one with the
+ *                                      current dishes; every later change is logged, and a later load starts over
+ *                                      from the loaded dishes (default groups of 64 records or 5 ms)
+ *   checkpoint                         snapshot the kitchen into the journal and empty its log
+ *   serve SOCKET [--exit-after N]      serve the kitchen to local clients on a Unix-domain socket (see
+ *                                      KitchenServer.hpp) until SIGINT or SIGTERM, or until N connections have
+ *                                      closed, then print the request counts
+ *
+ * With --time (anywhere before the first command) the wall time and throughput of every command, and the total,
+ * are printed to stderr, so stdout keeps only the command output. A build with `make STATS=1` then also prints
+ * the Kitchen::stats() counters of the whole run, one line per operation.
+ *
+ * With --stats-every MS a StatsDumper appends the counters and latency percentiles to --stats-file (default
+ * kitchen_stats.txt) every MS milliseconds while the commands run, and once more at the end. They only count in a
+ * `make STATS=1` build.
+ *
+ * @date October 17, 2026
+ * @author Kun Feng Wei
+ */
+
+#ifndef KITCHEN_CLI_HPP
+#define KITCHEN_CLI_HPP
+
+#include "Kitchen.hpp"
+#include "OrderLog.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+
+class KitchenCli {
+public:
+    /**
+     * Default constructor.
+     * @post The kitchen is empty and timing is off.
+     */
+    KitchenCli();
+
+    /**
+     * Runs the commands given on the command line.
+     * @param argc The argument count of main().
+     * @param argv The arguments of main(); argv[0] is the program name.
+     * @return The exit status: 0 on success, 1 when a command failed, 2 on a usage error.
+     */
+    int run(int argc, char* argv[]);
+
+    /**
+     * The command-line words after a command name, consumed from the front by that command.
+     * A command stops at the first word it does not take, which must be the next command name.
+     */
+    class Arguments {
+    public:
+        Arguments(const std::vector<std::string>& words, size_t begin);
+
+        /**
+         * @return True if the next argument is `option`; it is then consumed.
+         */
+        bool takeFlag(const char* option);
+
+        /**
+         * @return True if the next argument is `option` followed by a value; both are then consumed.
+         */
+        bool takeValue(const char* option, std::string& value);
+
+        /**
+         * @return True if the next argument is a value (not an option); it is then consumed.
+         */
+        bool takePositional(std::string& value);
+
+        /**
+         * @return True if every argument has been consumed.
+         */
+        bool done() const;
+
+        /**
+         * @return True if the command has taken all of its arguments, i.e. none are left or the next one is a command name.
+         */
+        bool finished() const;
+
+        /**
+         * @return The next argument, or an empty string when done.
+         */
+        std::string next() const;
+
+        /**
+         * @return The index of the next argument in the words.
+         */
+        size_t position() const;
+
+    private:
+        const std::vector<std::string>& words_;
+        size_t pos_;
+    };
+
+private:
+    // One subcommand; `run` returns 0, 1 (command failed) or 2 (usage error) and sets `items` for --time
+    struct Command
+    {
+        const char* name;
+        const char* usage;
+        int (KitchenCli::*run)(Arguments& arguments, long long& items);
+    };
+
+    static const Command COMMANDS[];
+
+    static const Command* findCommand(const std::string& name);
+
+    int printUsage(const char* program) const;
+
+    int load(Arguments& arguments, long long& items);
+    int menu(Arguments& arguments, long long& items);
+    int report(Arguments& arguments, long long& items);
+    int query(Arguments& arguments, long long& items);
+    int adjust(Arguments& arguments, long long& items);
+    int release(Arguments& arguments, long long& items);
+    int exportMenu(Arguments& arguments, long long& items);
+    int schedule(Arguments& arguments, long long& items);
+    int simulate(Arguments& arguments, long long& items);
+    int replay(Arguments& arguments, long long& items);
+    int journal(Arguments& arguments, long long& items);
+    int checkpoint(Arguments& arguments, long long& items);
+    int serve(Arguments& arguments, long long& items);
+
+    std::unique_ptr<Kitchen> kitchen_;
+    std::unique_ptr<OrderLog> log_;  // the journal following kitchen_, if one was opened
+    bool time_;
+};
+
+#endif // KITCHEN_CLI_HPP
@@ -0,0 +1,434 @@
+/**
+ * @file KitchenServer.cpp
+ * @brief This file contains the implementation of the KitchenServer class, a Unix-domain socket service that exposes one Kitchen to local processes.
+ *
+ * @date October 17, 2026
+ * @author Kun Feng Wei
+ */
+
+#include "KitchenServer.hpp"
+#include "OrderLog.hpp"
+#include "WireFormat.hpp"
+#include <cerrno>
+#include <cstring>
+#include <exception>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+// Most bytes read from one connection per wake-up, so one busy client cannot starve the others
+const size_t READ_LIMIT = 256 * 1024;
+
+// Pending responses at which a connection stops handling requests until they are written
+const size_t OUTPUT_LIMIT = 1024 * 1024;
+
+const int MAX_EVENTS = 64;
+
+}
+
+void KitchenServer::QueryResult::appendTo(std::string& out) const {
+    appendU32(out, dishes);
+    appendU32(out, prep_time_sum);
+    appendU32(out, average_prep_time);
+    appendU32(out, elaborate_dishes);
+    appendU64(out, static_cast<uint64_t>(price_cents_sum));
+    appendU64(out, static_cast<uint64_t>(average_price_cents));
+}
+
+bool KitchenServer::QueryResult::readFrom(const char* body, size_t size) {
+    if (size != SIZE) {
+        return false;
+    }
+    dishes = getU32(body);
+    prep_time_sum = getU32(body + 4);
+    average_prep_time = getU32(body + 8);
+    elaborate_dishes = getU32(body + 12);
+    price_cents_sum = static_cast<int64_t>(getU64(body + 16));
+    average_price_cents = static_cast<int64_t>(getU64(body + 24));
+    return true;
+}
+
+void KitchenServer::Counters::writeText(MenuRenderer& out) const {
+    long long total = 0;
+    for (int opcode = 0; opcode < OPCODE_COUNT; opcode++) {
+        total += requests[opcode];
+    }
+    out.append("serve: ").appendInt(connections).append(" connections, ").appendInt(total).append(" requests (");
+    for (int opcode = 0; opcode < OPCODE_COUNT; opcode++) {
+        out.append(opcode == 0 ? "" : " ").append(OPCODE_INFO[opcode].token).append('=').appendInt(requests[opcode]);
+    }
+    out.append("), responses (");
+    for (int status = 0; status < STATUS_COUNT; status++) {
+        out.append(status == 0 ? "" : " ").append(STATUS_INFO[status].token).append('=').appendInt(responses[status]);
+    }
+    out.append(") in ").appendInt(reads).append(" reads and ").appendInt(writes).append(" writes, ");
+    out.appendFixed(reads > 0 ? static_cast<double>(total) / reads : 0.0, 1).append(" requests per read, ");
+    out.appendFixed(order_batches > 0 ? static_cast<double>(requests[NEW_ORDER]) / order_batches : 0.0, 1).append(" orders per batch");
+    if (protocol_errors > 0) {
+        out.append(", ").appendInt(protocol_errors).append(" protocol errors");
+    }
+    out.append('\n');
+}
+
+void KitchenServer::appendFrame(std::string& out, int code, uint32_t id, const char* body, size_t size) {
+    appendU32(out, static_cast<uint32_t>(size + FRAME_HEADER_SIZE - 4));
+    out.push_back(static_cast<char>(code));
+    appendU32(out, id);
+    if (size > 0) {
+        out.append(body, size);
+    }
+}
+
+long KitchenServer::parseFrame(const char* data, size_t size, Frame& frame) {
+    if (size < 4) {
+        return 0;
+    }
+    uint32_t length = getU32(data);
+    if (length < FRAME_HEADER_SIZE - 4 || length > MAX_FRAME_LENGTH) {
+        return -1;
+    }
+    if (size < length + 4) {
+        return 0;
+    }
+    frame.code = static_cast<unsigned char>(data[4]);
+    frame.id = getU32(data + 5);
+    frame.body = data + FRAME_HEADER_SIZE;
+    frame.size = length + 4 - FRAME_HEADER_SIZE;
+    return static_cast<long>(length) + 4;
+}
+
+KitchenServer::KitchenServer(Kitchen& kitchen, const std::string& socket_path)
+    : kitchen_(kitchen), log_(nullptr), path_(socket_path), listen_fd_(-1), epoll_fd_(-1), stop_fd_(-1), closed_(0), counters_() {
+}
+
+KitchenServer::~KitchenServer() {
+    for (auto& entry : connections_) {
+        ::close(entry.first);
+    }
+    if (listen_fd_ >= 0) {
+        ::close(listen_fd_);
+        ::unlink(path_.c_str());
+    }
+    if (epoll_fd_ >= 0) {
+        ::close(epoll_fd_);
+    }
+    if (stop_fd_ >= 0) {
+        ::close(stop_fd_);
+    }
+}
+
+void KitchenServer::setLog(OrderLog* log) {
+    log_ = log;
+}
+
+bool KitchenServer::start(std::string& error) {
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path_.empty() || path_.size() >= sizeof(address.sun_path)) {
+        error = path_ + ": a socket path must have 1 to " + std::to_string(sizeof(address.sun_path) - 1) + " characters";
+        return false;
+    }
+    std::memcpy(address.sun_path, path_.c_str(), path_.size());
+
+    // A socket file left by a server that did not exit cleanly is replaced; anything else at the path is kept
+    struct stat existing;
+    if (::lstat(path_.c_str(), &existing) == 0) {
+        if (!S_ISSOCK(existing.st_mode)) {
+            error = path_ + ": exists and is not a socket";
+            return false;
+        }
+        ::unlink(path_.c_str());
+    }
+
+    listen_fd_ = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listen_fd_ < 0 || ::bind(listen_fd_, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+        error = path_ + ": " + std::strerror(errno);
+        if (listen_fd_ >= 0) {
+            ::close(listen_fd_);
+            listen_fd_ = -1;
+        }
+        return false;
+    }
+    epoll_fd_ = ::epoll_create1(EPOLL_CLOEXEC);
+    stop_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    epoll_event listen_event = {};
+    listen_event.events = EPOLLIN;
+    listen_event.data.fd = listen_fd_;
+    epoll_event stop_event = {};
+    stop_event.events = EPOLLIN;
+    stop_event.data.fd = stop_fd_;
+    if (::listen(listen_fd_, SOMAXCONN) != 0 || epoll_fd_ < 0 || stop_fd_ < 0 ||
+        ::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, listen_fd_, &listen_event) != 0 ||
+        ::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, stop_fd_, &stop_event) != 0) {
+        error = path_ + ": " + std::strerror(errno);
+        return false;
+    }
+    return true;
+}
+
+bool KitchenServer::run(long long exit_after, std::string& error) {
+    epoll_event events[MAX_EVENTS];
+    while (exit_after == 0 || closed_ < exit_after) {
+        // Wake up when the journal's pending group is due, so an idle server still syncs it
+        int ready = ::epoll_wait(epoll_fd_, events, MAX_EVENTS, log_ != nullptr ? log_->commitTimeoutMs() : -1);
+        if (ready < 0 && errno != EINTR) {
+            error = std::string("epoll_wait: ") + std::strerror(errno);
+            return false;
+        }
+        if (log_ != nullptr && !log_->commitIfDue()) {
+            error = "journal: " + log_->error();
+            return false;
+        }
+        for (int i = 0; i < ready; i++) {
+            int fd = events[i].data.fd;
+            if (fd == stop_fd_) {
+                uint64_t value;
+                while (::read(stop_fd_, &value, sizeof(value)) > 0) {
+                }
+                return true;
+            }
+            if (fd == listen_fd_) {
+                acceptConnections();
+                continue;
+            }
+            auto found = connections_.find(fd);
+            if (found == connections_.end()) {
+                continue; // closed earlier in this batch of events
+            }
+            Connection& connection = *found->second;
+            bool open = true;
+            if (connection.writing) {
+                // Written out: handle what was left unread in the input before reading more
+                open = (events[i].events & (EPOLLOUT | EPOLLERR | EPOLLHUP)) == EPOLLOUT && flush(connection) &&
+                       (connection.writing || (watch(connection, false) && serve(connection)));
+            } else if (events[i].events & (EPOLLIN | EPOLLERR | EPOLLHUP)) {
+                open = receive(connection);
+            }
+            if (!open) {
+                closeConnection(fd);
+            }
+        }
+    }
+    return true;
+}
+
+void KitchenServer::stop() {
+    if (stop_fd_ >= 0) {
+        uint64_t one = 1;
+        ssize_t written = ::write(stop_fd_, &one, sizeof(one));
+        (void)written; // a full counter already wakes the loop
+    }
+}
+
+const KitchenServer::Counters& KitchenServer::counters() const {
+    return counters_;
+}
+
+void KitchenServer::acceptConnections() {
+    while (true) {
+        int fd = ::accept4(listen_fd_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            return; // EAGAIN once the backlog is empty; a failed accept is the client's problem
+        }
+        std::unique_ptr<Connection> connection(new Connection{fd, std::string(), std::string(), 0, false});
+        epoll_event event = {};
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        if (::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) != 0) {
+            ::close(fd);
+            continue;
+        }
+        connections_.emplace(fd, std::move(connection));
+        counters_.connections++;
+    }
+}
+
+bool KitchenServer::receive(Connection& connection) {
+    char buffer[64 * 1024];
+    size_t received = 0;
+    bool end = false;
+    while (received < READ_LIMIT) {
+        ssize_t count = ::read(connection.fd, buffer, sizeof(buffer));
+        if (count > 0) {
+            connection.input.append(buffer, static_cast<size_t>(count));
+            received += static_cast<size_t>(count);
+        } else if (count == 0) {
+            end = true;
+            break;
+        } else if (errno == EINTR) {
+            continue;
+        } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            break;
+        } else {
+            return false;
+        }
+    }
+    if (received > 0) {
+        counters_.reads++;
+    }
+    // A client that shut down its side still gets the responses that fit in the socket
+    return serve(connection) && !end;
+}
+
+bool KitchenServer::serve(Connection& connection) {
+    bool more = true;
+    while (more && !connection.writing) {
+        if (!handleFrames(connection, more) || !flush(connection)) {
+            return false;
+        }
+    }
+    return connection.writing ? watch(connection, true) : true;
+}
+
+bool KitchenServer::handleFrames(Connection& connection, bool& more) {
+    size_t offset = 0;
+    more = false;
+    Frame frame;
+    long size;
+    while ((size = parseFrame(connection.input.data() + offset, connection.input.size() - offset, frame)) > 0) {
+        handle(connection, frame);
+        offset += static_cast<size_t>(size);
+        if (connection.output.size() - connection.output_offset >= OUTPUT_LIMIT) {
+            more = true;
+            break;
+        }
+    }
+    flushOrders(connection);
+    connection.input.erase(0, offset);
+    if (size < 0) {
+        counters_.protocol_errors++;
+        flush(connection); // best effort: the answers to the frames before the bad one
+        return false;
+    }
+    return true;
+}
+
+void KitchenServer::handle(Connection& connection, const Frame& frame) {
+    if (frame.code == NEW_ORDER) {
+        counters_.requests[NEW_ORDER]++;
+        Dish* dish = nullptr;
+        try {
+            dish = Kitchen::parseDish(std::string(frame.body, frame.size));
+        } catch (const std::exception&) {
+            dish = nullptr;
+        }
+        if (dish == nullptr) {
+            flushOrders(connection);
+            respond(connection, BAD_REQUEST, frame.id, nullptr, 0);
+            return;
+        }
+        order_dishes_.push_back(dish);
+        order_ids_.push_back(frame.id);
+        return;
+    }
+
+    // Every other request sees the kitchen with the orders before it
+    flushOrders(connection);
+    if (frame.code >= OPCODE_COUNT) {
+        respond(connection, BAD_REQUEST, frame.id, nullptr, 0);
+        return;
+    }
+    counters_.requests[frame.code]++;
+    if (frame.code == SERVE_DISH) {
+        Dish* dish = kitchen_.findDish(std::string(frame.body, frame.size));
+        if (dish == nullptr) {
+            respond(connection, NOT_FOUND, frame.id, nullptr, 0);
+            return;
+        }
+        kitchen_.serveDish(dish);
+        delete dish;
+        respond(connection, OK, frame.id, nullptr, 0);
+    } else if (frame.code == REPORT) {
+        report_.clear();
+        kitchen_.kitchenReport(report_);
+        respond(connection, OK, frame.id, report_.str().data(), report_.str().size());
+    } else {
+        QueryResult result = {};
+        if (frame.size == 0) {
+            result.dishes = static_cast<uint32_t>(kitchen_.getCurrentSize());
+            result.prep_time_sum = static_cast<uint32_t>(kitchen_.getPrepTimeSum());
+            result.average_prep_time = static_cast<uint32_t>(kitchen_.calculateAvgPrepTime());
+            result.elaborate_dishes = static_cast<uint32_t>(kitchen_.elaborateDishCount());
+            result.price_cents_sum = kitchen_.getPriceCentsSum();
+            result.average_price_cents = kitchen_.calculateAvgPriceCents();
+        } else {
+            std::string cuisine_type(frame.body, frame.size);
+            Dish::CuisineType cuisine;
+            if (!tryEnumFromToken(Dish::CUISINE_TYPE_INFO, cuisine_type, cuisine)) {
+                respond(connection, BAD_REQUEST, frame.id, nullptr, 0);
+                return;
+            }
+            result.dishes = static_cast<uint32_t>(kitchen_.tallyCuisineTypes(cuisine_type));
+            result.price_cents_sum = kitchen_.getPriceCentsSum(cuisine_type);
+        }
+        std::string body;
+        result.appendTo(body);
+        respond(connection, OK, frame.id, body.data(), body.size());
+    }
+}
+
+void KitchenServer::flushOrders(Connection& connection) {
+    if (order_dishes_.empty()) {
+        return;
+    }
+    int count = static_cast<int>(order_dishes_.size());
+    int added = kitchen_.newOrders(order_dishes_.data(), count);
+    counters_.order_batches++;
+    for (int i = 0; i < count; i++) {
+        if (i >= added) {
+            delete order_dishes_[i]; // refused, so still ours
+        }
+        respond(connection, i < added ? OK : FULL, order_ids_[i], nullptr, 0);
+    }
+    order_dishes_.clear();
+    order_ids_.clear();
+}
+
+void KitchenServer::respond(Connection& connection, int status, uint32_t id, const char* body, size_t size) {
+    appendFrame(connection.output, status, id, body, size);
+    counters_.responses[status]++;
+}
+
+bool KitchenServer::flush(Connection& connection) {
+    while (connection.output_offset < connection.output.size()) {
+        ssize_t count = ::send(connection.fd, connection.output.data() + connection.output_offset,
+                               connection.output.size() - connection.output_offset, MSG_NOSIGNAL);
+        if (count > 0) {
+            connection.output_offset += static_cast<size_t>(count);
+            counters_.writes++;
+        } else if (count < 0 && errno == EINTR) {
+            continue;
+        } else if (count < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            connection.writing = true;
+            return true;
+        } else {
+            return false;
+        }
+    }
+    connection.output.clear();
+    connection.output_offset = 0;
+    connection.writing = false;
+    return true;
+}
+
+bool KitchenServer::watch(Connection& connection, bool writing) {
+    epoll_event event = {};
+    event.events = writing ? EPOLLOUT : EPOLLIN;
+    event.data.fd = connection.fd;
+    connection.writing = writing;
+    return ::epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, connection.fd, &event) == 0;
+}
+
+void KitchenServer::closeConnection(int fd) {
+    ::epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+    ::close(fd);
+    connections_.erase(fd);
+    closed_++;
+}
@@ -0,0 +1,283 @@
+/**
+ * @file KitchenServer.hpp
+ * @brief This file contains the declaration of the KitchenServer class, a Unix-domain socket service that exposes one Kitchen to local processes.
+ *
+ * Several processes on one host can order, serve and query the same kitchen through a stream socket. The server runs
+ * one epoll event loop on the calling thread, so the kitchen is only ever touched by that thread and needs no lock.
+ *
+ * Protocol. Requests and responses are frames with a 9-byte header, integers little-endian (see WireFormat.hpp):
+ *
+ *   u32 length (of everything after this field) | u8 code | u32 request id | body (length - 5 bytes)
+ *
+ * A request's code is an Opcode and a response's code is a Status; the response echoes the request id.
+ *
+ *   NEW_ORDER   body: one row in the Dishes.csv schema       response: OK, FULL or BAD_REQUEST, empty body
+ *   SERVE_DISH  body: a dish name; the first dish with that   response: OK or NOT_FOUND, empty body
+ *               name is served and deleted
+ *   REPORT      body: empty                                  response: OK, body: the text of kitchenReport()
+ *   QUERY       body: empty, or a cuisine type token         response: OK or BAD_REQUEST, body: a QueryResult
+ *
+ * Pipelining and batching. A client may send any number of requests without waiting; responses come back in
+ * request order on the same connection. Each time a connection is readable the server reads what is available
+ * (up to 256 KiB), handles every complete frame, and sends all the responses with one write. A run of consecutive
+ * NEW_ORDER frames in one read goes to the kitchen as one Kitchen::newOrders() call. Once 1 MiB of responses is
+ * pending, or while a client does not read its responses, the server stops handling and reading its requests, so a
+ * slow client cannot make the server buffer without limit.
+ *
+ * A frame longer than MAX_FRAME_LENGTH is a protocol error and closes the connection; an unknown code gets a
+ * BAD_REQUEST response.
+ *
+ * Journal. When the kitchen is journaled (see OrderLog.hpp), pass the log to setLog(): the loop then wakes up when
+ * the pending group is due and commits it, so orders acknowledged just before the clients go quiet are synced
+ * within the log's `group_ms` instead of waiting for the next change.
+ *
+ * @date October 17, 2026
+ * @author Kun Feng Wei
+ */
+
+#ifndef KITCHEN_SERVER_HPP
+#define KITCHEN_SERVER_HPP
+
+#include "Dish.hpp"
+#include "EnumTable.hpp"
+#include "Kitchen.hpp"
+#include "MenuRenderer.hpp"
+#include "OutputSink.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class OrderLog;
+
+class KitchenServer {
+public:
+    /**
+     * The requests.
+     */
+    enum Opcode
+    {
+        NEW_ORDER,
+        SERVE_DISH,
+        REPORT,
+        QUERY,
+        OPCODE_COUNT
+    };
+
+    /**
+     * Metadata of each request; the token is the Kitchen method it calls.
+     */
+    static constexpr EnumInfo<Opcode> OPCODE_INFO[] = {
+        {NEW_ORDER, "newOrder", "Add a dish", 0},
+        {SERVE_DISH, "serveDish", "Serve a dish by name", 0},
+        {REPORT, "report", "The kitchen report", 0},
+        {QUERY, "query", "The aggregates of the kitchen or of one cuisine type", 0},
+    };
+
+    /**
+     * The outcomes of a request.
+     */
+    enum Status
+    {
+        OK,
+        FULL,
+        NOT_FOUND,
+        BAD_REQUEST,
+        STATUS_COUNT
+    };
+
+    /**
+     * Metadata of each status.
+     */
+    static constexpr EnumInfo<Status> STATUS_INFO[] = {
+        {OK, "ok", "Done", 0},
+        {FULL, "full", "The kitchen is full", 0},
+        {NOT_FOUND, "not_found", "No dish has that name", 0},
+        {BAD_REQUEST, "bad_request", "Malformed body or unknown code", 0},
+    };
+
+    /**
+     * The size of a frame header.
+     */
+    static const size_t FRAME_HEADER_SIZE = 9;
+
+    /**
+     * The largest accepted value of a frame's length field.
+     */
+    static const uint32_t MAX_FRAME_LENGTH = 1u << 20;
+
+    /**
+     * One decoded frame; `body` points into the buffer it was parsed from.
+     */
+    struct Frame
+    {
+        int code;
+        uint32_t id;
+        const char* body;
+        size_t size;
+    };
+
+    /**
+     * The body of a QUERY response. For a cuisine type only `dishes` (its tally) and `price_cents_sum` are set.
+     */
+    struct QueryResult
+    {
+        uint32_t dishes;
+        uint32_t prep_time_sum;
+        uint32_t average_prep_time;
+        uint32_t elaborate_dishes;
+        int64_t price_cents_sum;
+        int64_t average_price_cents;
+
+        static const size_t SIZE = 32;
+
+        /**
+         * Appends the SIZE bytes of the body.
+         * @param out The string receiving the body.
+         */
+        void appendTo(std::string& out) const;
+
+        /**
+         * Decodes a body.
+         * @param body The body.
+         * @param size Its size.
+         * @return True if the body is SIZE bytes long, false otherwise.
+         */
+        bool readFrom(const char* body, size_t size);
+    };
+
+    /**
+     * Totals since the server started.
+     */
+    struct Counters
+    {
+        long long connections;                ///< Connections accepted.
+        long long requests[OPCODE_COUNT];     ///< Requests handled, by opcode (unknown codes are not counted).
+        long long responses[STATUS_COUNT];    ///< Responses sent, by status.
+        long long reads;                      ///< Wake-ups that read at least one byte.
+        long long writes;                     ///< write() calls that sent at least one byte.
+        long long order_batches;              ///< Kitchen::newOrders() calls.
+        long long protocol_errors;            ///< Connections closed for an oversized frame.
+
+        /**
+         * Appends one line, e.g. "serve: 4 connections, 400000 requests (newOrder=180000 ...) in 25100 reads and
+         * 25100 writes, 15.9 requests per read, 6.1 orders per batch".
+         * @param out The renderer receiving the text.
+         */
+        void writeText(MenuRenderer& out) const;
+    };
+
+    /**
+     * Appends one frame.
+     * @param out The string receiving the frame.
+     * @param code The opcode or status.
+     * @param id The request id.
+     * @param body The body.
+     * @param size The size of the body.
+     */
+    static void appendFrame(std::string& out, int code, uint32_t id, const char* body, size_t size);
+
+    /**
+     * Decodes the frame at the start of a buffer.
+     * @param data The buffer.
+     * @param size The number of bytes in the buffer.
+     * @param[out] frame Receives the frame.
+     * @return The size of the frame, 0 if the buffer does not hold a complete frame yet, or -1 if the length field
+     * is out of range.
+     */
+    static long parseFrame(const char* data, size_t size, Frame& frame);
+
+    /**
+     * Parameterized constructor. No socket is created until start().
+     * @param kitchen The kitchen the requests operate on.
+     * @param socket_path The path the server listens on.
+     */
+    KitchenServer(Kitchen& kitchen, const std::string& socket_path);
+
+    KitchenServer(const KitchenServer&) = delete;
+    KitchenServer& operator=(const KitchenServer&) = delete;
+
+    /**
+     * Destructor.
+     * @post Closes every connection and removes the socket file.
+     */
+    ~KitchenServer();
+
+    /**
+     * Makes the event loop commit a journal's pending group when it is due, even while no request arrives.
+     * @param log The log following the kitchen, or nullptr for none.
+     */
+    void setLog(OrderLog* log);
+
+    /**
+     * Creates the socket, replacing a stale socket file at the path, and starts listening.
+     * @param[out] error Receives the reason when the server cannot start.
+     * @return True if the server is listening, false otherwise.
+     */
+    bool start(std::string& error);
+
+    /**
+     * Serves requests until stop() is called, or until `exit_after` connections have closed.
+     * @param exit_after The number of connections to serve before returning, or 0 for no limit.
+     * @param[out] error Receives the reason when the event loop fails.
+     * @return True if the loop was stopped, false if it failed.
+     * @pre start() succeeded.
+     */
+    bool run(long long exit_after, std::string& error);
+
+    /**
+     * Makes run() return. Safe to call from any thread and from a signal handler.
+     */
+    void stop();
+
+    /**
+     * @return The totals since the server started.
+     */
+    const Counters& counters() const;
+
+private:
+    struct Connection
+    {
+        int fd;
+        std::string input;   // received bytes not yet handled
+        std::string output;  // responses not yet written
+        size_t output_offset;
+        bool writing;        // waiting for EPOLLOUT; requests are not read meanwhile
+    };
+
+    void acceptConnections();
+    // Reads what a connection sent, handles it and writes the responses; false if the connection must be closed
+    bool receive(Connection& connection);
+    // Handles complete frames until the input runs out or the output passes OUTPUT_LIMIT; false on a protocol error
+    bool handleFrames(Connection& connection, bool& more);
+    void handle(Connection& connection, const Frame& frame);
+    // Adds the pending run of NEW_ORDER dishes with one Kitchen::newOrders() call and answers each
+    void flushOrders(Connection& connection);
+    void respond(Connection& connection, int status, uint32_t id, const char* body, size_t size);
+    // Handles buffered frames and writes responses until both run out or the socket is full; false on failure
+    bool serve(Connection& connection);
+    // Writes pending responses; false if the connection failed
+    bool flush(Connection& connection);
+    bool watch(Connection& connection, bool writing);
+    void closeConnection(int fd);
+
+    Kitchen& kitchen_;
+    OrderLog* log_;  // committed by the loop when due, if set
+    std::string path_;
+    int listen_fd_;
+    int epoll_fd_;
+    int stop_fd_;  // an eventfd written by stop()
+    std::unordered_map<int, std::unique_ptr<Connection>> connections_;
+    long long closed_;
+    std::vector<Dish*> order_dishes_;  // the pending run of NEW_ORDER requests
+    std::vector<uint32_t> order_ids_;
+    StringSink report_;                // reused by REPORT
+    Counters counters_;
+};
+
+static_assert(isIndexedByValue(KitchenServer::OPCODE_INFO), "OPCODE_INFO must be in enum order");
+static_assert(isIndexedByValue(KitchenServer::STATUS_INFO), "STATUS_INFO must be in enum order");
+
+#endif // KITCHEN_SERVER_HPP
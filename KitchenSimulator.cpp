@@ -0,0 +1,251 @@
+/**
+ * @file KitchenSimulator.cpp
+ * @brief This file contains the implementation of the KitchenSimulator class, a discrete-event simulation of cook stations serving a menu.
+ *
+ * @date October 17, 2026
+ * @author Kun Feng Wei
+ */
+
+#include "KitchenSimulator.hpp"
+#include "MenuCursor.hpp"
+#include "MinHeap.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <unordered_map>
+
+namespace {
+
+const double MINUTES_PER_DAY = 24.0 * 60.0;
+
+// A station finishing its order, or (station == ARRIVAL) the next order arriving
+struct Event
+{
+    double minute;
+    uint64_t sequence;
+    int station;
+};
+
+const int ARRIVAL = -1;
+
+struct EventBefore
+{
+    bool operator()(const Event& a, const Event& b) const
+    {
+        return a.minute != b.minute ? a.minute < b.minute : a.sequence < b.sequence;
+    }
+};
+
+// An order in the waiting queue; `key` is its rank under the policy, `sequence` breaks ties first come first served
+struct Waiting
+{
+    double key;
+    uint64_t sequence;
+    double arrival;
+    int prep_time;
+};
+
+struct WaitingBefore
+{
+    bool operator()(const Waiting& a, const Waiting& b) const
+    {
+        return a.key != b.key ? a.key < b.key : a.sequence < b.sequence;
+    }
+};
+
+// Random helpers written out by hand, as in menugen, so a seed gives the same arrivals with every standard library
+double uniformReal(std::mt19937_64& rng)
+{
+    return static_cast<double>(rng() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+double exponential(std::mt19937_64& rng, double rate)
+{
+    return -std::log(1.0 - uniformReal(rng)) / rate;
+}
+
+double waitingKey(KitchenSimulator::Policy policy, double arrival, int prep_time, double sla_minutes)
+{
+    switch (policy)
+    {
+        case KitchenSimulator::SPT: return prep_time;
+        case KitchenSimulator::LPT: return -prep_time;
+        case KitchenSimulator::EDF: return arrival + prep_time + sla_minutes;
+        default: return arrival;
+    }
+}
+
+} // namespace
+
+KitchenSimulator::KitchenSimulator(const Kitchen& kitchen) : menu_(), arrivals_() {
+    MenuCursor cursor(kitchen);
+    while (const Dish* dish = cursor.nextDish()) {
+        menu_.push_back({dish->getName(), dish->getPrepTime()});
+    }
+}
+
+bool KitchenSimulator::loadArrivals(std::istream& input, std::string& error) {
+    arrivals_.clear();
+    std::unordered_map<std::string, int> dish_of;
+    for (size_t i = 0; i < menu_.size(); i++) {
+        dish_of.emplace(menu_[i].name, static_cast<int>(i)); // the first dish with a name wins, as in Kitchen::findDish()
+    }
+
+    std::string line;
+    int line_number = 0;
+    while (std::getline(input, line)) {
+        line_number++;
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        char* end = nullptr;
+        double minute = std::strtod(line.c_str(), &end);
+        std::unordered_map<std::string, int>::const_iterator found = dish_of.end();
+        if (end != line.c_str() && *end == ' ' && minute >= 0.0) {
+            found = dish_of.find(std::string(end + 1));
+        }
+        if (found == dish_of.end()) {
+            error = "line " + std::to_string(line_number) + ": expected '<minute> <dish name>' with a dish on the menu";
+            arrivals_.clear();
+            return false;
+        }
+        arrivals_.push_back({minute, found->second});
+    }
+    std::stable_sort(arrivals_.begin(), arrivals_.end(), [](const Arrival& a, const Arrival& b) { return a.minute < b.minute; });
+    return true;
+}
+
+size_t KitchenSimulator::menuSize() const {
+    return menu_.size();
+}
+
+bool KitchenSimulator::hasTrace() const {
+    return !arrivals_.empty();
+}
+
+void KitchenSimulator::run(const Config& config, Result& result) const {
+    std::chrono::steady_clock::time_point wall_begin = std::chrono::steady_clock::now();
+    result.orders = 0;
+    result.completed = 0;
+    result.late = 0;
+    result.busy_minutes = 0.0;
+    result.events = 0;
+    result.depth_minutes = 0.0;
+    result.wait_seconds.clear();
+    result.queue_depth.clear();
+
+    const bool traced = hasTrace();
+    // Without a length, a traced run lasts until its last order is done
+    const bool until_drained = traced && config.days <= 0.0;
+    const double period = until_drained ? HUGE_VAL : config.days * MINUTES_PER_DAY;
+
+    std::mt19937_64 rng(config.seed);
+    const double rate_per_minute = config.rate_per_hour / 60.0;
+    size_t next_traced = 0;
+    // Next arrival time and dish, drawn lazily so only one arrival is ever pending
+    double next_minute = 0.0;
+    int next_dish = 0;
+    auto drawArrival = [&]() {
+        if (traced) {
+            if (next_traced == arrivals_.size()) {
+                return false;
+            }
+            next_minute = arrivals_[next_traced].minute;
+            next_dish = arrivals_[next_traced].dish;
+            next_traced++;
+        } else {
+            if (rate_per_minute <= 0.0) {
+                return false;
+            }
+            next_minute += exponential(rng, rate_per_minute);
+            next_dish = static_cast<int>(rng() % menu_.size());
+        }
+        return next_minute <= period;
+    };
+
+    const int stations = std::max(1, config.stations);
+    MinHeap<Event, EventBefore> events;
+    events.reserve(stations + 1);
+    MinHeap<Waiting, WaitingBefore> waiting;
+    std::vector<int> free_stations;
+    for (int station = stations - 1; station >= 0; station--) {
+        free_stations.push_back(station);
+    }
+    uint64_t sequence = 0;
+    double end_minutes = 0.0;
+    double last_minute = 0.0;
+
+    // Starts an order on a free station at `now`
+    auto start = [&](int station, double now, double arrival, int prep_time) {
+        double wait = now - arrival;
+        result.wait_seconds.record(static_cast<uint64_t>(std::llround(wait * 60.0)));
+        if (wait > config.sla_minutes) {
+            result.late++;
+        }
+        result.busy_minutes += prep_time;
+        events.push({now + prep_time, sequence++, station});
+    };
+
+    if (drawArrival()) {
+        events.push({next_minute, sequence++, ARRIVAL});
+    }
+    while (!events.empty()) {
+        Event event = events.top();
+        events.pop();
+        result.events++;
+        double now = event.minute;
+        result.depth_minutes += waiting.size() * (now - last_minute);
+        last_minute = now;
+        if (event.station == ARRIVAL) {
+            result.orders++;
+            result.queue_depth.record(waiting.size());
+            int prep_time = menu_[next_dish].prep_time;
+            if (!free_stations.empty()) {
+                int station = free_stations.back();
+                free_stations.pop_back();
+                start(station, now, now, prep_time);
+            } else {
+                waiting.push({waitingKey(config.policy, now, prep_time, config.sla_minutes), sequence++, now, prep_time});
+            }
+            if (drawArrival()) {
+                events.push({next_minute, sequence++, ARRIVAL});
+            }
+        } else {
+            end_minutes = now;
+            if (now <= period) {
+                result.completed++;
+            }
+            if (waiting.empty()) {
+                free_stations.push_back(event.station);
+            } else {
+                Waiting next = waiting.top();
+                waiting.pop();
+                start(event.station, now, next.arrival, next.prep_time);
+            }
+        }
+    }
+    result.period_minutes = until_drained ? end_minutes : period;
+    result.end_minutes = std::max(result.period_minutes, end_minutes);
+    result.wall_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - wall_begin).count();
+}
+
+void KitchenSimulator::Result::writeText(MenuRenderer& out, const Config& config) const {
+    const double hours = period_minutes / 60.0;
+    out.append("stations ").appendInt(config.stations).append(": orders=").appendInt(orders);
+    out.append(" throughput=").appendFixed(hours > 0 ? completed / hours : 0.0, 1).append("/h");
+    out.append(" utilization=").appendFixed(end_minutes > 0 ? 100.0 * busy_minutes / (config.stations * end_minutes) : 0.0, 1).append('%');
+    out.append(" depth_mean=").appendFixed(end_minutes > 0 ? depth_minutes / end_minutes : 0.0, 2);
+    out.append(" depth_p99=").appendInt(static_cast<long long>(queue_depth.valueAtPercentile(99)));
+    out.append(" depth_max=").appendInt(static_cast<long long>(queue_depth.max()));
+    out.append(" wait_p50=").appendFixed(wait_seconds.valueAtPercentile(50) / 60.0, 1);
+    out.append(" wait_p90=").appendFixed(wait_seconds.valueAtPercentile(90) / 60.0, 1);
+    out.append(" wait_p99=").appendFixed(wait_seconds.valueAtPercentile(99) / 60.0, 1);
+    out.append(" wait_max=").appendFixed(wait_seconds.max() / 60.0, 1).append(" min");
+    out.append(" late=").appendInt(late).append(" backlog=").appendInt(orders - completed);
+    out.append(" sim_ms=").appendFixed(wall_ms, 1).append('\n');
+}
@@ -0,0 +1,219 @@
+/**
+ * @file KitchenStats.cpp
+ * @brief This file contains the implementation of the KitchenStats class, the hot-path counters behind Kitchen::stats().
+ *
+ * Every thread that records a call gets its own cache-line aligned block of counters, registered in a list guarded by
+ * a mutex. The mutex is only taken when a thread records for the first time, when it exits and when the counters are
+ * read; recording itself is a relaxed load and store on the thread's own block, plus one histogram increment. The
+ * blocks are allocated on the heap when a thread first records, so threads that never touch a Kitchen do not pay
+ * for the histograms in their thread-local storage.
+ *
+ * @date October 17, 2026
+ * @author Kun Feng Wei
+ */
+
+#include "KitchenStats.hpp"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+const int FIELD_COUNT = 5; // calls, ns, items, rejections, capacity_drops
+
+// One thread's counters; written only by that thread, read by snapshot()
+struct alignas(64) ThreadCounters
+{
+    std::atomic<uint64_t> values[KitchenStats::OPERATION_COUNT][FIELD_COUNT];
+    LatencyHistogram latencies[KitchenStats::OPERATION_COUNT];
+
+    ThreadCounters()
+    {
+        for (std::atomic<uint64_t>(&operation)[FIELD_COUNT] : values)
+        {
+            for (std::atomic<uint64_t>& value : operation)
+            {
+                value.store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+};
+
+// Blocks of the running threads and the totals of the threads that have exited
+struct Registry
+{
+    std::mutex mutex;
+    std::vector<ThreadCounters*> threads;
+    uint64_t retired[KitchenStats::OPERATION_COUNT][FIELD_COUNT] = {};
+    uint64_t baseline[KitchenStats::OPERATION_COUNT][FIELD_COUNT] = {}; // totals at the last reset()
+    LatencyHistogram retired_latencies[KitchenStats::OPERATION_COUNT];
+    LatencyHistogram baseline_latencies[KitchenStats::OPERATION_COUNT];
+};
+
+Registry& registry()
+{
+    static Registry* instance = new Registry(); // never destroyed, so threads exiting late can still retire
+    return *instance;
+}
+
+// Registers the calling thread's block on first use and retires it when the thread exits
+struct ThreadCountersOwner
+{
+    ThreadCounters counters;
+
+    ThreadCountersOwner()
+    {
+        std::lock_guard<std::mutex> lock(registry().mutex);
+        registry().threads.push_back(&counters);
+    }
+
+    ~ThreadCountersOwner()
+    {
+        Registry& shared = registry();
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        for (int operation = 0; operation < KitchenStats::OPERATION_COUNT; operation++)
+        {
+            for (int field = 0; field < FIELD_COUNT; field++)
+            {
+                shared.retired[operation][field] += counters.values[operation][field].load(std::memory_order_relaxed);
+            }
+            shared.retired_latencies[operation].merge(counters.latencies[operation]);
+        }
+        for (size_t i = 0; i < shared.threads.size(); i++)
+        {
+            if (shared.threads[i] == &counters)
+            {
+                shared.threads.erase(shared.threads.begin() + i);
+                break;
+            }
+        }
+    }
+};
+
+// Single writer, so a load and a store are enough; no read-modify-write on the hot path
+inline void add(std::atomic<uint64_t>& value, uint64_t amount)
+{
+    value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+// Adds up the retired totals and every running thread's block; the caller holds the registry mutex
+void sumLocked(const Registry& shared, uint64_t (&totals)[KitchenStats::OPERATION_COUNT][FIELD_COUNT])
+{
+    for (int operation = 0; operation < KitchenStats::OPERATION_COUNT; operation++)
+    {
+        for (int field = 0; field < FIELD_COUNT; field++)
+        {
+            totals[operation][field] = shared.retired[operation][field];
+            for (const ThreadCounters* thread : shared.threads)
+            {
+                totals[operation][field] += thread->values[operation][field].load(std::memory_order_relaxed);
+            }
+        }
+    }
+}
+
+// Merges the latencies of one operation over exited and running threads; the caller holds the registry mutex
+LatencyHistogram mergeLatenciesLocked(const Registry& shared, int operation)
+{
+    LatencyHistogram merged(shared.retired_latencies[operation]);
+    for (const ThreadCounters* thread : shared.threads)
+    {
+        merged.merge(thread->latencies[operation]);
+    }
+    return merged;
+}
+
+} // namespace
+
+const KitchenStats::OperationStats& KitchenStats::Snapshot::operator[](Operation operation) const {
+    return operations[operation];
+}
+
+void KitchenStats::Snapshot::writeText(MenuRenderer& out) const {
+    for (const EnumInfo<Operation>& info : OPERATION_INFO) {
+        const OperationStats& stats = operations[info.value];
+        if (stats.calls == 0) {
+            continue;
+        }
+        out.append(info.token).append(": calls=").appendInt(static_cast<long long>(stats.calls));
+        out.append(" ns=").appendInt(static_cast<long long>(stats.ns));
+        out.append(" ns/call=").appendFixed(static_cast<double>(stats.ns) / stats.calls, 1);
+        out.append(" items=").appendInt(static_cast<long long>(stats.items));
+        out.append(" rejections=").appendInt(static_cast<long long>(stats.rejections));
+        out.append(" capacity_drops=").appendInt(static_cast<long long>(stats.capacity_drops)).append('\n');
+    }
+}
+
+/**
+ * Default constructor.
+ * The counters themselves live in the registry, so there is nothing to initialize.
+ */
+KitchenStats::KitchenStats() {
+}
+
+KitchenStats& KitchenStats::instance() {
+    static KitchenStats stats;
+    return stats;
+}
+
+void KitchenStats::record(Operation operation, uint64_t ns, uint64_t items, uint64_t rejections, uint64_t capacity_drops) {
+    static thread_local std::unique_ptr<ThreadCountersOwner> owner;
+    if (!owner) {
+        owner.reset(new ThreadCountersOwner());
+    }
+    std::atomic<uint64_t>(&fields)[FIELD_COUNT] = owner->counters.values[operation];
+    add(fields[0], 1);
+    add(fields[1], ns);
+    add(fields[2], items);
+    add(fields[3], rejections);
+    add(fields[4], capacity_drops);
+    owner->counters.latencies[operation].record(ns);
+}
+
+KitchenStats::Snapshot KitchenStats::snapshot() const {
+    Snapshot snapshot = {};
+    if (!ENABLED) {
+        return snapshot;
+    }
+    uint64_t totals[OPERATION_COUNT][FIELD_COUNT];
+    Registry& shared = registry();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    sumLocked(shared, totals);
+    for (int operation = 0; operation < OPERATION_COUNT; operation++) {
+        const uint64_t* baseline = shared.baseline[operation];
+        const uint64_t* fields = totals[operation];
+        snapshot.operations[operation] = {fields[0] - baseline[0], fields[1] - baseline[1], fields[2] - baseline[2],
+                                          fields[3] - baseline[3], fields[4] - baseline[4]};
+    }
+    return snapshot;
+}
+
+LatencyHistogram KitchenStats::latency(Operation operation) const {
+    if (!ENABLED) {
+        return LatencyHistogram();
+    }
+    Registry& shared = registry();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    LatencyHistogram merged = mergeLatenciesLocked(shared, operation);
+    merged.subtract(shared.baseline_latencies[operation]);
+    return merged;
+}
+
+void KitchenStats::writeLatencies(MenuRenderer& out) const {
+    for (const EnumInfo<Operation>& info : OPERATION_INFO) {
+        latency(info.value).writeSummary(out, info.token);
+    }
+}
+
+void KitchenStats::reset() {
+    if (!ENABLED) {
+        return;
+    }
+    Registry& shared = registry();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    sumLocked(shared, shared.baseline);
+    for (int operation = 0; operation < OPERATION_COUNT; operation++) {
+        shared.baseline_latencies[operation] = mergeLatenciesLocked(shared, operation);
+    }
+}
@@ -0,0 +1,208 @@
+/**
+ * @file KitchenStats.hpp
+ * @brief This file contains the declaration of the KitchenStats class, the hot-path counters behind Kitchen::stats().
+ *
+ * Each instrumented Kitchen operation opens a KitchenStats::Scope, which times the call and counts the items it
+ * touched, the requests it rejected and the dishes dropped because the kitchen was full. When the scope closes, the
+ * totals are added to a block of counters owned by the calling thread, so threads never write to the same cache line.
+ * snapshot() adds up the blocks of all threads (plus the totals of threads that have exited); reset() records the
+ * current totals as the new zero instead of touching other threads' blocks.
+ *
+ * Every call's time is also recorded in a LatencyHistogram per operation and thread, so tail latencies (p99, p999)
+ * can be read with latency() or printed with writeLatencies().
+ *
+ * The counters are compiled in only when KITCHEN_STATS is defined (`make STATS=1`). Otherwise Scope is an empty
+ * class whose calls compile to nothing, and every snapshot reads zero.
+ *
+ * @date October 17, 2026
+ * @author Kun Feng Wei
+ */
+
+#ifndef KITCHEN_STATS_HPP
+#define KITCHEN_STATS_HPP
+
+#include "EnumTable.hpp"
+#include "LatencyHistogram.hpp"
+#include "MenuRenderer.hpp"
+#include <chrono>
+#include <cstdint>
+
+class KitchenStats {
+public:
+    /**
+     * The instrumented operations.
+     */
+    enum Operation
+    {
+        NEW_ORDER,
+        SERVE_DISH,
+        RELEASE_BELOW_PREP_TIME,
+        RELEASE_CUISINE_TYPE,
+        DIETARY_ADJUSTMENT,
+        TALLY_CUISINE_TYPES,
+        CALCULATE_AVG_PREP_TIME,
+        LOAD_READ,
+        LOAD_PARSE,
+        LOAD_BUILD,
+        DISPLAY_MENU,
+        KITCHEN_REPORT,
+        EXPORT,
+        NEW_ORDERS,
+        OPERATION_COUNT
+    };
+
+    /**
+     * Metadata of each operation; the token is the name used in printed statistics.
+     */
+    static constexpr EnumInfo<Operation> OPERATION_INFO[] = {
+        {NEW_ORDER, "newOrder", "New order", 0},
+        {SERVE_DISH, "serveDish", "Serve dish", 0},
+        {RELEASE_BELOW_PREP_TIME, "releaseDishesBelowPrepTime", "Release below prep time", 0},
+        {RELEASE_CUISINE_TYPE, "releaseDishesOfCuisineType", "Release cuisine type", 0},
+        {DIETARY_ADJUSTMENT, "dietaryAdjustment", "Dietary adjustment", 0},
+        {TALLY_CUISINE_TYPES, "tallyCuisineTypes", "Tally cuisine types", 0},
+        {CALCULATE_AVG_PREP_TIME, "calculateAvgPrepTime", "Average prep time", 0},
+        {LOAD_READ, "load.read", "Load: read line", 0},
+        {LOAD_PARSE, "load.parse", "Load: parse fields", 0},
+        {LOAD_BUILD, "load.build", "Load: build dish", 0},
+        {DISPLAY_MENU, "displayMenu", "Display menu", 0},
+        {KITCHEN_REPORT, "kitchenReport", "Kitchen report", 0},
+        {EXPORT, "export", "Export", 0},
+        {NEW_ORDERS, "newOrders", "New orders (batch)", 0},
+    };
+
+    /**
+     * Totals of one operation.
+     */
+    struct OperationStats
+    {
+        uint64_t calls;           ///< Number of completed calls.
+        uint64_t ns;              ///< Cumulative wall time of those calls in nanoseconds.
+        uint64_t items;           ///< Dishes (or rows) the calls touched.
+        uint64_t rejections;      ///< Calls or rows refused (dish not found, unknown cuisine, unusable row).
+        uint64_t capacity_drops;  ///< Dishes dropped because the kitchen was full.
+    };
+
+    /**
+     * A copy of all counters. Each value is read atomically, but not all at the same instant, so while other
+     * threads are recording, one operation's calls and ns may come from slightly different moments.
+     */
+    struct Snapshot
+    {
+        OperationStats operations[OPERATION_COUNT];
+
+        /**
+         * @param operation The operation to read.
+         * @return A const reference to its totals.
+         */
+        const OperationStats& operator[](Operation operation) const;
+
+        /**
+         * Appends one line per operation that was called, e.g.
+         * "newOrder: calls=99 ns=4210 ns/call=42.5 items=99 rejections=0 capacity_drops=0".
+         * @param out The renderer receiving the text.
+         */
+        void writeText(MenuRenderer& out) const;
+    };
+
+    /**
+     * True when the counters are compiled in (KITCHEN_STATS is defined).
+     */
+#ifdef KITCHEN_STATS
+    static constexpr bool ENABLED = true;
+#else
+    static constexpr bool ENABLED = false;
+#endif
+
+    /**
+     * @return The process-wide statistics shared by every Kitchen.
+     */
+    static KitchenStats& instance();
+
+    /**
+     * @return The totals of all threads since the last reset(), or all zeros when the counters are compiled out.
+     * Every count is exact once the threads doing the work have stopped.
+     */
+    Snapshot snapshot() const;
+
+    /**
+     * @param operation The operation to read.
+     * @return The latencies of that operation on all threads since the last reset(), merged into one histogram.
+     */
+    LatencyHistogram latency(Operation operation) const;
+
+    /**
+     * Appends one percentile line per operation that was called (see LatencyHistogram::writeSummary()).
+     * @param out The renderer receiving the text.
+     */
+    void writeLatencies(MenuRenderer& out) const;
+
+    /**
+     * Starts counting from zero again.
+     * @post The next snapshot() and latency() only include work recorded after this call.
+     */
+    void reset();
+
+    /**
+     * Adds one finished call to the calling thread's counters. Called by Scope.
+     */
+    static void record(Operation operation, uint64_t ns, uint64_t items, uint64_t rejections, uint64_t capacity_drops);
+
+    class Scope;
+
+private:
+    KitchenStats();
+};
+
+static_assert(isIndexedByValue(KitchenStats::OPERATION_INFO), "OPERATION_INFO must be in enum order");
+
+#ifdef KITCHEN_STATS
+
+/**
+ * @class KitchenStats::Scope
+ * @brief Times one call of an operation from construction to destruction and records it with its counts.
+ */
+class KitchenStats::Scope {
+public:
+    explicit Scope(Operation operation)
+        : operation_(operation), begin_(std::chrono::steady_clock::now()), items_(0), rejections_(0), capacity_drops_(0) {}
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+    ~Scope()
+    {
+        std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - begin_;
+        record(operation_, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(), items_, rejections_, capacity_drops_);
+    }
+
+    void addItems(uint64_t count) { items_ += count; }
+    void reject() { rejections_++; }
+    void dropCapacityFull() { capacity_drops_++; }
+
+private:
+    Operation operation_;
+    std::chrono::steady_clock::time_point begin_;
+    uint64_t items_;
+    uint64_t rejections_;
+    uint64_t capacity_drops_;
+};
+
+#else
+
+// Compiled-out Scope: no members, no clock reads, every call is an empty inline function
+class KitchenStats::Scope {
+public:
+    explicit Scope(Operation) {}
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+    void addItems(uint64_t) {}
+    void reject() {}
+    void dropCapacityFull() {}
+};
+
+#endif // KITCHEN_STATS
+
+#endif // KITCHEN_STATS_HPP
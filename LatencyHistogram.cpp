@@ -0,0 +1,108 @@
+/**
+ * @file LatencyHistogram.cpp
+ * @brief This file contains the implementation of the LatencyHistogram class, a log-bucketed histogram of latencies in ns.
+ *
+ * @date October 17, 2026
+ * @author Kun Feng Wei
+ */
+
+#include "LatencyHistogram.hpp"
+#include <cmath>
+
+/**
+ * Default constructor.
+ * Initializes every bucket to zero.
+ */
+LatencyHistogram::LatencyHistogram() {
+    clear();
+}
+
+LatencyHistogram::LatencyHistogram(const LatencyHistogram& other) {
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        counts_[i].store(other.counts_[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+}
+
+LatencyHistogram& LatencyHistogram::operator=(const LatencyHistogram& other) {
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        counts_[i].store(other.counts_[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+    return *this;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        counts_[i].fetch_add(other.counts_[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+}
+
+void LatencyHistogram::subtract(const LatencyHistogram& earlier) {
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        counts_[i].fetch_sub(earlier.counts_[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+}
+
+void LatencyHistogram::clear() {
+    for (std::atomic<uint64_t>& count : counts_) {
+        count.store(0, std::memory_order_relaxed);
+    }
+}
+
+uint64_t LatencyHistogram::count() const {
+    uint64_t total = 0;
+    for (const std::atomic<uint64_t>& count : counts_) {
+        total += count.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(int index) {
+    if (index < SUB_BUCKET_COUNT) {
+        return static_cast<uint64_t>(index);
+    }
+    int shift = index / SUB_BUCKET_COUNT - 1;
+    uint64_t lower = static_cast<uint64_t>(SUB_BUCKET_COUNT + index % SUB_BUCKET_COUNT) << shift;
+    return lower + (uint64_t(1) << shift) - 1;
+}
+
+uint64_t LatencyHistogram::valueAtPercentile(double percentile) const {
+    uint64_t total = count();
+    if (total == 0) {
+        return 0;
+    }
+    // Rank of the value at the percentile, counting from 1; p0 is the smallest value, p100 the largest
+    uint64_t rank = static_cast<uint64_t>(std::ceil(percentile / 100.0 * total));
+    if (rank < 1) {
+        rank = 1;
+    }
+    uint64_t seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        seen += counts_[i].load(std::memory_order_relaxed);
+        if (seen >= rank) {
+            return bucketUpperBound(i);
+        }
+    }
+    return bucketUpperBound(BUCKET_COUNT - 1);
+}
+
+uint64_t LatencyHistogram::max() const {
+    for (int i = BUCKET_COUNT - 1; i >= 0; i--) {
+        if (counts_[i].load(std::memory_order_relaxed) != 0) {
+            return bucketUpperBound(i);
+        }
+    }
+    return 0;
+}
+
+void LatencyHistogram::writeSummary(MenuRenderer& out, std::string_view label) const {
+    uint64_t total = count();
+    if (total == 0) {
+        return;
+    }
+    out.append(label).append(": count=").appendInt(static_cast<long long>(total));
+    out.append(" p50=").appendInt(static_cast<long long>(valueAtPercentile(50)));
+    out.append(" p90=").appendInt(static_cast<long long>(valueAtPercentile(90)));
+    out.append(" p99=").appendInt(static_cast<long long>(valueAtPercentile(99)));
+    out.append(" p999=").appendInt(static_cast<long long>(valueAtPercentile(99.9)));
+    out.append(" max=").appendInt(static_cast<long long>(max())).append(" ns\n");
+}
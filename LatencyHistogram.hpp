@@ -0,0 +1,123 @@
+/**
+ * @file LatencyHistogram.hpp
+ * @brief This file contains the declaration of the LatencyHistogram class, a log-bucketed histogram of latencies in ns.
+ *
+ * The buckets follow the HDR histogram layout: values below 32 get one bucket each, and every power of two above that
+ * is split into 32 equal sub-buckets, so any recorded value is known to within 1/32 (about 3%) of itself. Values of
+ * 2^40 ns (about 18 minutes) or more share the last bucket. Recording is one relaxed atomic increment, so it is
+ * lock-free and safe from any number of threads. Histograms recorded on different threads are combined with merge().
+ *
+ * @date October 17, 2026
+ * @author Kun Feng Wei
+ */
+
+#ifndef LATENCY_HISTOGRAM_HPP
+#define LATENCY_HISTOGRAM_HPP
+
+#include "MenuRenderer.hpp"
+#include <atomic>
+#include <cstdint>
+#include <string_view>
+
+class LatencyHistogram {
+public:
+    static const int SUB_BUCKET_BITS = 5;
+    static const int SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+    static const int MAX_EXPONENT = 40;
+    static const int BUCKET_COUNT = (MAX_EXPONENT - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT;
+
+    /**
+     * Default constructor.
+     * Initializes every bucket to zero.
+     */
+    LatencyHistogram();
+
+    /**
+     * Copy constructor.
+     * @param other The histogram whose counts are copied, read bucket by bucket.
+     */
+    LatencyHistogram(const LatencyHistogram& other);
+
+    LatencyHistogram& operator=(const LatencyHistogram& other);
+
+    /**
+     * Records one value.
+     * @param value The latency in nanoseconds.
+     */
+    void record(uint64_t value)
+    {
+        counts_[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * Adds every count of another histogram to this one.
+     * @param other The histogram to merge in.
+     */
+    void merge(const LatencyHistogram& other);
+
+    /**
+     * Removes the counts of an earlier copy of this histogram, leaving what was recorded since.
+     * @param earlier A copy taken before, whose counts are all less than or equal to this histogram's.
+     */
+    void subtract(const LatencyHistogram& earlier);
+
+    /**
+     * Sets every bucket to zero.
+     */
+    void clear();
+
+    /**
+     * @return The number of recorded values.
+     */
+    uint64_t count() const;
+
+    /**
+     * @param percentile A percentile in [0, 100], e.g. 99.9.
+     * @return The highest value that falls in the same bucket as the value at the given percentile, or 0 if the
+     * histogram is empty. Exact below 32 ns, within about 3% above.
+     */
+    uint64_t valueAtPercentile(double percentile) const;
+
+    /**
+     * @return The highest value equivalent to the largest recorded value, or 0 if the histogram is empty.
+     */
+    uint64_t max() const;
+
+    /**
+     * Appends one summary line, e.g. "newOrder: count=99 p50=41 p90=63 p99=120 p999=512 max=600 ns".
+     * Nothing is appended when the histogram is empty.
+     * @param out The renderer receiving the text.
+     * @param label The name printed at the start of the line.
+     */
+    void writeSummary(MenuRenderer& out, std::string_view label) const;
+
+    /**
+     * @param value A latency in nanoseconds.
+     * @return The index of the bucket holding it.
+     */
+    static int bucketIndex(uint64_t value)
+    {
+        if (value < static_cast<uint64_t>(SUB_BUCKET_COUNT))
+        {
+            return static_cast<int>(value);
+        }
+        int exponent = 63 - __builtin_clzll(value);
+        if (exponent >= MAX_EXPONENT)
+        {
+            return BUCKET_COUNT - 1;
+        }
+        int shift = exponent - SUB_BUCKET_BITS;
+        return (shift + 1) * SUB_BUCKET_COUNT + static_cast<int>((value >> shift) - SUB_BUCKET_COUNT);
+    }
+
+    /**
+     * @param index A bucket index.
+     * @return The largest value that maps to that bucket.
+     */
+    static uint64_t bucketUpperBound(int index);
+
+private:
+    std::atomic<uint64_t> counts_[BUCKET_COUNT];
+};
+
+#endif // LATENCY_HISTOGRAM_HPP
@@ -0,0 +1,372 @@
+/**
+ * @file LoadGen.cpp
+ * @brief This file contains the load generator of the kitchen server, which measures requests/s and latency over its Unix-domain socket.
+ *
+ * Start a server first, e.g. `./main load Dishes.csv serve /tmp/kitchen.sock --exit-after 4`. Each client thread opens
+ * one connection and keeps up to `pipeline` requests in flight: it writes every request it may send with one write,
+ * then reads whatever responses have arrived. Requests are drawn from a seeded mix of orders (rows of the menu),
+ * serves (of menu dish names, so a dish loaded from the same menu or ordered by any client can be served), reports
+ * and queries (of the whole kitchen or one cuisine type). Equal order and serve weights keep a kitchen that starts
+ * full churning near its capacity, so both FULL and NOT_FOUND responses are expected.
+ *
+ * A request's latency runs from when it was queued for writing until its response was parsed, so it includes the
+ * time spent behind the requests ahead of it in the pipeline. The totals, the responses by status and the latency
+ * percentiles of each request type are printed at the end.
+ *
+ * Usage: ./loadgen [--socket PATH] [--menu FILE] [--clients N] [--requests N] [--pipeline N] [--mix ORDER:SERVE:REPORT:QUERY] [--seed S]
+ *
+ * @date October 17, 2026
+ * @author Kun Feng Wei
+ */
+
+#include "KitchenServer.hpp"
+#include "LatencyHistogram.hpp"
+#include "MenuRenderer.hpp"
+#include "OutputSink.hpp"
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct Options
+{
+    std::string socket = "/tmp/kitchen.sock";
+    std::string menu = "Dishes.csv";
+    int clients = 4;
+    long long requests = 100000;  // per client
+    int pipeline = 16;
+    int mix[KitchenServer::OPCODE_COUNT] = {45, 45, 1, 9};  // by opcode
+    unsigned long long seed = 1;
+};
+
+// A row of the menu and the dish name in it
+struct MenuRow
+{
+    std::string row;
+    std::string name;
+};
+
+// What one client measured
+struct ClientResult
+{
+    std::vector<LatencyHistogram> latency = std::vector<LatencyHistogram>(KitchenServer::OPCODE_COUNT);
+    long long statuses[KitchenServer::STATUS_COUNT] = {};
+    std::string error;
+};
+
+using Clock = std::chrono::steady_clock;
+
+static bool readMenu(const std::string& filename, std::vector<MenuRow>& menu)
+{
+    std::ifstream file(filename);
+    std::string line;
+    std::getline(file, line); // header
+    while (std::getline(file, line))
+    {
+        size_t name_begin = line.find(',');
+        size_t name_end = name_begin == std::string::npos ? std::string::npos : line.find(',', name_begin + 1);
+        if (name_end != std::string::npos)
+        {
+            menu.push_back({line, line.substr(name_begin + 1, name_end - name_begin - 1)});
+        }
+    }
+    return !menu.empty();
+}
+
+static int connectTo(const std::string& path, std::string& error)
+{
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path))
+    {
+        error = path + ": path too long";
+        return -1;
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size());
+    int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0 || ::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0)
+    {
+        error = path + ": " + std::strerror(errno);
+        if (fd >= 0)
+        {
+            ::close(fd);
+        }
+        return -1;
+    }
+    return fd;
+}
+
+static bool writeAll(int fd, const std::string& data)
+{
+    size_t offset = 0;
+    while (offset < data.size())
+    {
+        ssize_t count = ::send(fd, data.data() + offset, data.size() - offset, MSG_NOSIGNAL);
+        if (count < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (count <= 0)
+        {
+            return false;
+        }
+        offset += static_cast<size_t>(count);
+    }
+    return true;
+}
+
+static void runClient(const Options& options, const std::vector<MenuRow>& menu, int client, ClientResult& result)
+{
+    int fd = connectTo(options.socket, result.error);
+    if (fd < 0)
+    {
+        return;
+    }
+    std::mt19937_64 rng(options.seed * 1000003 + client);
+    int mix_total = 0;
+    for (int weight : options.mix)
+    {
+        mix_total += weight;
+    }
+
+    // The requests in flight, by id modulo the pipeline depth
+    std::vector<Clock::time_point> sent_at(options.pipeline);
+    std::vector<int> sent_opcode(options.pipeline);
+    std::string output, input, query_body;
+    char buffer[64 * 1024];
+    uint32_t next_id = 0, next_response = 0;
+    const uint32_t total = static_cast<uint32_t>(options.requests);
+
+    while (next_response < total)
+    {
+        output.clear();
+        while (next_id < total && next_id - next_response < static_cast<uint32_t>(options.pipeline))
+        {
+            int pick = static_cast<int>(rng() % mix_total);
+            int opcode = 0;
+            while (pick >= options.mix[opcode])
+            {
+                pick -= options.mix[opcode++];
+            }
+            size_t slot = next_id % options.pipeline;
+            if (opcode == KitchenServer::NEW_ORDER)
+            {
+                const std::string& row = menu[rng() % menu.size()].row;
+                KitchenServer::appendFrame(output, opcode, next_id, row.data(), row.size());
+            }
+            else if (opcode == KitchenServer::SERVE_DISH)
+            {
+                const std::string& name = menu[rng() % menu.size()].name;
+                KitchenServer::appendFrame(output, opcode, next_id, name.data(), name.size());
+            }
+            else if (opcode == KitchenServer::QUERY)
+            {
+                // Half of the queries are for the whole kitchen, the rest for one cuisine type
+                const size_t cuisine_types = std::size(Dish::CUISINE_TYPE_INFO);
+                size_t cuisine = rng() % (2 * cuisine_types);
+                query_body = cuisine < cuisine_types ? "" : std::string(Dish::CUISINE_TYPE_INFO[cuisine - cuisine_types].token);
+                KitchenServer::appendFrame(output, opcode, next_id, query_body.data(), query_body.size());
+            }
+            else
+            {
+                KitchenServer::appendFrame(output, opcode, next_id, nullptr, 0);
+            }
+            sent_opcode[slot] = opcode;
+            sent_at[slot] = Clock::now();
+            next_id++;
+        }
+        if (!output.empty() && !writeAll(fd, output))
+        {
+            result.error = options.socket + ": " + std::strerror(errno);
+            break;
+        }
+
+        ssize_t count = ::read(fd, buffer, sizeof(buffer));
+        if (count <= 0)
+        {
+            if (count < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            result.error = count == 0 ? "the server closed the connection" : options.socket + ": " + std::strerror(errno);
+            break;
+        }
+        input.append(buffer, static_cast<size_t>(count));
+        Clock::time_point now = Clock::now();
+        size_t offset = 0;
+        KitchenServer::Frame frame;
+        long size;
+        while ((size = KitchenServer::parseFrame(input.data() + offset, input.size() - offset, frame)) > 0)
+        {
+            size_t slot = next_response % options.pipeline;
+            if (frame.id != next_response || frame.code >= KitchenServer::STATUS_COUNT)
+            {
+                result.error = "unexpected response " + std::to_string(frame.id) + " (code " + std::to_string(frame.code) +
+                               ") to request " + std::to_string(next_response);
+                break;
+            }
+            result.latency[sent_opcode[slot]].record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now - sent_at[slot]).count()));
+            result.statuses[frame.code]++;
+            offset += static_cast<size_t>(size);
+            next_response++;
+        }
+        if (size < 0)
+        {
+            result.error = "malformed response frame";
+        }
+        if (!result.error.empty())
+        {
+            break;
+        }
+        input.erase(0, offset);
+    }
+    ::close(fd);
+}
+
+static bool parseMix(const char* text, int* mix)
+{
+    char extra;
+    if (std::sscanf(text, "%d:%d:%d:%d%c", &mix[0], &mix[1], &mix[2], &mix[3], &extra) != KitchenServer::OPCODE_COUNT)
+    {
+        return false;
+    }
+    int total = 0;
+    for (int opcode = 0; opcode < KitchenServer::OPCODE_COUNT; opcode++)
+    {
+        if (mix[opcode] < 0)
+        {
+            return false;
+        }
+        total += mix[opcode];
+    }
+    return total > 0;
+}
+
+static bool parseOptions(int argc, char* argv[], Options& options)
+{
+    bool valid = true;
+    for (int i = 1; i < argc && valid; i++)
+    {
+        bool has_value = i + 1 < argc;
+        if (std::strcmp(argv[i], "--socket") == 0 && has_value)
+        {
+            options.socket = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--menu") == 0 && has_value)
+        {
+            options.menu = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--clients") == 0 && has_value)
+        {
+            options.clients = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--requests") == 0 && has_value)
+        {
+            options.requests = std::atoll(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--pipeline") == 0 && has_value)
+        {
+            options.pipeline = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--mix") == 0 && has_value)
+        {
+            valid = parseMix(argv[++i], options.mix);
+        }
+        else if (std::strcmp(argv[i], "--seed") == 0 && has_value)
+        {
+            options.seed = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else
+        {
+            valid = false;
+        }
+    }
+    if (!valid || options.clients < 1 || options.requests < 1 || options.requests > 4000000000LL || options.pipeline < 1)
+    {
+        std::cerr << "Usage: " << argv[0]
+                  << " [--socket PATH] [--menu FILE] [--clients N] [--requests N] [--pipeline N] [--mix ORDER:SERVE:REPORT:QUERY] [--seed S]" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (!parseOptions(argc, argv, options))
+    {
+        return 1;
+    }
+    std::vector<MenuRow> menu;
+    if (!readMenu(options.menu, menu))
+    {
+        std::cerr << options.menu << ": no dishes" << std::endl;
+        return 1;
+    }
+
+    std::vector<ClientResult> results(options.clients);
+    std::vector<std::thread> clients;
+    Clock::time_point begin = Clock::now();
+    for (int client = 0; client < options.clients; client++)
+    {
+        clients.emplace_back(runClient, std::cref(options), std::cref(menu), client, std::ref(results[client]));
+    }
+    for (std::thread& client : clients)
+    {
+        client.join();
+    }
+    double elapsed_ms = std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+
+    std::vector<LatencyHistogram> latency(KitchenServer::OPCODE_COUNT);
+    LatencyHistogram all;
+    long long statuses[KitchenServer::STATUS_COUNT] = {};
+    for (const ClientResult& result : results)
+    {
+        if (!result.error.empty())
+        {
+            std::cerr << "loadgen: " << result.error << std::endl;
+            return 1;
+        }
+        for (int opcode = 0; opcode < KitchenServer::OPCODE_COUNT; opcode++)
+        {
+            latency[opcode].merge(result.latency[opcode]);
+            all.merge(result.latency[opcode]);
+        }
+        for (int status = 0; status < KitchenServer::STATUS_COUNT; status++)
+        {
+            statuses[status] += result.statuses[status];
+        }
+    }
+
+    long long total = options.requests * options.clients;
+    MenuRenderer out;
+    out.append("loadgen: ").appendInt(options.clients).append(" clients x ").appendInt(options.requests).append(" requests, pipeline ");
+    out.appendInt(options.pipeline).append(": ").appendInt(total).append(" requests in ").appendFixed(elapsed_ms, 1).append(" ms (");
+    out.appendFixed(elapsed_ms > 0 ? total / elapsed_ms * 1000.0 : 0.0, 0).append(" requests/s)\n");
+    out.append("responses:");
+    for (int status = 0; status < KitchenServer::STATUS_COUNT; status++)
+    {
+        out.append(' ').append(KitchenServer::STATUS_INFO[status].token).append('=').appendInt(statuses[status]);
+    }
+    out.append('\n');
+    for (int opcode = 0; opcode < KitchenServer::OPCODE_COUNT; opcode++)
+    {
+        latency[opcode].writeSummary(out, KitchenServer::OPCODE_INFO[opcode].token);
+    }
+    all.writeSummary(out, "all");
+    StreamSink console(std::cout);
+    out.emit(console);
+    return 0;
+}
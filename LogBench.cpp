@@ -0,0 +1,227 @@
+/**
+ * @file LogBench.cpp
+ * @brief This file contains the order log benchmark, which measures OrderLog appends with group commit and the replay that rebuilds a kitchen.
+ *
+ * A kitchen is loaded from a menu and journaled to a fresh log. A seeded stream of orders (copies of menu dishes) and
+ * serves (random dishes) is applied until the requested number of records was logged, so the kitchen hovers around
+ * its capacity the way a busy service does. The append phase reports records/s, bytes and the number of writes and
+ * syncs group commit needed. The log is then closed and opened again into an empty kitchen; the replay phase reports
+ * records/s and checks that the rebuilt kitchen exports exactly the same CSV as the original.
+ *
+ * Usage: ./logbench [--menu FILE] [--records N] [--group N] [--group-ms MS] [--no-sync] [--snapshot-every N] [--path FILE]
+ *
+ * @date October 17, 2026
+ * @author Kun Feng Wei
+ */
+
+#include "OrderLog.hpp"
+#include "Appetizer.hpp"
+#include "MainCourse.hpp"
+#include "Dessert.hpp"
+#include "MenuCursor.hpp"
+#include "MenuRenderer.hpp"
+#include "OutputSink.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+struct Options
+{
+    std::string menu = "Dishes.csv";
+    long long records = 1000000;
+    int group = 64;
+    int group_ms = 5;
+    bool sync = true;
+    long long snapshot_every = 0;
+    std::string path = "logbench.log";
+};
+
+using Clock = std::chrono::steady_clock;
+
+static double elapsedMs(Clock::time_point begin, Clock::time_point end)
+{
+    return std::chrono::duration<double, std::milli>(end - begin).count();
+}
+
+static Dish* copyDish(const Dish& dish)
+{
+    if (const Appetizer* appetizer = dynamic_cast<const Appetizer*>(&dish))
+    {
+        return new Appetizer(*appetizer);
+    }
+    if (const MainCourse* main_course = dynamic_cast<const MainCourse*>(&dish))
+    {
+        return new MainCourse(*main_course);
+    }
+    return new Dessert(dynamic_cast<const Dessert&>(dish));
+}
+
+static std::string exportCsv(const Kitchen& kitchen)
+{
+    StringSink sink;
+    kitchen.exportCsv(sink);
+    return sink.str();
+}
+
+static void removeFiles(const std::string& path)
+{
+    std::remove(path.c_str());
+    std::remove((path + ".snapshot").c_str());
+}
+
+static bool parseOptions(int argc, char* argv[], Options& options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        bool has_value = i + 1 < argc;
+        if (std::strcmp(argv[i], "--menu") == 0 && has_value)
+        {
+            options.menu = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--records") == 0 && has_value)
+        {
+            options.records = std::atoll(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--group") == 0 && has_value)
+        {
+            options.group = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--group-ms") == 0 && has_value)
+        {
+            options.group_ms = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--no-sync") == 0)
+        {
+            options.sync = false;
+        }
+        else if (std::strcmp(argv[i], "--snapshot-every") == 0 && has_value)
+        {
+            options.snapshot_every = std::atoll(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--path") == 0 && has_value)
+        {
+            options.path = argv[++i];
+        }
+        else
+        {
+            options.records = 0; // reported below
+            break;
+        }
+    }
+    if (options.records < 1 || options.group < 1 || options.group_ms < 0 || options.snapshot_every < 0)
+    {
+        std::cerr << "Usage: " << argv[0]
+                  << " [--menu FILE] [--records N] [--group N] [--group-ms MS] [--no-sync] [--snapshot-every N] [--path FILE]" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (!parseOptions(argc, argv, options))
+    {
+        return 1;
+    }
+    std::unique_ptr<Kitchen> kitchen(new Kitchen(options.menu));
+    std::vector<const Dish*> menu;
+    MenuCursor cursor(*kitchen);
+    while (const Dish* dish = cursor.nextDish())
+    {
+        menu.push_back(dish);
+    }
+    if (menu.empty())
+    {
+        std::cerr << options.menu << ": no dishes" << std::endl;
+        return 1;
+    }
+    std::vector<std::unique_ptr<Dish>> templates;
+    for (const Dish* dish : menu)
+    {
+        templates.emplace_back(copyDish(*dish));
+    }
+
+    removeFiles(options.path);
+    const OrderLog::Options log_options = {options.group, static_cast<double>(options.group_ms), options.sync, options.snapshot_every};
+    std::unique_ptr<OrderLog> log(new OrderLog(options.path, log_options));
+    OrderLog::Recovery recovery;
+    std::string error;
+    if (!log->open(*kitchen, recovery, error))
+    {
+        std::cerr << error << std::endl;
+        return 1;
+    }
+
+    // Orders while the kitchen has room, a serve two times in five, so it stays near its capacity
+    std::mt19937_64 rng(1);
+    std::vector<Dish*> live;  // the kitchen's dishes, in any order
+    for (const Dish* dish : menu)
+    {
+        live.push_back(const_cast<Dish*>(dish)); // the kitchen owns them; the cursor only hands out const pointers
+    }
+    Clock::time_point append_begin = Clock::now();
+    while (log->counters().records < options.records && log->error().empty())
+    {
+        int size = kitchen->getCurrentSize();
+        if (size == Kitchen::getCapacity() || (size > 0 && rng() % 5 < 2))
+        {
+            size_t index = rng() % live.size();
+            Dish* dish = live[index];
+            live[index] = live.back();
+            live.pop_back();
+            kitchen->serveDish(dish);
+            delete dish;
+        }
+        else
+        {
+            live.push_back(copyDish(*templates[rng() % templates.size()]));
+            kitchen->newOrder(live.back());
+        }
+    }
+    log->commit();
+    Clock::time_point append_end = Clock::now();
+    if (!log->error().empty())
+    {
+        std::cerr << log->error() << std::endl;
+        return 1;
+    }
+    const OrderLog::Counters counters = log->counters();
+    const std::string expected = exportCsv(*kitchen);
+    log.reset();
+    kitchen.reset();
+
+    std::unique_ptr<Kitchen> rebuilt(new Kitchen());
+    OrderLog reopened(options.path, log_options);
+    if (!reopened.open(*rebuilt, recovery, error))
+    {
+        std::cerr << error << std::endl;
+        return 1;
+    }
+    long long replayed = 0;
+    for (int type = 0; type < OrderLog::RECORD_TYPE_COUNT; type++)
+    {
+        replayed += recovery.records[type];
+    }
+    bool verified = exportCsv(*rebuilt) == expected;
+
+    double append_ms = elapsedMs(append_begin, append_end);
+    MenuRenderer out;
+    out.append("append: ").appendInt(counters.records).append(" records in ").appendFixed(append_ms, 1).append(" ms (");
+    out.appendFixed(append_ms > 0 ? counters.records / append_ms * 1000.0 : 0.0, 0).append(" records/s), ");
+    out.appendInt(counters.commits).append(" commits, ").appendInt(counters.syncs).append(" syncs, ");
+    out.appendInt(counters.snapshots).append(" snapshots, ").appendFixed(counters.bytes / 1048576.0, 1).append(" MiB\n");
+    out.append("replay: ").appendInt(recovery.snapshot_dishes).append(" snapshot dishes and ").appendInt(replayed).append(" records in ");
+    out.appendFixed(recovery.elapsed_ms, 1).append(" ms (").appendFixed(recovery.elapsed_ms > 0 ? replayed / recovery.elapsed_ms * 1000.0 : 0.0, 0);
+    out.append(" records/s), ").append(verified ? "kitchen verified\n" : "MISMATCH: the rebuilt kitchen differs\n");
+    StreamSink console(std::cout);
+    out.emit(console);
+    removeFiles(options.path);
+    return verified ? 0 : 1;
+}
@@ -10,6 +10,7 @@
  */
 
 #include "MainCourse.hpp"
+#include "MenuRenderer.hpp"
 
 /**
  * Default constructor.
@@ -40,6 +41,7 @@ MainCourse::MainCourse(const std::string& name, const std::vector<std::string>&
  */
 void MainCourse::setCookingMethod(const CookingMethod &cooking_method) {
     cooking_method_ = cooking_method;
+    markDirty();
 }
 
 /**
@@ -56,6 +58,7 @@ MainCourse::CookingMethod MainCourse::getCookingMethod() const {
  */
 void MainCourse::setProteinType(const std::string& protein_type) {
     protein_type_ = protein_type;
+    markDirty();
 }
 
 /**
@@ -72,6 +75,7 @@ std::string MainCourse::getProteinType() const {
  */
 void MainCourse::addSideDish(const SideDish& side_dish) {
     side_dishes_.push_back(side_dish);
+    markDirty();
 }
 
 /**
@@ -88,6 +92,7 @@ std::vector<MainCourse::SideDish> MainCourse::getSideDishes() const {
  */
 void MainCourse::setGlutenFree(const bool &gluten_free) {
     gluten_free_ = gluten_free;
+    markDirty();
 }
 
 /**
@@ -98,11 +103,12 @@ bool MainCourse::isGlutenFree() const {
 }
 
 /**
- * Displays the main course's details.
- * @post Outputs the main course's details, including name, ingredients,
+ * Appends the main course's details to a renderer's buffer.
+ * @param out The renderer whose buffer receives the text.
+ * @post Appends the main course's details, including name, ingredients,
 preparation time, price, cuisine type, cooking method, protein type,
-side dishes, and gluten-free status to the standard output.
- * The information must be displayed in the following format:
+side dishes, and gluten-free status.
+ * The information is appended in the following format:
  *
  * Dish Name: [Name of the dish]
  * Ingredients: [Comma-separated list of ingredients
@@ -115,93 +121,103 @@ side dishes, and gluten-free status to the standard output.
 Vegetables])
  * Gluten-Free: [Yes/No]
  */
-void MainCourse::display() const
+void MainCourse::render(MenuRenderer& out) const
 {
-    Dish::display();
+    Dish::render(out);
 
-    std::cout << "Cooking Method: ";
-    if (cooking_method_ == 0)
-    {
-        std::cout << "Grilled" << std::endl;
-    }
-    if (cooking_method_ == 1)
-    {
-        std::cout << "Baked" << std::endl;
-    }
-    if (cooking_method_ == 2)
+    out.append("Cooking Method: ").append(enumInfo(COOKING_METHOD_INFO, cooking_method_, GRILLED).display_name).append('\n');
+    out.append("Protein Type: ").append(protein_type_).append('\n');
+
+    out.append("Side Dishes: ");
+    for (size_t i = 0; i < side_dishes_.size(); i++)
     {
-        std::cout << "Boiled" << std::endl;
+        out.append(side_dishes_[i].name);
+        out.append(" (Category: ").append(enumInfo(CATEGORY_INFO, side_dishes_[i].category, GRAIN).display_name).append(')');
+
+        if (i < side_dishes_.size() - 1)
+        {
+            out.append(", ");
+        }
     }
-    if (cooking_method_ == 3)
+    out.append('\n');
+
+    out.append("Gluten-Free: ").append(gluten_free_ ? "Yes" : "No").append('\n');
+}
+
+/**
+ * Appends the main course as one CSV row in the Dishes.csv schema, with DishType MAINCOURSE.
+ * @param out The renderer whose buffer receives the text.
+ * @post Appends the row and its line break. AdditionalAttributes are written as COOKING_METHOD;protein;Side:CATEGORY|Side:CATEGORY;gluten_free.
+ */
+void MainCourse::writeCsv(MenuRenderer& out) const
+{
+    out.append("MAINCOURSE,");
+    Dish::writeCsv(out);
+
+    // The protein and side dish names are free text, so the column may need quoting, and it is also quoted
+    // whenever one of them is escaped, since the loader only honors escapes in a quoted field
+    bool needs_quotes = protein_type_.find_first_of(",\"\r\n;|:\\") != std::string::npos;
+    for (size_t i = 0; i < side_dishes_.size() && !needs_quotes; i++)
     {
-        std::cout << "Fried" << std::endl;
+        needs_quotes = side_dishes_[i].name.find_first_of(",\"\r\n;|:\\") != std::string::npos;
     }
-    if (cooking_method_ == 4)
+    if (!needs_quotes)
     {
-        std::cout << "Steamed" << std::endl;
+        writeCsvAttributes(out);
     }
-    if (cooking_method_ == 5)
+    else
     {
-        std::cout << "Raw" << std::endl;
+        MenuRenderer attributes;
+        writeCsvAttributes(attributes);
+        out.appendCsvField(attributes.str(), true);
     }
+    out.append('\n');
+}
 
-    std::cout << "Protein Type: " << getProteinType() << std::endl;
-
-    std::vector<MainCourse::SideDish> side_dishes = getSideDishes();
-    std::cout << "Side Dishes: ";
-    for (size_t i = 0; i < side_dishes.size(); i++)
+/**
+ * Appends the main course as one JSON object with "type" set to "MAINCOURSE".
+ * @param out The renderer whose buffer receives the text.
+ * @post Appends the object, including the "cooking_method", "protein_type", "side_dishes" and "gluten_free" members.
+ */
+void MainCourse::writeJson(MenuRenderer& out) const
+{
+    out.append("{\"type\":\"MAINCOURSE\"");
+    Dish::writeJson(out);
+    out.append(",\"cooking_method\":\"").append(enumInfo(COOKING_METHOD_INFO, cooking_method_, GRILLED).token).append('"');
+    out.append(",\"protein_type\":").appendJsonString(protein_type_);
+    out.append(",\"side_dishes\":[");
+    for (size_t i = 0; i < side_dishes_.size(); i++)
     {
-        std::cout << side_dishes[i].name;
-        if (side_dishes[i].category == GRAIN)
-        {
-            std::cout << " (Category: Grain)";
-        }
-        if (side_dishes[i].category == PASTA)
-        {
-            std::cout << " (Category: Pasta)";
-        }
-        if (side_dishes[i].category == LEGUME)
-        {
-            std::cout << " (Category: Legume)";
-        }
-        if (side_dishes[i].category == BREAD)
-        {
-            std::cout << " (Category: Bread)";
-        }
-        if (side_dishes[i].category == SALAD)
-        {
-            std::cout << " (Category: Salad)";
-        }
-        if (side_dishes[i].category == SOUP)
-        {
-            std::cout << " (Category: Soup)";
-        }
-        if (side_dishes[i].category == STARCHES)
+        if (i != 0)
         {
-            std::cout << " (Category: Starches)";
-        }
-        if (side_dishes[i].category == VEGETABLE)
-        {
-            std::cout << " (Category: Vegetable)";
-        }
-
-        if (i < side_dishes.size() - 1)
-        {
-            std::cout << ", ";
+            out.append(',');
         }
+        out.append("{\"name\":").appendJsonString(side_dishes_[i].name);
+        out.append(",\"category\":\"").append(enumInfo(CATEGORY_INFO, side_dishes_[i].category, GRAIN).token).append("\"}");
     }
+    out.append(']');
+    out.append(",\"gluten_free\":").appendBool(gluten_free_);
+    out.append('}');
+}
 
-    std::cout << std::endl;
-
-    std::cout << "Gluten-Free: ";
-    if (isGlutenFree() == 1)
-    {
-        std::cout << "Yes" << std::endl;
-    }
-    else
+/**
+ * Appends the unquoted AdditionalAttributes column of the CSV row; the protein type and side dish names are
+ * escaped with MenuRenderer::appendCsvItem(), so the caller quotes the column if any of them needed it.
+ * @param out The renderer whose buffer receives the text.
+ */
+void MainCourse::writeCsvAttributes(MenuRenderer& out) const
+{
+    out.append(enumInfo(COOKING_METHOD_INFO, cooking_method_, GRILLED).token).append(';');
+    out.appendCsvItem(protein_type_).append(';');
+    for (size_t i = 0; i < side_dishes_.size(); i++)
     {
-        std::cout << "No" << std::endl;
+        if (i != 0)
+        {
+            out.append('|');
+        }
+        out.appendCsvItem(side_dishes_[i].name).append(':').append(enumInfo(CATEGORY_INFO, side_dishes_[i].category, GRAIN).token);
     }
+    out.append(';').appendBool(gluten_free_);
 }
 
 /**
@@ -234,6 +250,8 @@ involves gluten.
  */
 void MainCourse::dietaryAccommodations(const DietaryRequest& request)
 {
+    markDirty();
+
 // - If `request.vegetarian` is true:
 //     - Changes `protein_type_` to "Tofu".
 //     - Searches `ingredients_` for any non-vegetarian
@@ -268,6 +286,7 @@ void MainCourse::dietaryAccommodations(const DietaryRequest& request)
                     {
                         ingredients.erase(ingredients.begin() + i);
                         i--;
+                        break;
                     }
                     substitution_count++;
                 }
@@ -294,6 +313,7 @@ void MainCourse::dietaryAccommodations(const DietaryRequest& request)
                 {
                     ingredients.erase(ingredients.begin() + i);
                     i--;
+                    break;
                 }
             }
         }
@@ -310,16 +330,12 @@ void MainCourse::dietaryAccommodations(const DietaryRequest& request)
     {
         gluten_free_ = true;
         std::vector<SideDish> side_dishes = MainCourse::getSideDishes();
-        std::vector<Category> gluten_side_dishes_category = {GRAIN, PASTA, BREAD, STARCHES};
         for (size_t i = 0; i < side_dishes.size(); i++)
         {
-            for (size_t j = 0; j < gluten_side_dishes_category.size(); j++)
+            if (enumInfo(CATEGORY_INFO, side_dishes[i].category, GRAIN).properties & CONTAINS_GLUTEN)
             {
-                if (side_dishes[i].category == gluten_side_dishes_category[j])
-                {
-                    side_dishes.erase(side_dishes.begin() + i);
-                    i--;
-                }
+                side_dishes.erase(side_dishes.begin() + i);
+                i--;
             }
         }
         MainCourse::side_dishes_ = side_dishes;
@@ -35,6 +35,37 @@ public:
      */
     enum Category { GRAIN, PASTA, LEGUME, BREAD, SALAD, SOUP, STARCHES, VEGETABLE };
 
+    /**
+     * Metadata of each cooking method, indexed by CookingMethod.
+     */
+    static constexpr EnumInfo<CookingMethod> COOKING_METHOD_INFO[] = {
+        {GRILLED, "GRILLED", "Grilled", 0},
+        {BAKED, "BAKED", "Baked", 0},
+        {BOILED, "BOILED", "Boiled", 0},
+        {FRIED, "FRIED", "Fried", 0},
+        {STEAMED, "STEAMED", "Steamed", 0},
+        {RAW, "RAW", "Raw", 0},
+    };
+
+    /**
+     * Property bit of CATEGORY_INFO: side dishes of the category contain gluten.
+     */
+    static constexpr unsigned CONTAINS_GLUTEN = 1u << 0;
+
+    /**
+     * Metadata of each side dish category, indexed by Category.
+     */
+    static constexpr EnumInfo<Category> CATEGORY_INFO[] = {
+        {GRAIN, "GRAIN", "Grain", CONTAINS_GLUTEN},
+        {PASTA, "PASTA", "Pasta", CONTAINS_GLUTEN},
+        {LEGUME, "LEGUME", "Legume", 0},
+        {BREAD, "BREAD", "Bread", CONTAINS_GLUTEN},
+        {SALAD, "SALAD", "Salad", 0},
+        {SOUP, "SOUP", "Soup", 0},
+        {STARCHES, "STARCHES", "Starches", CONTAINS_GLUTEN},
+        {VEGETABLE, "VEGETABLE", "Vegetable", 0},
+    };
+
     /**
      * @struct SideDish
      * @brief Represents a side dish associated with the main course.
@@ -113,11 +144,12 @@ public:
     bool isGlutenFree() const;
 
 /**
- * Displays the main course's details.
- * @post Outputs the main course's details, including name, ingredients,
+ * Appends the main course's details to a renderer's buffer.
+ * @param out The renderer whose buffer receives the text.
+ * @post Appends the main course's details, including name, ingredients,
 preparation time, price, cuisine type, cooking method, protein type,
-side dishes, and gluten-free status to the standard output.
- * The information must be displayed in the following format:
+side dishes, and gluten-free status.
+ * The information is appended in the following format:
  *
  * Dish Name: [Name of the dish]
  * Ingredients: [Comma-separated list of ingredients
@@ -130,7 +162,21 @@ side dishes, and gluten-free status to the standard output.
 Vegetables])
  * Gluten-Free: [Yes/No]
  */
-    void display() const override;
+    void render(MenuRenderer& out) const override;
+
+    /**
+     * Appends the main course as one CSV row in the Dishes.csv schema, with DishType MAINCOURSE.
+     * @param out The renderer whose buffer receives the text.
+     * @post Appends the row and its line break. AdditionalAttributes are written as COOKING_METHOD;protein;Side:CATEGORY|Side:CATEGORY;gluten_free.
+     */
+    void writeCsv(MenuRenderer& out) const override;
+
+    /**
+     * Appends the main course as one JSON object with "type" set to "MAINCOURSE".
+     * @param out The renderer whose buffer receives the text.
+     * @post Appends the object, including the "cooking_method", "protein_type", "side_dishes" and "gluten_free" members.
+     */
+    void writeJson(MenuRenderer& out) const override;
 
 /**
  * Modifies the main course based on dietary accommodations.
@@ -170,6 +216,15 @@ private:
     std::string protein_type_; ///< The type of protein used in the main course.
     std::vector<SideDish> side_dishes_; ///< The side dishes served with the main course.
     bool gluten_free_; ///< Flag indicating if the main course is gluten-free.
+
+    /**
+     * Appends the unquoted AdditionalAttributes column of the CSV row.
+     * @param out The renderer whose buffer receives the text.
+     */
+    void writeCsvAttributes(MenuRenderer& out) const;
 };
 
+static_assert(isIndexedByValue(MainCourse::COOKING_METHOD_INFO), "COOKING_METHOD_INFO must be indexed by CookingMethod");
+static_assert(isIndexedByValue(MainCourse::CATEGORY_INFO), "CATEGORY_INFO must be indexed by Category");
+
 #endif // MAINCOURSE_HPP
\ No newline at end of file
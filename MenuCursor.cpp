@@ -0,0 +1,95 @@
+/**
+ * @file MenuCursor.cpp
+ * @brief This file contains the implementation of the MenuCursor class, which walks the dishes of a Kitchen one at a time.
+ *
+ * ArrayBag::remove() fills the hole it leaves with the last dish. When the hole is behind the cursor and the last
+ * dish is still ahead of it, that dish would be skipped, so the cursor keeps it aside and yields it later.
+ *
+ * @date October 17, 2026
+ * @author Kun Feng Wei
+ */
+
+#include "MenuCursor.hpp"
+#include "Kitchen.hpp"
+#include <algorithm>
+
+/**
+ * Parameterized constructor.
+ * @param kitchen A reference to the kitchen to walk.
+ * @post The cursor is positioned before the first dish and registered with the kitchen.
+ */
+MenuCursor::MenuCursor(const Kitchen& kitchen) : kitchen_(&kitchen), position_(0), moved_(), page_() {
+    kitchen_->attachCursor(this);
+}
+
+/**
+ * Destructor.
+ * @post Unregisters the cursor from its kitchen.
+ */
+MenuCursor::~MenuCursor() {
+    if (kitchen_ != nullptr) {
+        kitchen_->detachCursor(this);
+    }
+}
+
+bool MenuCursor::hasNext() const {
+    return kitchen_ != nullptr && (position_ < kitchen_->getCurrentSize() || !moved_.empty());
+}
+
+const Dish* MenuCursor::nextDish() {
+    if (kitchen_ == nullptr) {
+        return nullptr;
+    }
+    if (position_ < kitchen_->getCurrentSize()) {
+        return kitchen_->items_[position_++];
+    }
+    if (!moved_.empty()) {
+        Dish* dish = moved_.front();
+        moved_.erase(moved_.begin());
+        return dish;
+    }
+    return nullptr;
+}
+
+const std::string* MenuCursor::next() {
+    const Dish* dish = nextDish();
+    if (dish == nullptr) {
+        return nullptr;
+    }
+    return &dish->renderedText();
+}
+
+int MenuCursor::nextPage(OutputSink& out, int limit) {
+    page_.clear();
+    int count = 0;
+    while (count < limit) {
+        const std::string* text = next();
+        if (text == nullptr) {
+            break;
+        }
+        page_.append(*text);
+        count++;
+    }
+    page_.emit(out);
+    return count;
+}
+
+/**
+ * Called by the kitchen just before it removes a dish.
+ * @param removed_index The index of the dish being removed.
+ * @param last_index The index of the last dish, which the bag moves into `removed_index`.
+ */
+void MenuCursor::dishRemoved(int removed_index, int last_index) {
+    Dish* removed = kitchen_->items_[removed_index];
+    moved_.erase(std::remove(moved_.begin(), moved_.end(), removed), moved_.end());
+
+    // The last dish jumps from the unvisited part to the visited part, so keep it for later
+    if (removed_index < position_ && last_index >= position_) {
+        moved_.push_back(kitchen_->items_[last_index]);
+    }
+}
+
+void MenuCursor::kitchenDestroyed() {
+    kitchen_ = nullptr;
+    moved_.clear();
+}
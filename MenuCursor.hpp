@@ -0,0 +1,89 @@
+/**
+ * @file MenuCursor.hpp
+ * @brief This file contains the declaration of the MenuCursor class, which walks the dishes of a Kitchen one at a time.
+ *
+ * A MenuCursor yields the rendered text of the kitchen's dishes lazily, in kitchen order, a dish or a page at a time.
+ * The kitchen tells its open cursors about every dish it serves, so a cursor neither skips nor repeats a dish when
+ * dishes are served between two calls.
+ *
+ * @date October 17, 2026
+ * @author Kun Feng Wei
+ */
+
+#ifndef MENU_CURSOR_HPP
+#define MENU_CURSOR_HPP
+
+#include "OutputSink.hpp"
+#include "MenuRenderer.hpp"
+#include <string>
+#include <vector>
+
+class Dish;
+class Kitchen;
+
+class MenuCursor {
+public:
+    /**
+     * Parameterized constructor.
+     * @param kitchen A reference to the kitchen to walk.
+     * @post The cursor is positioned before the first dish and registered with the kitchen.
+     */
+    explicit MenuCursor(const Kitchen& kitchen);
+
+    MenuCursor(const MenuCursor&) = delete;
+    MenuCursor& operator=(const MenuCursor&) = delete;
+
+    /**
+     * Destructor.
+     * @post Unregisters the cursor from its kitchen.
+     */
+    ~MenuCursor();
+
+    /**
+     * @return True if there is at least one dish the cursor has not yielded yet, false otherwise.
+     */
+    bool hasNext() const;
+
+    /**
+     * Advances to the next dish.
+     * @return A pointer to the next dish, or nullptr if every dish has been yielded.
+     */
+    const Dish* nextDish();
+
+    /**
+     * Advances to the next dish and returns its display text.
+     * @return A pointer to the rendered text of the next dish, or nullptr if every dish has been yielded.
+     */
+    const std::string* next();
+
+    /**
+     * Writes the next page of dishes to a sink in a single write.
+     * @param out The sink that receives the page.
+     * @param limit The maximum number of dishes on the page.
+     * @return The number of dishes written; 0 once the cursor is exhausted.
+     */
+    int nextPage(OutputSink& out, int limit);
+
+private:
+    friend class Kitchen;
+
+    /**
+     * Called by the kitchen just before it removes a dish.
+     * @param removed_index The index of the dish being removed.
+     * @param last_index The index of the last dish, which the bag moves into `removed_index`.
+     */
+    void dishRemoved(int removed_index, int last_index);
+
+    /**
+     * Called by the kitchen when it is destroyed.
+     * @post The cursor is exhausted and no longer refers to the kitchen.
+     */
+    void kitchenDestroyed();
+
+    const Kitchen* kitchen_;
+    int position_;              // index of the next dish to yield
+    std::vector<Dish*> moved_;  // unvisited dishes the bag moved behind position_
+    MenuRenderer page_;
+};
+
+#endif // MENU_CURSOR_HPP
@@ -0,0 +1,710 @@
+/**
+ * @file MenuGen.cpp
+ * @brief This file contains menugen, a tool that writes synthetic menus of any size in the Dishes.csv format.
+ *
+ * The tool first learns a model from a sample CSV (Dishes.csv by default): the dish type mix, the cuisine frequencies,
+ * the dish name and ingredient vocabularies, the ingredient count, prep time and price distributions per dish type,
+ * and the format of every AdditionalAttributes column (integer range, boolean ratio, token set, or `|`-separated
+ * list of tokens). It then samples rows from that model with a seeded std::mt19937_64, so the same options always
+ * produce the same file.
+ *
+ * Options:
+ *   --input FILE            sample CSV to learn from (default Dishes.csv)
+ *   --output FILE           where to write the menu (default stdout)
+ *   --rows N                number of data rows (default 1000)
+ *   --seed S                random seed (default 1)
+ *   --duplicate-rate R      fraction of rows that repeat an earlier row exactly (default 0)
+ *   --malformed-rate R      fraction of rows that are deliberately broken (default 0)
+ *   --skew S                Zipf exponent applied to every learned frequency; 0 keeps the sample's mix,
+ *                           larger values concentrate rows on the most common values (default 0)
+ *   --describe              print the learned model to stderr
+ *
+ * Usage: ./menugen --rows 1000000 --seed 7 --malformed-rate 0.01 --output big_Dishes.csv
+ * Exit status: 0 on success, 1 if the sample or the output cannot be used, 2 on usage errors (an unknown option, a
+ * missing value, a negative or non-numeric row count, or a rate outside [0, 1]).
+ *
+ * @date October 17, 2026
+ * @author Kun Feng Wei
+ */
+
+#include "MenuRenderer.hpp"
+#include "OutputSink.hpp"
+#include "Money.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+static const char* CSV_HEADER = "DishType,Name,Ingredients,PreparationTime,Price,CuisineType,AdditionalAttributes\n";
+static const size_t FIELD_COUNT = 7;
+static const size_t RECENT_ROWS = 4096;    // rows kept as candidates for duplicates
+static const size_t FLUSH_BYTES = 1 << 16; // the buffer is written out whenever it grows past this
+
+struct Options
+{
+    std::string input = "Dishes.csv";
+    std::string output;
+    long long rows = 1000;
+    unsigned long long seed = 1;
+    double duplicate_rate = 0;
+    double malformed_rate = 0;
+    double skew = 0;
+    bool describe = false;
+};
+
+// Random helpers written out by hand: std::mt19937_64 is fully specified, the standard distributions are not,
+// and the output must be identical across standard libraries
+static double uniformReal(std::mt19937_64& rng)
+{
+    return static_cast<double>(rng() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static long long uniformInt(std::mt19937_64& rng, long long low, long long high)
+{
+    return low + static_cast<long long>(rng() % static_cast<unsigned long long>(high - low + 1));
+}
+
+/**
+ * A categorical distribution learned from counts. Values are ranked by frequency (ties by value) so skew can
+ * reweight them by rank.
+ */
+class Choice
+{
+public:
+    void add(const std::string& value)
+    {
+        counts_[value]++;
+    }
+
+    bool empty() const
+    {
+        return counts_.empty();
+    }
+
+    // Ranks the values and builds the cumulative weights, each multiplied by rank^-skew
+    void finish(double skew)
+    {
+        values_.clear();
+        cumulative_.clear();
+        std::vector<std::pair<int, std::string>> ranked;
+        for (const std::pair<const std::string, int>& entry : counts_)
+        {
+            ranked.push_back({-entry.second, entry.first});
+        }
+        std::sort(ranked.begin(), ranked.end());
+        double total = 0;
+        for (size_t rank = 0; rank < ranked.size(); rank++)
+        {
+            total += -ranked[rank].first * std::pow(static_cast<double>(rank + 1), -skew);
+            values_.push_back(ranked[rank].second);
+            cumulative_.push_back(total);
+        }
+    }
+
+    const std::string& sample(std::mt19937_64& rng) const
+    {
+        double target = uniformReal(rng) * cumulative_.back();
+        size_t index = std::upper_bound(cumulative_.begin(), cumulative_.end(), target) - cumulative_.begin();
+        return values_[std::min(index, values_.size() - 1)];
+    }
+
+    // Prints the most frequent values and their learned counts
+    void describe(std::ostream& out, size_t limit) const
+    {
+        std::vector<std::pair<int, std::string>> ranked;
+        for (const std::pair<const std::string, int>& entry : counts_)
+        {
+            ranked.push_back({-entry.second, entry.first});
+        }
+        std::sort(ranked.begin(), ranked.end());
+        for (size_t i = 0; i < ranked.size() && i < limit; i++)
+        {
+            out << (i == 0 ? "" : ", ") << ranked[i].second << " x" << -ranked[i].first;
+        }
+        if (ranked.size() > limit)
+        {
+            out << ", ... (" << ranked.size() << " values)";
+        }
+    }
+
+private:
+    std::map<std::string, int> counts_;
+    std::vector<std::string> values_;
+    std::vector<double> cumulative_;
+};
+
+/**
+ * A numeric distribution learned from observed values; samples an observed value and jitters it by up to 20%,
+ * clamped to the observed range.
+ */
+class NumericRange
+{
+public:
+    void add(long long value)
+    {
+        values_.push_back(value);
+    }
+
+    long long sample(std::mt19937_64& rng) const
+    {
+        long long low = *std::min_element(values_.begin(), values_.end());
+        long long high = *std::max_element(values_.begin(), values_.end());
+        long long base = values_[uniformInt(rng, 0, values_.size() - 1)];
+        long long jitter = base / 5;
+        long long value = jitter > 0 ? base + uniformInt(rng, -jitter, jitter) : base;
+        return std::max(low, std::min(high, value));
+    }
+
+    void describe(std::ostream& out) const
+    {
+        out << *std::min_element(values_.begin(), values_.end()) << ".." << *std::max_element(values_.begin(), values_.end());
+    }
+
+private:
+    std::vector<long long> values_;
+};
+
+// The learned format of one ';'-separated AdditionalAttributes column
+struct AttributeColumn
+{
+    enum Kind { INTEGER, BOOLEAN, TOKEN, LIST };
+
+    Kind kind = INTEGER;
+    std::vector<std::string> observed;
+    NumericRange integers;
+    double true_ratio = 0;
+    Choice tokens;           // TOKEN values, or LIST items
+    Choice list_lengths;     // LIST item counts, as text
+};
+
+// Everything learned about one dish type
+struct DishTypeModel
+{
+    std::vector<std::string> names;
+    Choice ingredient_counts;
+    NumericRange prep_times;
+    NumericRange prices;  // in cents
+    std::vector<AttributeColumn> attributes;
+};
+
+struct MenuModel
+{
+    Choice dish_types;
+    Choice cuisines;
+    Choice ingredients;
+    std::map<std::string, DishTypeModel> types;
+};
+
+static bool isInteger(const std::string& text)
+{
+    if (text.empty())
+    {
+        return false;
+    }
+    size_t start = text[0] == '-' ? 1 : 0;
+    return start < text.size() && text.find_first_not_of("0123456789", start) == std::string::npos;
+}
+
+static std::vector<std::string> split(const std::string& text, char delimiter)
+{
+    std::vector<std::string> parts;
+    size_t begin = 0;
+    while (true)
+    {
+        size_t end = text.find(delimiter, begin);
+        parts.push_back(text.substr(begin, end - begin));
+        if (end == std::string::npos)
+        {
+            return parts;
+        }
+        begin = end + 1;
+    }
+}
+
+// Splits one CSV line into fields, with the same quoting rules as the Kitchen loader
+static std::vector<std::string> splitCsvLine(const std::string& line)
+{
+    std::vector<std::string> fields(1);
+    bool quoted = false;
+    for (size_t i = 0; i < line.size(); i++)
+    {
+        char c = line[i];
+        if (quoted)
+        {
+            if (c == '"' && i + 1 < line.size() && line[i + 1] == '"')
+            {
+                fields.back().push_back('"');
+                i++;
+            }
+            else if (c == '"')
+            {
+                quoted = false;
+            }
+            else
+            {
+                fields.back().push_back(c);
+            }
+        }
+        else if (c == '"' && fields.back().empty())
+        {
+            quoted = true;
+        }
+        else if (c == ',')
+        {
+            fields.emplace_back();
+        }
+        else if (c != '\r')
+        {
+            fields.back().push_back(c);
+        }
+    }
+    return fields;
+}
+
+// Decides each attribute column's kind once every row of a dish type has been seen
+static void classifyAttributes(DishTypeModel& type, double skew)
+{
+    for (AttributeColumn& column : type.attributes)
+    {
+        bool all_integers = true, all_booleans = true, any_list = false;
+        for (const std::string& value : column.observed)
+        {
+            all_integers = all_integers && isInteger(value);
+            all_booleans = all_booleans && (value == "true" || value == "false");
+            any_list = any_list || value.find('|') != std::string::npos;
+        }
+        if (all_booleans)
+        {
+            column.kind = AttributeColumn::BOOLEAN;
+            long long trues = std::count(column.observed.begin(), column.observed.end(), "true");
+            column.true_ratio = static_cast<double>(trues) / column.observed.size();
+        }
+        else if (all_integers)
+        {
+            column.kind = AttributeColumn::INTEGER;
+            for (const std::string& value : column.observed)
+            {
+                column.integers.add(std::stoll(value));
+            }
+        }
+        else if (any_list)
+        {
+            column.kind = AttributeColumn::LIST;
+            for (const std::string& value : column.observed)
+            {
+                std::vector<std::string> items = split(value, '|');
+                column.list_lengths.add(std::to_string(items.size()));
+                for (const std::string& item : items)
+                {
+                    column.tokens.add(item);
+                }
+            }
+        }
+        else
+        {
+            column.kind = AttributeColumn::TOKEN;
+            for (const std::string& value : column.observed)
+            {
+                column.tokens.add(value);
+            }
+        }
+        column.tokens.finish(skew);
+        column.list_lengths.finish(0);
+    }
+}
+
+// Reads the sample CSV into a model; rows that do not parse are skipped
+static bool learn(const Options& options, MenuModel& model)
+{
+    std::ifstream input(options.input);
+    if (!input.is_open())
+    {
+        std::cerr << "Failed to open file: " << options.input << std::endl;
+        return false;
+    }
+    std::string line;
+    std::getline(input, line); // header
+    while (std::getline(input, line))
+    {
+        std::vector<std::string> fields = splitCsvLine(line);
+        Cents price_cents;
+        if (fields.size() != FIELD_COUNT || !isInteger(fields[3]) || !parseCents(fields[4], price_cents))
+        {
+            continue;
+        }
+        model.dish_types.add(fields[0]);
+        model.cuisines.add(fields[5]);
+        DishTypeModel& type = model.types[fields[0]];
+        type.names.push_back(fields[1]);
+        std::vector<std::string> ingredients = split(fields[2], ';');
+        type.ingredient_counts.add(std::to_string(ingredients.size()));
+        for (const std::string& ingredient : ingredients)
+        {
+            model.ingredients.add(ingredient);
+        }
+        type.prep_times.add(std::stoll(fields[3]));
+        type.prices.add(price_cents);
+        std::vector<std::string> attributes = split(fields[6], ';');
+        if (type.attributes.size() < attributes.size())
+        {
+            type.attributes.resize(attributes.size());
+        }
+        for (size_t i = 0; i < attributes.size(); i++)
+        {
+            type.attributes[i].observed.push_back(attributes[i]);
+        }
+    }
+    if (model.dish_types.empty())
+    {
+        std::cerr << "No usable rows in " << options.input << std::endl;
+        return false;
+    }
+    model.dish_types.finish(options.skew);
+    model.cuisines.finish(options.skew);
+    model.ingredients.finish(options.skew);
+    for (std::pair<const std::string, DishTypeModel>& entry : model.types)
+    {
+        entry.second.ingredient_counts.finish(0);
+        classifyAttributes(entry.second, options.skew);
+    }
+    return true;
+}
+
+static void describe(const MenuModel& model, std::ostream& out)
+{
+    out << "dish types: ";
+    model.dish_types.describe(out, 8);
+    out << "\ncuisines: ";
+    model.cuisines.describe(out, 8);
+    out << "\ningredients: ";
+    model.ingredients.describe(out, 8);
+    out << '\n';
+    static const char* KIND_NAMES[] = {"integer", "boolean", "token", "list"};
+    for (const std::pair<const std::string, DishTypeModel>& entry : model.types)
+    {
+        const DishTypeModel& type = entry.second;
+        out << entry.first << ": " << type.names.size() << " names, prep ";
+        type.prep_times.describe(out);
+        out << " min, price ";
+        type.prices.describe(out);
+        out << " cents, ingredients per dish ";
+        type.ingredient_counts.describe(out, 4);
+        out << '\n';
+        for (size_t i = 0; i < type.attributes.size(); i++)
+        {
+            const AttributeColumn& column = type.attributes[i];
+            out << "  attribute " << i << ": " << KIND_NAMES[column.kind];
+            if (column.kind == AttributeColumn::INTEGER)
+            {
+                out << ' ';
+                column.integers.describe(out);
+            }
+            else if (column.kind == AttributeColumn::BOOLEAN)
+            {
+                out << ' ' << column.true_ratio << " true";
+            }
+            else
+            {
+                out << ' ';
+                column.tokens.describe(out, 6);
+            }
+            out << '\n';
+        }
+    }
+}
+
+// Either a learned name or the first word of one learned name joined with the rest of another
+static std::string sampleName(const DishTypeModel& type, std::mt19937_64& rng)
+{
+    const std::string& first = type.names[uniformInt(rng, 0, type.names.size() - 1)];
+    if (uniformReal(rng) < 0.5)
+    {
+        return first;
+    }
+    const std::string& second = type.names[uniformInt(rng, 0, type.names.size() - 1)];
+    size_t first_space = first.find(' ');
+    size_t second_space = second.find(' ');
+    if (first_space == std::string::npos || second_space == std::string::npos)
+    {
+        return first;
+    }
+    return first.substr(0, first_space) + second.substr(second_space);
+}
+
+static std::string sampleAttribute(const AttributeColumn& column, std::mt19937_64& rng)
+{
+    switch (column.kind)
+    {
+        case AttributeColumn::INTEGER:
+            return std::to_string(column.integers.sample(rng));
+        case AttributeColumn::BOOLEAN:
+            return uniformReal(rng) < column.true_ratio ? "true" : "false";
+        case AttributeColumn::TOKEN:
+            return column.tokens.sample(rng);
+        default:
+        {
+            size_t length = std::stoul(column.list_lengths.sample(rng));
+            std::vector<std::string> items;
+            for (size_t attempt = 0; items.size() < length && attempt < length * 4; attempt++)
+            {
+                const std::string& item = column.tokens.sample(rng);
+                if (std::find(items.begin(), items.end(), item) == items.end())
+                {
+                    items.push_back(item);
+                }
+            }
+            std::string joined;
+            for (size_t i = 0; i < items.size(); i++)
+            {
+                joined += (i == 0 ? "" : "|") + items[i];
+            }
+            return joined;
+        }
+    }
+}
+
+// Samples the seven fields of one well-formed row
+static std::vector<std::string> sampleRow(const MenuModel& model, std::mt19937_64& rng)
+{
+    const std::string& dish_type = model.dish_types.sample(rng);
+    const DishTypeModel& type = model.types.at(dish_type);
+    std::vector<std::string> fields(FIELD_COUNT);
+    fields[0] = dish_type;
+    fields[1] = sampleName(type, rng);
+
+    size_t ingredient_count = std::stoul(type.ingredient_counts.sample(rng));
+    std::vector<std::string> ingredients;
+    for (size_t attempt = 0; ingredients.size() < ingredient_count && attempt < ingredient_count * 4; attempt++)
+    {
+        const std::string& ingredient = model.ingredients.sample(rng);
+        if (std::find(ingredients.begin(), ingredients.end(), ingredient) == ingredients.end())
+        {
+            ingredients.push_back(ingredient);
+        }
+    }
+    for (size_t i = 0; i < ingredients.size(); i++)
+    {
+        fields[2] += (i == 0 ? "" : ";") + ingredients[i];
+    }
+
+    fields[3] = std::to_string(type.prep_times.sample(rng));
+    MenuRenderer price;
+    price.appendPrice(static_cast<Cents>(type.prices.sample(rng)));
+    fields[4] = price.str();
+    fields[5] = model.cuisines.sample(rng);
+    for (size_t i = 0; i < type.attributes.size(); i++)
+    {
+        fields[6] += (i == 0 ? "" : ";") + sampleAttribute(type.attributes[i], rng);
+    }
+    return fields;
+}
+
+// Breaks a row in one of the ways real exports go wrong
+static void corruptRow(std::vector<std::string>& fields, std::mt19937_64& rng)
+{
+    switch (uniformInt(rng, 0, 4))
+    {
+        case 0: // truncated line
+            fields.resize(uniformInt(rng, 1, FIELD_COUNT - 1));
+            break;
+        case 1: // non-numeric preparation time
+            fields[3] = "about " + fields[3];
+            break;
+        case 2: // non-numeric price
+            fields[4] = "$" + fields[4] + "x";
+            break;
+        case 3: // unknown dish type
+            fields[0] = "SIDEDISH";
+            break;
+        default: // attributes missing their separators
+            fields[6].erase(std::remove(fields[6].begin(), fields[6].end(), ';'), fields[6].end());
+            break;
+    }
+}
+
+static void appendRow(MenuRenderer& out, const std::vector<std::string>& fields)
+{
+    for (size_t i = 0; i < fields.size(); i++)
+    {
+        if (i > 0)
+        {
+            out.append(',');
+        }
+        out.appendCsvField(fields[i]);
+    }
+    out.append('\n');
+}
+
+static void generate(const Options& options, const MenuModel& model, OutputSink& sink)
+{
+    std::mt19937_64 rng(options.seed);
+    std::vector<std::string> recent;
+    MenuRenderer out;
+    out.append(CSV_HEADER);
+    for (long long row = 0; row < options.rows; row++)
+    {
+        size_t row_start = out.str().size();
+        if (!recent.empty() && uniformReal(rng) < options.duplicate_rate)
+        {
+            out.append(recent[uniformInt(rng, 0, recent.size() - 1)]);
+        }
+        else
+        {
+            std::vector<std::string> fields = sampleRow(model, rng);
+            bool malformed = uniformReal(rng) < options.malformed_rate;
+            if (malformed)
+            {
+                corruptRow(fields, rng);
+            }
+            appendRow(out, fields);
+            if (!malformed)
+            {
+                std::string text = out.str().substr(row_start);
+                if (recent.size() < RECENT_ROWS)
+                {
+                    recent.push_back(text);
+                }
+                else
+                {
+                    recent[row % RECENT_ROWS] = text;
+                }
+            }
+        }
+        if (out.str().size() >= FLUSH_BYTES)
+        {
+            out.emit(sink);
+            out.clear();
+        }
+    }
+    out.emit(sink);
+}
+
+// Parses a whole decimal row count; false unless the text is a number >= 0 with nothing after it
+static bool parseRowCount(const char* text, long long& rows)
+{
+    char* end = nullptr;
+    errno = 0;
+    long long value = std::strtoll(text, &end, 10);
+    if (end == text || *end != '\0' || errno == ERANGE || value < 0)
+    {
+        return false;
+    }
+    rows = value;
+    return true;
+}
+
+// Parses a number; false unless the text is a finite number with nothing after it
+static bool parseNumber(const char* text, double& number)
+{
+    char* end = nullptr;
+    double value = std::strtod(text, &end);
+    if (end == text || *end != '\0' || !std::isfinite(value))
+    {
+        return false;
+    }
+    number = value;
+    return true;
+}
+
+// Parses a fraction of rows; false unless the text is a number in [0, 1]
+static bool parseRate(const char* text, double& rate)
+{
+    double value;
+    if (!parseNumber(text, value) || value < 0 || value > 1)
+    {
+        return false;
+    }
+    rate = value;
+    return true;
+}
+
+static bool parseOptions(int argc, char* argv[], Options& options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        std::string option = argv[i];
+        bool has_value = i + 1 < argc;
+        if (option == "--describe")
+        {
+            options.describe = true;
+        }
+        else if (option == "--input" && has_value)
+        {
+            options.input = argv[++i];
+        }
+        else if (option == "--output" && has_value)
+        {
+            options.output = argv[++i];
+        }
+        else if (option == "--rows" && has_value && parseRowCount(argv[i + 1], options.rows))
+        {
+            i++;
+        }
+        else if (option == "--seed" && has_value)
+        {
+            options.seed = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (option == "--duplicate-rate" && has_value && parseRate(argv[i + 1], options.duplicate_rate))
+        {
+            i++;
+        }
+        else if (option == "--malformed-rate" && has_value && parseRate(argv[i + 1], options.malformed_rate))
+        {
+            i++;
+        }
+        else if (option == "--skew" && has_value && parseNumber(argv[i + 1], options.skew))
+        {
+            i++;
+        }
+        else
+        {
+            std::cerr << "Usage: " << argv[0] << " [--input FILE] [--output FILE] [--rows N] [--seed S]"
+                      << " [--duplicate-rate R] [--malformed-rate R] [--skew S] [--describe]" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    MenuModel model;
+    if (!parseOptions(argc, argv, options))
+    {
+        return 2;
+    }
+    if (!learn(options, model))
+    {
+        return 1;
+    }
+    if (options.describe)
+    {
+        describe(model, std::cerr);
+    }
+
+    if (options.output.empty())
+    {
+        FileDescriptorSink sink(STDOUT_FILENO);
+        generate(options, model, sink);
+        return sink.good() ? 0 : 1;
+    }
+    std::ofstream output_file(options.output);
+    if (!output_file.is_open())
+    {
+        std::cerr << "Failed to open file: " << options.output << std::endl;
+        return 1;
+    }
+    StreamSink sink(output_file);
+    generate(options, model, sink);
+    return output_file.good() ? 0 : 1;
+}
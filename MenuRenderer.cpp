@@ -0,0 +1,235 @@
+/**
+ * @file MenuRenderer.cpp
+ * @brief This file contains the implementation of the MenuRenderer class, which formats dishes into a single reusable text buffer.
+ *
+ * Each dish appends its own lines through Dish::render(), and the collected text is emitted in one write.
+ *
+ * @date October 17, 2026
+ * @author Kun Feng Wei
+ */
+
+#include "MenuRenderer.hpp"
+#include "Dish.hpp"
+#include "Tracer.hpp"
+#include <charconv>
+
+// Rough size of one rendered dish, used to reserve the buffer up front
+static const int BYTES_PER_DISH = 320;
+
+/**
+ * Default constructor.
+ * Initializes an empty buffer.
+ */
+MenuRenderer::MenuRenderer() : buffer_() {
+}
+
+void MenuRenderer::clear() {
+    buffer_.clear();
+}
+
+const std::string& MenuRenderer::str() const {
+    return buffer_;
+}
+
+void MenuRenderer::swap(std::string& other) {
+    buffer_.swap(other);
+}
+
+MenuRenderer& MenuRenderer::append(std::string_view text) {
+    buffer_.append(text.data(), text.size());
+    return *this;
+}
+
+MenuRenderer& MenuRenderer::append(char c) {
+    buffer_.push_back(c);
+    return *this;
+}
+
+MenuRenderer& MenuRenderer::appendInt(int value) {
+    char digits[16];
+    std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value);
+    buffer_.append(digits, result.ptr - digits);
+    return *this;
+}
+
+MenuRenderer& MenuRenderer::appendInt(long long value) {
+    char digits[24];
+    std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value);
+    buffer_.append(digits, result.ptr - digits);
+    return *this;
+}
+
+MenuRenderer& MenuRenderer::appendFixed(double value, int precision) {
+    char digits[400]; // wide enough for any double in fixed notation
+    std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value, std::chars_format::fixed, precision);
+    buffer_.append(digits, result.ptr - digits);
+    return *this;
+}
+
+MenuRenderer& MenuRenderer::appendPrice(double price) {
+    return appendFixed(price, 2);
+}
+
+MenuRenderer& MenuRenderer::appendPrice(Cents cents) {
+    if (cents < 0) {
+        buffer_.push_back('-');
+    }
+    // Work with the magnitude as unsigned so INT64_MIN does not overflow
+    uint64_t magnitude = cents < 0 ? 0 - static_cast<uint64_t>(cents) : static_cast<uint64_t>(cents);
+    char digits[24];
+    std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), magnitude / 100);
+    buffer_.append(digits, result.ptr - digits);
+    unsigned fraction = static_cast<unsigned>(magnitude % 100);
+    buffer_.push_back('.');
+    buffer_.push_back(static_cast<char>('0' + fraction / 10));
+    buffer_.push_back(static_cast<char>('0' + fraction % 10));
+    return *this;
+}
+
+MenuRenderer& MenuRenderer::appendDouble(double value) {
+    char digits[32];
+    std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value);
+    buffer_.append(digits, result.ptr - digits);
+    return *this;
+}
+
+MenuRenderer& MenuRenderer::appendBool(bool value) {
+    return append(value ? "true" : "false");
+}
+
+MenuRenderer& MenuRenderer::appendCsvField(std::string_view field, bool always_quote) {
+    if (!always_quote && field.find_first_of(",\"\r\n") == std::string_view::npos) {
+        return append(field);
+    }
+    buffer_.push_back('"');
+    for (char c : field) {
+        if (c == '"') {
+            buffer_.push_back('"');
+        }
+        buffer_.push_back(c);
+    }
+    buffer_.push_back('"');
+    return *this;
+}
+
+MenuRenderer& MenuRenderer::appendCsvItem(std::string_view item) {
+    if (item.find_first_of(";|:\\") == std::string_view::npos) {
+        return append(item);
+    }
+    for (char c : item) {
+        if (c == ';' || c == '|' || c == ':' || c == '\\') {
+            buffer_.push_back('\\');
+        }
+        buffer_.push_back(c);
+    }
+    return *this;
+}
+
+MenuRenderer& MenuRenderer::appendJsonString(std::string_view text) {
+    static const char HEX_DIGITS[] = "0123456789abcdef";
+    buffer_.push_back('"');
+    size_t start = 0;
+    for (size_t i = 0; i < text.size(); i++) {
+        unsigned char c = static_cast<unsigned char>(text[i]);
+        if (c != '"' && c != '\\' && c >= 0x20) {
+            continue;
+        }
+        // Copy the clean run before the special character in one step
+        buffer_.append(text.data() + start, i - start);
+        start = i + 1;
+        switch (c) {
+            case '"': buffer_.append("\\\""); break;
+            case '\\': buffer_.append("\\\\"); break;
+            case '\n': buffer_.append("\\n"); break;
+            case '\r': buffer_.append("\\r"); break;
+            case '\t': buffer_.append("\\t"); break;
+            default:
+                buffer_.append("\\u00");
+                buffer_.push_back(HEX_DIGITS[c >> 4]);
+                buffer_.push_back(HEX_DIGITS[c & 0xF]);
+        }
+    }
+    buffer_.append(text.data() + start, text.size() - start);
+    buffer_.push_back('"');
+    return *this;
+}
+
+/**
+ * Formats a range of dishes into the buffer.
+ * @param dishes A pointer to the first `Dish*` of the range.
+ * @param count The number of dishes in the range.
+ * @post The buffer holds the display text of every dish in the range, in order.
+ *       Only dirty dishes are formatted again; the others contribute their cached text.
+ *       Any previous content is discarded.
+ */
+void MenuRenderer::renderMenu(Dish* const* dishes, int count) {
+    Tracer::Span trace_span("render.menu", "render");
+    buffer_.clear();
+    if (count <= 0) {
+        return;
+    }
+    buffer_.reserve(static_cast<size_t>(count) * BYTES_PER_DISH);
+    for (int i = 0; i < count; i++) {
+        append(dishes[i]->renderedText());
+    }
+}
+
+/**
+ * Formats only the dishes of a range that changed since they were last rendered.
+ * @param dishes A pointer to the first `Dish*` of the range.
+ * @param count The number of dishes in the range.
+ * @post The buffer holds the display text of every dirty dish in the range, in order,
+ *       and those dishes are no longer dirty. Any previous content is discarded.
+ * @return The number of dishes formatted.
+ */
+int MenuRenderer::renderChanged(Dish* const* dishes, int count) {
+    Tracer::Span trace_span("render.changed", "render");
+    buffer_.clear();
+    int changed = 0;
+    for (int i = 0; i < count; i++) {
+        if (dishes[i]->isDirty()) {
+            append(dishes[i]->renderedText());
+            changed++;
+        }
+    }
+    return changed;
+}
+
+/**
+ * Serializes a range of dishes as CSV in the same schema as Dishes.csv, header line included.
+ * @param dishes A pointer to the first `Dish*` of the range.
+ * @param count The number of dishes in the range.
+ * @post The buffer holds the CSV text. Any previous content is discarded.
+ */
+void MenuRenderer::renderCsv(Dish* const* dishes, int count) {
+    Tracer::Span trace_span("render.csv", "render");
+    buffer_.clear();
+    buffer_.reserve(static_cast<size_t>(count > 0 ? count : 0) * BYTES_PER_DISH / 2 + 128);
+    append("DishType,Name,Ingredients,PreparationTime,Price,CuisineType,AdditionalAttributes\n");
+    for (int i = 0; i < count; i++) {
+        dishes[i]->writeCsv(*this);
+    }
+}
+
+/**
+ * Serializes a range of dishes as a JSON array with one object per dish.
+ * @param dishes A pointer to the first `Dish*` of the range.
+ * @param count The number of dishes in the range.
+ * @post The buffer holds the JSON text. Any previous content is discarded.
+ */
+void MenuRenderer::renderJson(Dish* const* dishes, int count) {
+    Tracer::Span trace_span("render.json", "render");
+    buffer_.clear();
+    buffer_.reserve(static_cast<size_t>(count > 0 ? count : 0) * BYTES_PER_DISH + 8);
+    append('[');
+    for (int i = 0; i < count; i++) {
+        append(i == 0 ? "\n" : ",\n");
+        dishes[i]->writeJson(*this);
+    }
+    append("\n]\n");
+}
+
+void MenuRenderer::emit(OutputSink& out) const {
+    out.write(buffer_.data(), buffer_.size());
+    out.flush();
+}
@@ -0,0 +1,186 @@
+/**
+ * @file MenuRenderer.hpp
+ * @brief This file contains the declaration of the MenuRenderer class, which formats dishes into a single reusable text buffer.
+ *
+ * The MenuRenderer class collects the display text of one or many dishes in memory so that a whole menu
+ * can be written to the output with a single call instead of flushing after every line.
+ * Numbers are formatted with std::to_chars so no stream state is involved.
+ *
+ * @date October 17, 2026
+ * @author Kun Feng Wei
+ */
+
+#ifndef MENU_RENDERER_HPP
+#define MENU_RENDERER_HPP
+
+#include "Money.hpp"
+#include "OutputSink.hpp"
+#include <string>
+#include <string_view>
+
+class Dish;
+
+class MenuRenderer {
+public:
+    /**
+     * Default constructor.
+     * Initializes an empty buffer.
+     */
+    MenuRenderer();
+
+    /**
+     * Clears the buffer.
+     * @post The buffer is empty but keeps its capacity so it can be reused without reallocating.
+     */
+    void clear();
+
+    /**
+     * @return A const reference to the formatted text.
+     */
+    const std::string& str() const;
+
+    /**
+     * Exchanges the buffer with another string without copying.
+     * @param other The string whose contents and capacity are exchanged with the buffer.
+     */
+    void swap(std::string& other);
+
+    /**
+     * Appends a piece of text to the buffer.
+     * @param text The text to be appended.
+     * @return A reference to this renderer so calls can be chained.
+     */
+    MenuRenderer& append(std::string_view text);
+
+    /**
+     * Appends a single character to the buffer.
+     * @param c The character to be appended.
+     * @return A reference to this renderer so calls can be chained.
+     */
+    MenuRenderer& append(char c);
+
+    /**
+     * Appends an integer in decimal form.
+     * @param value The integer to be appended.
+     * @return A reference to this renderer so calls can be chained.
+     */
+    MenuRenderer& appendInt(int value);
+
+    /**
+     * Appends a 64-bit integer in decimal form.
+     * @param value The integer to be appended.
+     * @return A reference to this renderer so calls can be chained.
+     */
+    MenuRenderer& appendInt(long long value);
+
+    /**
+     * Appends a floating point value with a fixed number of decimal places (same as std::fixed with std::setprecision).
+     * @param value The value to be appended.
+     * @param precision The number of digits after the decimal point.
+     * @return A reference to this renderer so calls can be chained.
+     */
+    MenuRenderer& appendFixed(double value, int precision);
+
+    /**
+     * Appends a price formatted to two decimal places.
+     * @param price The price to be appended.
+     * @return A reference to this renderer so calls can be chained.
+     */
+    MenuRenderer& appendPrice(double price);
+
+    /**
+     * Appends a price held in cents with exactly two decimal places, e.g. 1299 as "12.99" and -5 as "-0.05".
+     * No floating point is involved, so the digits always match the stored amount.
+     * @param cents The price in cents.
+     * @return A reference to this renderer so calls can be chained.
+     */
+    MenuRenderer& appendPrice(Cents cents);
+
+    /**
+     * Appends a floating point value in its shortest form that reads back to the same double.
+     * @param value The value to be appended.
+     * @return A reference to this renderer so calls can be chained.
+     */
+    MenuRenderer& appendDouble(double value);
+
+    /**
+     * Appends "true" or "false".
+     * @param value The flag to be appended.
+     * @return A reference to this renderer so calls can be chained.
+     */
+    MenuRenderer& appendBool(bool value);
+
+    /**
+     * Appends a CSV field. The field is copied as is unless it contains a comma, a double quote or a line break,
+     * in which case it is wrapped in double quotes and inner quotes are doubled.
+     * @param field The field to be appended.
+     * @param always_quote True to quote the field even if it needs no quotes, e.g. because it holds escapes.
+     * @return A reference to this renderer so calls can be chained.
+     */
+    MenuRenderer& appendCsvField(std::string_view field, bool always_quote = false);
+
+    /**
+     * Appends one item of a list nested in a CSV field (an ingredient, a protein type, a side dish name).
+     * The separators of those lists, ';', '|' and ':', and the backslash are escaped with a backslash, which
+     * Kitchen(filename) removes again. Kitchen(filename) only honors escapes in a quoted field, so a field holding
+     * an escaped item must be appended with appendCsvField(field, true).
+     * @param item The item to be appended.
+     * @return A reference to this renderer so calls can be chained.
+     */
+    MenuRenderer& appendCsvItem(std::string_view item);
+
+    /**
+     * Appends a JSON string literal, including the surrounding double quotes.
+     * Quotes, backslashes and control characters are escaped; text without them is copied in one step.
+     * @param text The text to be appended.
+     * @return A reference to this renderer so calls can be chained.
+     */
+    MenuRenderer& appendJsonString(std::string_view text);
+
+    /**
+     * Formats a range of dishes into the buffer.
+     * @param dishes A pointer to the first `Dish*` of the range.
+     * @param count The number of dishes in the range.
+     * @post The buffer holds the display text of every dish in the range, in order.
+     *       Only dirty dishes are formatted again; the others contribute their cached text.
+     *       Any previous content is discarded.
+     */
+    void renderMenu(Dish* const* dishes, int count);
+
+    /**
+     * Formats only the dishes of a range that changed since they were last rendered.
+     * @param dishes A pointer to the first `Dish*` of the range.
+     * @param count The number of dishes in the range.
+     * @post The buffer holds the display text of every dirty dish in the range, in order,
+     *       and those dishes are no longer dirty. Any previous content is discarded.
+     * @return The number of dishes formatted.
+     */
+    int renderChanged(Dish* const* dishes, int count);
+
+    /**
+     * Serializes a range of dishes as CSV in the same schema as Dishes.csv, header line included.
+     * @param dishes A pointer to the first `Dish*` of the range.
+     * @param count The number of dishes in the range.
+     * @post The buffer holds the CSV text. Any previous content is discarded.
+     */
+    void renderCsv(Dish* const* dishes, int count);
+
+    /**
+     * Serializes a range of dishes as a JSON array with one object per dish.
+     * @param dishes A pointer to the first `Dish*` of the range.
+     * @param count The number of dishes in the range.
+     * @post The buffer holds the JSON text. Any previous content is discarded.
+     */
+    void renderJson(Dish* const* dishes, int count);
+
+    /**
+     * Writes the whole buffer to the given sink with a single write, followed by one flush.
+     * @param out The sink to write to.
+     */
+    void emit(OutputSink& out) const;
+
+private:
+    std::string buffer_;
+};
+
+#endif // MENU_RENDERER_HPP
@@ -0,0 +1,132 @@
+/**
+ * @file MinHeap.hpp
+ * @brief This file contains the MinHeap class template, an array-backed binary heap used as the simulator's event and waiting queues.
+ *
+ * The heap lives in one std::vector, so pushes and pops touch contiguous memory and, once the vector has grown to the
+ * largest size seen, never allocate. Sifting moves a hole instead of swapping, so each level costs one move rather
+ * than three. `Before(a, b)` must be a strict weak order; the item for which it holds against every other is on top.
+ * Items that compare equal leave in no particular order, so callers that need FIFO ties add a sequence number.
+ *
+ * @date October 17, 2026
+ * @author Kun Feng Wei
+ */
+
+#ifndef MIN_HEAP_HPP
+#define MIN_HEAP_HPP
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+template <class Item, class Before>
+class MinHeap {
+public:
+    /**
+     * Parameterized constructor.
+     * @param before The order; the smallest item is on top.
+     */
+    explicit MinHeap(Before before = Before()) : items_(), before_(before) {}
+
+    /**
+     * @return True if the heap holds no item.
+     */
+    bool empty() const
+    {
+        return items_.empty();
+    }
+
+    /**
+     * @return The number of items.
+     */
+    size_t size() const
+    {
+        return items_.size();
+    }
+
+    /**
+     * @return The smallest item.
+     * @pre The heap is not empty.
+     */
+    const Item& top() const
+    {
+        return items_.front();
+    }
+
+    /**
+     * Adds an item. O(log n).
+     * @param item The item to add.
+     */
+    void push(const Item& item)
+    {
+        items_.push_back(item);
+        size_t hole = items_.size() - 1;
+        while (hole > 0)
+        {
+            size_t parent = (hole - 1) / 2;
+            if (!before_(item, items_[parent]))
+            {
+                break;
+            }
+            items_[hole] = std::move(items_[parent]);
+            hole = parent;
+        }
+        items_[hole] = item;
+    }
+
+    /**
+     * Removes the smallest item. O(log n).
+     * @pre The heap is not empty.
+     */
+    void pop()
+    {
+        Item last = std::move(items_.back());
+        items_.pop_back();
+        if (items_.empty())
+        {
+            return;
+        }
+        size_t size = items_.size();
+        size_t hole = 0;
+        while (true)
+        {
+            size_t child = 2 * hole + 1;
+            if (child >= size)
+            {
+                break;
+            }
+            if (child + 1 < size && before_(items_[child + 1], items_[child]))
+            {
+                child++;
+            }
+            if (!before_(items_[child], last))
+            {
+                break;
+            }
+            items_[hole] = std::move(items_[child]);
+            hole = child;
+        }
+        items_[hole] = std::move(last);
+    }
+
+    /**
+     * Removes every item, keeping the allocated storage.
+     */
+    void clear()
+    {
+        items_.clear();
+    }
+
+    /**
+     * @param capacity The number of items to make room for.
+     */
+    void reserve(size_t capacity)
+    {
+        items_.reserve(capacity);
+    }
+
+private:
+    std::vector<Item> items_;
+    Before before_;
+};
+
+#endif // MIN_HEAP_HPP
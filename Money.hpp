@@ -0,0 +1,129 @@
+/**
+ * @file Money.hpp
+ * @brief This file contains the fixed-point helpers used to store and parse prices as integer cents.
+ *
+ * Prices are kept as a signed 64-bit count of cents. Sums of cents are exact and associative, so totals do not drift and
+ * do not depend on the order in which a loop (or a vectorized loop) adds them up. `double` values only appear at the
+ * edges: the Dish constructors and getPrice()/setPrice() convert with centsFromDouble() and centsToDouble().
+ *
+ * @date October 17, 2026
+ * @author Kun Feng Wei
+ */
+
+#ifndef MONEY_HPP
+#define MONEY_HPP
+
+#include <cmath>
+#include <cstdint>
+#include <string_view>
+
+/**
+ * An amount of money in cents, e.g. 1299 for $12.99.
+ */
+using Cents = int64_t;
+
+/**
+ * @param amount An amount in dollars.
+ * @return The amount rounded to the nearest cent, halves away from zero.
+ */
+inline Cents centsFromDouble(double amount)
+{
+    return static_cast<Cents>(std::llround(amount * 100.0));
+}
+
+/**
+ * @param cents An amount in cents.
+ * @return The amount in dollars; exact to the cent for any realistic price.
+ */
+inline double centsToDouble(Cents cents)
+{
+    return static_cast<double>(cents) / 100.0;
+}
+
+/**
+ * Divides a total in cents by a count, rounding to the nearest cent, halves away from zero.
+ * @param total The total in cents.
+ * @param count The number of items, greater than 0.
+ * @return The average in cents.
+ */
+inline Cents averageCents(Cents total, int64_t count)
+{
+    Cents half = count / 2;
+    return total >= 0 ? (total + half) / count : (total - half) / count;
+}
+
+/**
+ * Parses a decimal amount such as "12.99", "-3.5", "7" or " 4.125 " into cents without going through a double.
+ * Digits beyond the second decimal place are rounded, halves away from zero. Surrounding spaces, tabs and a trailing
+ * '\r' are ignored.
+ * @param text The text to parse.
+ * @param cents Receives the amount in cents if parsing succeeds; left unchanged otherwise.
+ * @return True if `text` is an optionally signed decimal number with at least one digit and nothing else, false otherwise.
+ */
+inline bool parseCents(std::string_view text, Cents& cents)
+{
+    size_t begin = 0, end = text.size();
+    while (begin < end && (text[begin] == ' ' || text[begin] == '\t'))
+    {
+        begin++;
+    }
+    while (end > begin && (text[end - 1] == ' ' || text[end - 1] == '\t' || text[end - 1] == '\r'))
+    {
+        end--;
+    }
+
+    bool negative = false;
+    if (begin < end && (text[begin] == '-' || text[begin] == '+'))
+    {
+        negative = text[begin] == '-';
+        begin++;
+    }
+
+    const Cents MAX_WHOLE = INT64_MAX / 100 - 1;
+    Cents whole = 0;
+    bool has_digits = false;
+    size_t i = begin;
+    for (; i < end && text[i] >= '0' && text[i] <= '9'; i++)
+    {
+        whole = whole * 10 + (text[i] - '0');
+        if (whole > MAX_WHOLE)
+        {
+            return false;
+        }
+        has_digits = true;
+    }
+
+    int fraction = 0;  // the first two decimal digits, scaled to cents
+    bool round_up = false;
+    if (i < end && text[i] == '.')
+    {
+        i++;
+        int place = 0;
+        for (; i < end && text[i] >= '0' && text[i] <= '9'; i++, place++)
+        {
+            if (place < 2)
+            {
+                fraction = fraction * 10 + (text[i] - '0');
+            }
+            else if (place == 2)
+            {
+                round_up = text[i] >= '5';
+            }
+            has_digits = true;
+        }
+        if (place == 1)
+        {
+            fraction *= 10;  // ".5" is 50 cents
+        }
+    }
+    if (!has_digits || i != end)
+    {
+        return false;
+    }
+
+    Cents amount = whole * 100 + fraction + (round_up ? 1 : 0);
+    cents = negative ? -amount : amount;
+    return true;
+}
+
+#endif // MONEY_HPP
@@ -0,0 +1,605 @@
+/**
+ * @file OrderLog.cpp
+ * @brief This file contains the implementation of the OrderLog class, an append-only binary journal of every Kitchen mutation.
+ *
+ * @date October 17, 2026
+ * @author Kun Feng Wei
+ */
+
+#include "OrderLog.hpp"
+#include "Appetizer.hpp"
+#include "Dessert.hpp"
+#include "MainCourse.hpp"
+#include "WireFormat.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cerrno>
+#include <cstring>
+#include <exception>
+#include <fcntl.h>
+#include <memory>
+#include <string_view>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <unordered_map>
+
+namespace {
+
+const char LOG_MAGIC[4] = {'K', 'L', 'O', 'G'};
+const char SNAPSHOT_MAGIC[4] = {'K', 'S', 'N', 'P'};
+const uint32_t FORMAT_VERSION = 1;
+const size_t HEADER_SIZE = 16;
+const size_t RECORD_PREFIX = 8;                 // length and CRC
+const uint32_t MAX_RECORD_LENGTH = 1u << 20;    // anything longer is a corrupt length field
+const size_t PROTOTYPE_LIMIT = 4096;            // distinct rows cached during a replay
+
+// CRC-32C (Castagnoli), eight table lookups per 8 bytes
+struct Crc32cTable
+{
+    uint32_t entries[8][256];
+
+    Crc32cTable()
+    {
+        for (uint32_t i = 0; i < 256; i++)
+        {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; bit++)
+            {
+                crc = (crc >> 1) ^ (0x82F63B78u & (0u - (crc & 1u)));
+            }
+            entries[0][i] = crc;
+        }
+        for (uint32_t i = 0; i < 256; i++)
+        {
+            for (int k = 1; k < 8; k++)
+            {
+                entries[k][i] = (entries[k - 1][i] >> 8) ^ entries[0][entries[k - 1][i] & 0xFF];
+            }
+        }
+    }
+};
+
+uint32_t crc32c(const char* data, size_t size)
+{
+    static const Crc32cTable table;
+    const uint32_t (&t)[8][256] = table.entries;
+    uint32_t crc = 0xFFFFFFFFu;
+    while (size >= 8)
+    {
+        uint32_t low = crc ^ getU32(data);
+        uint32_t high = getU32(data + 4);
+        crc = t[7][low & 0xFF] ^ t[6][(low >> 8) & 0xFF] ^ t[5][(low >> 16) & 0xFF] ^ t[4][low >> 24] ^
+              t[3][high & 0xFF] ^ t[2][(high >> 8) & 0xFF] ^ t[1][(high >> 16) & 0xFF] ^ t[0][high >> 24];
+        data += 8;
+        size -= 8;
+    }
+    while (size-- > 0)
+    {
+        crc = t[0][(crc ^ static_cast<unsigned char>(*data++)) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+void appendHeader(std::string& out, const char (&magic)[4], uint64_t generation)
+{
+    char header[HEADER_SIZE];
+    std::memcpy(header, magic, 4);
+    putU32(header + 4, FORMAT_VERSION);
+    putU64(header + 8, generation);
+    out.append(header, HEADER_SIZE);
+}
+
+// Checks the magic and version of a file's header and reads its generation
+bool readHeader(const std::string& data, const char (&magic)[4], uint64_t& generation)
+{
+    if (data.size() < HEADER_SIZE || std::memcmp(data.data(), magic, 4) != 0 || getU32(data.data() + 4) != FORMAT_VERSION)
+    {
+        return false;
+    }
+    generation = getU64(data.data() + 8);
+    return true;
+}
+
+void appendRecord(std::string& out, OrderLog::RecordType type, const char* body, size_t size)
+{
+    size_t at = out.size();
+    out.resize(at + RECORD_PREFIX + 1 + size);
+    char* record = &out[at];
+    putU32(record, static_cast<uint32_t>(size + 1));
+    record[RECORD_PREFIX] = static_cast<char>(type);
+    std::memcpy(record + RECORD_PREFIX + 1, body, size);
+    putU32(record + 4, crc32c(record + RECORD_PREFIX, size + 1));
+}
+
+bool writeAll(int fd, const std::string& data)
+{
+    size_t written = 0;
+    while (written < data.size())
+    {
+        ssize_t count = ::write(fd, data.data() + written, data.size() - written);
+        if (count < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (count <= 0)
+        {
+            return false;
+        }
+        written += static_cast<size_t>(count);
+    }
+    return true;
+}
+
+// Reads a whole file; a missing file is not an error, it just sets `found` to false
+bool readFile(const std::string& path, std::string& data, bool& found, std::string& error)
+{
+    data.clear();
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    found = fd != -1;
+    if (!found)
+    {
+        if (errno == ENOENT)
+        {
+            return true;
+        }
+        error = path + ": " + std::strerror(errno);
+        return false;
+    }
+    struct stat status;
+    if (::fstat(fd, &status) == 0)
+    {
+        data.reserve(static_cast<size_t>(status.st_size));
+    }
+    char chunk[1 << 16];
+    while (true)
+    {
+        ssize_t count = ::read(fd, chunk, sizeof(chunk));
+        if (count < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (count < 0)
+        {
+            error = path + ": " + std::strerror(errno);
+            ::close(fd);
+            return false;
+        }
+        if (count == 0)
+        {
+            break;
+        }
+        data.append(chunk, static_cast<size_t>(count));
+    }
+    ::close(fd);
+    return true;
+}
+
+// Makes a rename in the directory of `path` durable
+bool syncDirectory(const std::string& path)
+{
+    size_t slash = path.rfind('/');
+    std::string directory = slash == std::string::npos ? "." : (slash == 0 ? "/" : path.substr(0, slash));
+    int fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd == -1)
+    {
+        return false;
+    }
+    bool synced = ::fsync(fd) == 0;
+    ::close(fd);
+    return synced;
+}
+
+// Copies a dish with its concrete type, as DishStore::add() does
+Dish* copyDish(const Dish& dish)
+{
+    if (const Appetizer* appetizer = dynamic_cast<const Appetizer*>(&dish))
+    {
+        return new Appetizer(*appetizer);
+    }
+    if (const MainCourse* main_course = dynamic_cast<const MainCourse*>(&dish))
+    {
+        return new MainCourse(*main_course);
+    }
+    if (const Dessert* dessert = dynamic_cast<const Dessert*>(&dish))
+    {
+        return new Dessert(*dessert);
+    }
+    return nullptr;
+}
+
+unsigned char requestMask(const Dish::DietaryRequest& request)
+{
+    return static_cast<unsigned char>(request.vegetarian | request.vegan << 1 | request.gluten_free << 2 | request.nut_free << 3 |
+                                      request.low_sodium << 4 | request.low_sugar << 5);
+}
+
+Dish::DietaryRequest requestOf(unsigned char mask)
+{
+    return {(mask & 1) != 0, (mask & 2) != 0, (mask & 4) != 0, (mask & 8) != 0, (mask & 16) != 0, (mask & 32) != 0};
+}
+
+} // namespace
+
+OrderLog::OrderLog(const std::string& path, const Options& options)
+    : path_(path), options_(options), kitchen_(nullptr), fd_(-1), generation_(0), pending_(), pending_records_(0), pending_since_(),
+      records_since_snapshot_(0), row_(), counters_(), error_() {
+    if (options_.group_records < 1) {
+        options_.group_records = 1;
+    }
+}
+
+OrderLog::~OrderLog() {
+    commit();
+    if (kitchen_ != nullptr) {
+        kitchen_->detachLog(this);
+    }
+    if (fd_ != -1) {
+        ::close(fd_);
+    }
+}
+
+bool OrderLog::exists(const std::string& path) {
+    struct stat status;
+    return ::stat(path.c_str(), &status) == 0 || ::stat((path + ".snapshot").c_str(), &status) == 0;
+}
+
+bool OrderLog::open(Kitchen& kitchen, Recovery& recovery, std::string& error) {
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    recovery = Recovery();
+    if (fd_ != -1) {
+        error = path_ + ": the log is already open";
+        return false;
+    }
+    recovery.recovered = exists(path_);
+    long long log_end = 0;
+    if (recovery.recovered) {
+        if (kitchen.getCurrentSize() != 0) {
+            error = path_ + ": the kitchen must be empty to recover from the log";
+            return false;
+        }
+        if (!recover(kitchen, recovery, log_end, error)) {
+            return false;
+        }
+    }
+
+    fd_ = ::open(path_.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (fd_ == -1) {
+        error = path_ + ": " + std::strerror(errno);
+        return false;
+    }
+    kitchen_ = &kitchen;
+    kitchen_->attachLog(this);
+    generation_ = recovery.generation;
+    bool opened = true;
+    if (!recovery.recovered) {
+        opened = snapshot(); // the kitchen's dishes become generation 1
+        recovery.snapshot_dishes = kitchen.getCurrentSize();
+    } else if (log_end == 0) {
+        opened = resetLog(generation_); // the log was missing, torn inside its header, or older than the snapshot
+    } else if (recovery.dropped_bytes > 0) {
+        // Cut the torn tail, so new records follow the last good one
+        if (::ftruncate(fd_, log_end) != 0 || (options_.sync && ::fdatasync(fd_) != 0)) {
+            opened = fail(path_ + ": " + std::strerror(errno));
+        }
+    }
+    if (!opened) {
+        error = error_;
+        return false;
+    }
+    recovery.generation = generation_;
+    recovery.elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    return true;
+}
+
+bool OrderLog::recover(Kitchen& kitchen, Recovery& recovery, long long& log_end, std::string& error) {
+    const std::string snapshot_path = path_ + ".snapshot";
+    std::string snapshot_data, log_data;
+    bool have_snapshot = false, have_log = false;
+    if (!readFile(snapshot_path, snapshot_data, have_snapshot, error) || !readFile(path_, log_data, have_log, error)) {
+        return false;
+    }
+
+    uint64_t snapshot_generation = 0;
+    if (have_snapshot) {
+        if (!readHeader(snapshot_data, SNAPSHOT_MAGIC, snapshot_generation)) {
+            error = snapshot_path + ": not a kitchen snapshot";
+            return false;
+        }
+        // A snapshot is renamed into place only once it is complete, so every byte of it must replay
+        size_t offset = HEADER_SIZE;
+        long long counts[RECORD_TYPE_COUNT] = {};
+        if (!replay(kitchen, snapshot_data, offset, true, counts, error)) {
+            error = snapshot_path + ": " + error;
+            return false;
+        }
+        if (offset != snapshot_data.size()) {
+            error = snapshot_path + ": corrupt record at byte " + std::to_string(offset);
+            return false;
+        }
+        recovery.snapshot_dishes = static_cast<int>(counts[ORDER]);
+    }
+    recovery.generation = snapshot_generation;
+
+    log_end = 0;
+    if (!have_log || log_data.size() < HEADER_SIZE) {
+        // A crash while the header was written leaves a prefix of it; anything else is some other file
+        std::string header;
+        appendHeader(header, LOG_MAGIC, snapshot_generation);
+        size_t checked = std::min(log_data.size(), static_cast<size_t>(8)); // the magic and version, not the generation
+        if (log_data.compare(0, checked, header, 0, checked) != 0) {
+            error = path_ + ": not a kitchen log";
+            return false;
+        }
+        recovery.dropped_bytes = static_cast<long long>(log_data.size());
+        return true;
+    }
+    uint64_t log_generation = 0;
+    if (!readHeader(log_data, LOG_MAGIC, log_generation)) {
+        error = path_ + ": not a kitchen log";
+        return false;
+    }
+    if (log_generation < snapshot_generation) {
+        recovery.stale_log = true; // a snapshot was taken but the log was not emptied after it
+        return true;
+    }
+    if (log_generation > snapshot_generation) {
+        error = path_ + ": the log continues snapshot generation " + std::to_string(log_generation) + ", but " + snapshot_path +
+                (have_snapshot ? " is generation " + std::to_string(snapshot_generation) : " is missing");
+        return false;
+    }
+    size_t offset = HEADER_SIZE;
+    if (!replay(kitchen, log_data, offset, false, recovery.records, error)) {
+        error = path_ + ": " + error;
+        return false;
+    }
+    log_end = static_cast<long long>(offset);
+    recovery.dropped_bytes = static_cast<long long>(log_data.size() - offset);
+    return true;
+}
+
+bool OrderLog::replay(Kitchen& kitchen, const std::string& data, size_t& offset, bool orders_only, long long* counts, std::string& error) {
+    // Dishes already decoded, by row; a dish ordered again is copied instead of parsed. The keys point into `data`.
+    std::unordered_map<std::string_view, std::unique_ptr<Dish>> prototypes;
+    while (data.size() - offset >= RECORD_PREFIX) {
+        const char* record = data.data() + offset;
+        uint32_t length = getU32(record);
+        if (length == 0 || length > MAX_RECORD_LENGTH || length > data.size() - offset - RECORD_PREFIX ||
+            crc32c(record + RECORD_PREFIX, length) != getU32(record + 4)) {
+            break; // cut short or corrupt: the end of what was durably written
+        }
+        unsigned char type = static_cast<unsigned char>(record[RECORD_PREFIX]);
+        const char* body = record + RECORD_PREFIX + 1;
+        size_t body_size = length - 1;
+        const std::string at = "record at byte " + std::to_string(offset);
+
+        if (type == ORDER) {
+            std::string_view row(body, body_size);
+            Dish* dish = nullptr;
+            std::unordered_map<std::string_view, std::unique_ptr<Dish>>::const_iterator found = prototypes.find(row);
+            if (found != prototypes.end()) {
+                dish = copyDish(*found->second);
+            } else {
+                try {
+                    dish = Kitchen::parseDish(std::string(row));
+                } catch (const std::exception&) {
+                    dish = nullptr; // std::stoi and the price parser throw on malformed rows
+                }
+                if (dish == nullptr) {
+                    error = at + ": not a dish row";
+                    return false;
+                }
+                if (prototypes.size() < PROTOTYPE_LIMIT) {
+                    Dish* prototype = dish;
+                    dish = copyDish(*prototype);
+                    prototypes.emplace(row, std::unique_ptr<Dish>(prototype));
+                }
+            }
+            if (!kitchen.newOrder(dish)) {
+                delete dish; // the kitchen is full and does not take ownership
+                error = at + ": the kitchen is full";
+                return false;
+            }
+        } else if (type == SERVE && !orders_only && body_size == 4) {
+            uint32_t index = getU32(body);
+            if (index >= static_cast<uint32_t>(kitchen.getCurrentSize())) {
+                error = at + ": serves dish " + std::to_string(index) + " of " + std::to_string(kitchen.getCurrentSize());
+                return false;
+            }
+            Dish* dish = kitchen.items_[index];
+            kitchen.serveDish(dish);
+            delete dish; // served, so the kitchen no longer owns it
+        } else if (type == ADJUST && !orders_only && body_size == 1) {
+            kitchen.dietaryAdjustment(requestOf(static_cast<unsigned char>(body[0])));
+        } else {
+            error = at + ": unexpected record of type " + std::to_string(type) + " and " + std::to_string(body_size) + " bytes";
+            return false;
+        }
+        counts[type]++;
+        offset += RECORD_PREFIX + length;
+    }
+    return true;
+}
+
+bool OrderLog::follow(Kitchen& kitchen) {
+    if (fd_ == -1 || !commit()) {
+        return false;
+    }
+    if (kitchen_ != nullptr) {
+        kitchen_->detachLog(this);
+    }
+    kitchen_ = &kitchen;
+    kitchen_->attachLog(this);
+    return snapshot();
+}
+
+bool OrderLog::commit() {
+    if (!error_.empty()) {
+        return false;
+    }
+    if (pending_records_ == 0) {
+        return true;
+    }
+    if (!writeAll(fd_, pending_) || (options_.sync && ::fdatasync(fd_) != 0)) {
+        return fail(path_ + ": " + std::strerror(errno));
+    }
+    counters_.bytes += static_cast<long long>(pending_.size());
+    counters_.commits++;
+    counters_.syncs += options_.sync ? 1 : 0;
+    pending_.clear();
+    pending_records_ = 0;
+    return true;
+}
+
+bool OrderLog::commitIfDue() {
+    if (pending_records_ == 0 || commitTimeoutMs() > 0) {
+        return error_.empty();
+    }
+    return commit();
+}
+
+int OrderLog::commitTimeoutMs() const {
+    if (pending_records_ == 0 || !error_.empty()) {
+        return -1;
+    }
+    double age_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - pending_since_).count();
+    return age_ms >= options_.group_ms ? 0 : static_cast<int>(std::ceil(options_.group_ms - age_ms));
+}
+
+bool OrderLog::snapshot() {
+    if (kitchen_ == nullptr || !commit()) {
+        return false;
+    }
+    const uint64_t generation = generation_ + 1;
+    std::string data;
+    appendHeader(data, SNAPSHOT_MAGIC, generation);
+    for (int i = 0; i < kitchen_->getCurrentSize(); i++) {
+        row_.clear();
+        kitchen_->items_[i]->writeCsv(row_);
+        const std::string& row = row_.str();
+        appendRecord(data, ORDER, row.data(), row.size() - (!row.empty() && row.back() == '\n' ? 1 : 0));
+    }
+
+    const std::string snapshot_path = path_ + ".snapshot";
+    const std::string temporary_path = snapshot_path + ".tmp";
+    int fd = ::open(temporary_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    bool written = fd != -1 && writeAll(fd, data) && (!options_.sync || ::fsync(fd) == 0);
+    int write_errno = errno;
+    if (fd != -1) {
+        ::close(fd);
+    }
+    if (!written) {
+        return fail(temporary_path + ": " + std::strerror(write_errno));
+    }
+    if (::rename(temporary_path.c_str(), snapshot_path.c_str()) != 0 || (options_.sync && !syncDirectory(path_))) {
+        return fail(snapshot_path + ": " + std::strerror(errno));
+    }
+    counters_.syncs += options_.sync ? 2 : 0;
+
+    // From here the log of the previous generation is stale, so a crash before the reset loses nothing
+    if (!resetLog(generation)) {
+        return false;
+    }
+    generation_ = generation;
+    records_since_snapshot_ = 0;
+    counters_.snapshots++;
+    return true;
+}
+
+bool OrderLog::resetLog(uint64_t generation) {
+    std::string header;
+    appendHeader(header, LOG_MAGIC, generation);
+    if (::ftruncate(fd_, 0) != 0 || !writeAll(fd_, header) || (options_.sync && ::fdatasync(fd_) != 0)) {
+        return fail(path_ + ": " + std::strerror(errno));
+    }
+    counters_.bytes += static_cast<long long>(header.size());
+    counters_.syncs += options_.sync ? 1 : 0;
+    return true;
+}
+
+bool OrderLog::fail(const std::string& what) {
+    error_ = what;
+    pending_.clear();
+    pending_records_ = 0;
+    return false;
+}
+
+uint64_t OrderLog::generation() const {
+    return generation_;
+}
+
+const OrderLog::Counters& OrderLog::counters() const {
+    return counters_;
+}
+
+const std::string& OrderLog::error() const {
+    return error_;
+}
+
+void OrderLog::append(RecordType type, const char* body, size_t size) {
+    if (!error_.empty()) {
+        return;
+    }
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    if (pending_records_ == 0) {
+        pending_since_ = now;
+    }
+    appendRecord(pending_, type, body, size);
+    pending_records_++;
+    counters_.records++;
+    records_since_snapshot_++;
+    if (pending_records_ >= options_.group_records ||
+        std::chrono::duration<double, std::milli>(now - pending_since_).count() >= options_.group_ms) {
+        commit();
+    }
+    if (options_.snapshot_records > 0 && records_since_snapshot_ >= options_.snapshot_records) {
+        snapshot();
+    }
+}
+
+void OrderLog::dishAdded(const Dish* dish) {
+    row_.clear();
+    dish->writeCsv(row_);
+    const std::string& row = row_.str();
+    append(ORDER, row.data(), row.size() - (!row.empty() && row.back() == '\n' ? 1 : 0));
+}
+
+void OrderLog::dishRemoved(int index) {
+    char body[4];
+    putU32(body, static_cast<uint32_t>(index));
+    append(SERVE, body, sizeof(body));
+}
+
+void OrderLog::kitchenAdjusted(const Dish::DietaryRequest& request) {
+    char mask = static_cast<char>(requestMask(request));
+    append(ADJUST, &mask, 1);
+}
+
+void OrderLog::kitchenDestroyed() {
+    commit();
+    kitchen_ = nullptr;
+}
+
+void OrderLog::Recovery::writeText(MenuRenderer& out) const {
+    out.append("journal: generation ").appendInt(static_cast<long long>(generation)).append(", ");
+    if (!recovered) {
+        out.append("started with ").appendInt(snapshot_dishes).append(" dishes\n");
+        return;
+    }
+    long long total = 0;
+    for (int type = 0; type < RECORD_TYPE_COUNT; type++) {
+        total += records[type];
+    }
+    out.appendInt(snapshot_dishes).append(" dishes from the snapshot, ").appendInt(total).append(" records replayed (");
+    for (int type = 0; type < RECORD_TYPE_COUNT; type++) {
+        out.append(type == 0 ? "" : " ").append(RECORD_TYPE_INFO[type].token).append('=').appendInt(records[type]);
+    }
+    out.append(") in ").appendFixed(elapsed_ms, 3).append(" ms, ");
+    out.appendFixed(elapsed_ms > 0 ? total / elapsed_ms * 1000.0 : 0.0, 0).append(" records/s");
+    if (stale_log) {
+        out.append(", discarded a log older than the snapshot");
+    }
+    if (dropped_bytes > 0) {
+        out.append(", cut ").appendInt(dropped_bytes).append(" bytes of a torn tail");
+    }
+    out.append('\n');
+}
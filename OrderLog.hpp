@@ -0,0 +1,239 @@
+/**
+ * @file OrderLog.hpp
+ * @brief This file contains the declaration of the OrderLog class, an append-only binary journal of every Kitchen mutation.
+ *
+ * A kitchen lives in memory, so a restart loses every newOrder(), serveDish() and dietary adjustment made since the
+ * CSV was loaded. An OrderLog attached to a kitchen appends one record per mutation to a log file, and open() on the
+ * next start rebuilds the kitchen from the newest snapshot plus the records logged after it.
+ *
+ * File layout. The log (`path`) and the snapshot (`path.snapshot`) both start with a 16-byte header: a 4-byte magic
+ * ("KLOG" or "KSNP"), a 32-bit format version and a 64-bit generation. Records follow back to back:
+ *
+ *   u32 length | u32 CRC-32C | u8 type | body (length - 1 bytes)
+ *
+ * with the CRC taken over the type and body, and integers little-endian. An ORDER body is the dish's row in the
+ * Dishes.csv schema, a SERVE body is the u32 index of the served dish in the kitchen, and an ADJUST body is one byte
+ * with a bit per DietaryRequest flag. Releases are logged as the serves they are made of. A snapshot is a run of
+ * ORDER records, one per dish in kitchen order, so replaying it recreates the same indexes the SERVE records refer to.
+ *
+ * Group commit. Records are encoded into a buffer and written with one write() and one fdatasync() per group: when
+ * `group_records` records are pending, or once the oldest pending record is `group_ms` old. The age is checked when a
+ * record is appended and by commitIfDue(); a caller that can sit idle, such as an event loop, calls commitIfDue() at
+ * the deadline commitTimeoutMs() gives, so the last records of a burst are synced on time too. A crash loses the
+ * records not yet committed (with commitIfDue() driven, at most `group_ms` worth of them) and never part of a group;
+ * call commit() to make everything appended so far durable.
+ *
+ * Recovery. open() loads the snapshot, then replays the log until its end or the first record that is cut short or
+ * fails its CRC, and truncates the log there, since that tail is a write the crash interrupted. Decoded dishes are
+ * cached by row, so reordering a dish costs a copy instead of a CSV parse; replay runs at millions of records per
+ * second.
+ *
+ * Snapshots. snapshot() writes the kitchen to `path.snapshot.tmp`, syncs it, renames it over the old snapshot and
+ * then empties the log. The new snapshot and log carry the next generation, so a crash between the rename and the
+ * truncation leaves a log whose generation is older than the snapshot's, which open() recognizes and discards rather
+ * than replaying twice. With `snapshot_records` set, a snapshot is taken every time that many records were logged.
+ *
+ * Only mutations made through Kitchen are logged; a dish changed through its own setters is not, until the next
+ * snapshot. Like Kitchen, an OrderLog is not thread-safe. When a write fails, the log stops recording and error()
+ * says why.
+ *
+ * @date October 17, 2026
+ * @author Kun Feng Wei
+ */
+
+#ifndef ORDER_LOG_HPP
+#define ORDER_LOG_HPP
+
+#include "Dish.hpp"
+#include "EnumTable.hpp"
+#include "Kitchen.hpp"
+#include "MenuRenderer.hpp"
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+class OrderLog {
+public:
+    /**
+     * The kinds of records.
+     */
+    enum RecordType
+    {
+        ORDER,
+        SERVE,
+        ADJUST,
+        RECORD_TYPE_COUNT
+    };
+
+    /**
+     * Metadata of each record type; the token names it in reports.
+     */
+    static constexpr EnumInfo<RecordType> RECORD_TYPE_INFO[] = {
+        {ORDER, "order", "A dish added by newOrder() or newOrders()", 0},
+        {SERVE, "serve", "A dish removed by serveDish() or a release", 0},
+        {ADJUST, "adjust", "A dietaryAdjustment() of every dish", 0},
+    };
+
+    /**
+     * When records are made durable and snapshots taken.
+     */
+    struct Options
+    {
+        int group_records;           ///< Most records per write and sync, at least 1.
+        double group_ms;             ///< Longest a record waits for its group to fill; 0 syncs every record.
+        bool sync;                   ///< False to write groups without fdatasync(), e.g. for benchmarks.
+        long long snapshot_records;  ///< Records between automatic snapshots; 0 for none.
+    };
+
+    /**
+     * Totals since the log was opened.
+     */
+    struct Counters
+    {
+        long long records;    ///< Records appended.
+        long long bytes;      ///< Bytes written to the log, headers included.
+        long long commits;    ///< Groups written.
+        long long syncs;      ///< fdatasync() and fsync() calls.
+        long long snapshots;  ///< Snapshots taken.
+    };
+
+    /**
+     * What open() found and replayed.
+     */
+    struct Recovery
+    {
+        bool recovered;                             ///< False if neither file existed and the log was started fresh.
+        uint64_t generation;                        ///< Generation of the snapshot and log after opening.
+        int snapshot_dishes;                        ///< Dishes loaded from the snapshot.
+        long long records[RECORD_TYPE_COUNT];       ///< Log records replayed, by type.
+        long long dropped_bytes;                    ///< Bytes cut from the end of the log (a torn or corrupt tail).
+        bool stale_log;                             ///< True if the log predated the snapshot and was discarded.
+        double elapsed_ms;                          ///< Wall time of the recovery.
+
+        /**
+         * Appends one line, e.g. "journal: generation 3, 99 dishes from the snapshot, 41210 records replayed
+         * (order=20610 serve=20600 adjust=0) in 9.812 ms, 4199959 records/s".
+         * @param out The renderer receiving the text.
+         */
+        void writeText(MenuRenderer& out) const;
+    };
+
+    /**
+     * Parameterized constructor. No file is touched until open().
+     * @param path The log file; the snapshot is kept next to it in `path.snapshot`.
+     * @param options The group commit and snapshot settings.
+     */
+    OrderLog(const std::string& path, const Options& options);
+
+    OrderLog(const OrderLog&) = delete;
+    OrderLog& operator=(const OrderLog&) = delete;
+
+    /**
+     * Destructor.
+     * @post Commits the pending records, stops following the kitchen and closes the log.
+     */
+    ~OrderLog();
+
+    /**
+     * @param path A log file.
+     * @return True if the log or its snapshot exists, i.e. open() would recover from them.
+     */
+    static bool exists(const std::string& path);
+
+    /**
+     * Recovers or starts the log and attaches it to a kitchen.
+     * @param kitchen If the log or its snapshot exists, an empty kitchen that is rebuilt from them; otherwise any
+     * kitchen, whose current dishes become the first snapshot.
+     * @param[out] recovery Receives what was replayed.
+     * @param[out] error Receives the reason when opening fails.
+     * @return True if the log is open and following the kitchen, false otherwise.
+     */
+    bool open(Kitchen& kitchen, Recovery& recovery, std::string& error);
+
+    /**
+     * Makes an open log follow another kitchen, e.g. one loaded from a CSV file, whose dishes become a new snapshot.
+     * @param kitchen The kitchen to follow.
+     * @return True if the snapshot was written, false otherwise (see error()).
+     */
+    bool follow(Kitchen& kitchen);
+
+    /**
+     * Writes and syncs the pending records.
+     * @return True if every record appended so far is durable, false otherwise (see error()).
+     */
+    bool commit();
+
+    /**
+     * Commits the pending records if the oldest one is at least `group_ms` old.
+     * @return False if the commit failed (see error()), true otherwise.
+     */
+    bool commitIfDue();
+
+    /**
+     * @return The milliseconds until the pending records are due for commitIfDue(), rounded up, 0 if they are due
+     * now, or -1 if nothing is pending.
+     */
+    int commitTimeoutMs() const;
+
+    /**
+     * Writes the kitchen as a new snapshot and empties the log (see the file comment).
+     * @return True if the snapshot was taken, false otherwise (see error()).
+     */
+    bool snapshot();
+
+    /**
+     * @return The generation of the current snapshot and log.
+     */
+    uint64_t generation() const;
+
+    /**
+     * @return The totals since the log was opened.
+     */
+    const Counters& counters() const;
+
+    /**
+     * @return The reason the log stopped recording, or an empty string while it is healthy.
+     */
+    const std::string& error() const;
+
+private:
+    friend class Kitchen;
+
+    // Encodes one record into the pending group and commits or snapshots when due
+    void append(RecordType type, const char* body, size_t size);
+
+    // Rebuilds `kitchen` from the snapshot and log files; sets `log_end` to the end of the last good log record
+    bool recover(Kitchen& kitchen, Recovery& recovery, long long& log_end, std::string& error);
+
+    // Applies the records of data[offset..) to `kitchen`, stopping at the end or at the first record that is cut short
+    // or fails its CRC, and leaves `offset` after the last record applied; false if a sound record cannot be applied
+    static bool replay(Kitchen& kitchen, const std::string& data, size_t& offset, bool orders_only, long long* counts, std::string& error);
+
+    // Empties the log and starts it over with a header for `generation`
+    bool resetLog(uint64_t generation);
+
+    bool fail(const std::string& what);
+
+    // Called by the kitchen, after the mutation
+    void dishAdded(const Dish* dish);
+    void dishRemoved(int index);
+    void kitchenAdjusted(const Dish::DietaryRequest& request);
+    void kitchenDestroyed();
+
+    std::string path_;
+    Options options_;
+    Kitchen* kitchen_;
+    int fd_;
+    uint64_t generation_;
+    std::string pending_;                                  // encoded records not yet written
+    int pending_records_;
+    std::chrono::steady_clock::time_point pending_since_;  // when the oldest pending record was appended
+    long long records_since_snapshot_;
+    MenuRenderer row_;                                     // reused to render ORDER bodies
+    Counters counters_;
+    std::string error_;
+};
+
+static_assert(isIndexedByValue(OrderLog::RECORD_TYPE_INFO), "RECORD_TYPE_INFO must be in enum order");
+
+#endif // ORDER_LOG_HPP
@@ -0,0 +1,134 @@
+/**
+ * @file OrderQueue.cpp
+ * @brief This file contains the implementation of the OrderQueue class, a bounded lock-free multi-producer/single-consumer queue of new orders.
+ *
+ * @date October 17, 2026
+ * @author Kun Feng Wei
+ */
+
+#include "OrderQueue.hpp"
+#include <algorithm>
+
+OrderQueue::OrderQueue(size_t capacity) : mask_(0), slots_(), enqueue_pos_(0), full_rejections_(0), dequeue_pos_(0), batches_(0), duplicates_(0) {
+    size_t rounded = 2;
+    while (rounded < capacity) {
+        rounded <<= 1;
+    }
+    mask_ = rounded - 1;
+    slots_.reset(new Slot[rounded]);
+    for (size_t i = 0; i < rounded; i++) {
+        slots_[i].sequence.store(i, std::memory_order_relaxed);
+        slots_[i].dish = nullptr;
+    }
+}
+
+OrderQueue::~OrderQueue() {
+    std::vector<Dish*> owned(held_back_);
+    Dish* dish = nullptr;
+    while (drain(&dish, 1) == 1) {
+        owned.push_back(dish);
+    }
+    // A pointer pushed twice is still one dish, and a copy still queued after the kitchen took the other one
+    // belongs to the kitchen
+    std::sort(owned.begin(), owned.end());
+    owned.erase(std::unique(owned.begin(), owned.end()), owned.end());
+    for (Dish* owned_dish : owned) {
+        if (!owned_dish->inKitchen()) {
+            delete owned_dish;
+        }
+    }
+}
+
+bool OrderQueue::tryPush(Dish* dish) {
+    size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    Slot* slot;
+    while (true) {
+        slot = &slots_[pos & mask_];
+        size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+        if (difference == 0) {
+            // The slot is free for this position; claim it unless another producer got there first
+            if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (difference < 0) {
+            // The slot still holds the dish from one lap ago: the consumer is a whole ring behind
+            full_rejections_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        } else {
+            pos = enqueue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+    slot->dish = dish;
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+size_t OrderQueue::drain(Dish** out, size_t max_count) {
+    size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    size_t count = 0;
+    while (count < max_count) {
+        Slot& slot = slots_[pos & mask_];
+        if (slot.sequence.load(std::memory_order_acquire) != pos + 1) {
+            break; // not published yet; later positions may be, but dishes leave in position order
+        }
+        out[count++] = slot.dish;
+        slot.sequence.store(pos + mask_ + 1, std::memory_order_release); // free for the producer one lap ahead
+        pos++;
+    }
+    if (count > 0) {
+        dequeue_pos_.store(pos, std::memory_order_relaxed);
+        batches_.store(batches_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+    return count;
+}
+
+int OrderQueue::drainInto(Kitchen& kitchen, size_t max_batch) {
+    // Only take as many new dishes as the kitchen has room for, so held-back dishes stay rare
+    size_t room = static_cast<size_t>(std::max(0, Kitchen::getCapacity() - kitchen.getCurrentSize()));
+    size_t wanted = std::min(max_batch, room);
+    batch_.assign(held_back_.begin(), held_back_.end());
+    held_back_.clear();
+    if (batch_.size() < wanted) {
+        size_t old_size = batch_.size();
+        batch_.resize(wanted);
+        batch_.resize(old_size + drain(batch_.data() + old_size, wanted - old_size));
+    }
+    if (batch_.empty()) {
+        return 0;
+    }
+    // newOrders() stops at the first dish it refuses; one the kitchen already holds is skipped, not held back,
+    // or it would be offered first and refused again on every later call
+    int added = 0;
+    size_t pos = 0;
+    while (pos < batch_.size()) {
+        int taken = kitchen.newOrders(batch_.data() + pos, static_cast<int>(batch_.size() - pos));
+        added += taken;
+        pos += taken;
+        if (pos == batch_.size() || !kitchen.contains(batch_[pos])) {
+            break; // the kitchen is full
+        }
+        duplicates_.store(duplicates_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        pos++;
+    }
+    held_back_.assign(batch_.begin() + pos, batch_.end());
+    return added;
+}
+
+size_t OrderQueue::heldBack() const {
+    return held_back_.size();
+}
+
+size_t OrderQueue::capacity() const {
+    return mask_ + 1;
+}
+
+OrderQueue::Counters OrderQueue::counters() const {
+    Counters counters;
+    counters.pushed = enqueue_pos_.load(std::memory_order_relaxed);
+    counters.full_rejections = full_rejections_.load(std::memory_order_relaxed);
+    counters.drained = dequeue_pos_.load(std::memory_order_relaxed);
+    counters.batches = batches_.load(std::memory_order_relaxed);
+    counters.duplicates = duplicates_.load(std::memory_order_relaxed);
+    return counters;
+}
@@ -0,0 +1,127 @@
+/**
+ * @file OrderQueue.hpp
+ * @brief This file contains the declaration of the OrderQueue class, a bounded lock-free multi-producer/single-consumer queue of new orders.
+ *
+ * Any number of producer threads (terminals, online orders) push dishes with tryPush(); one kitchen thread drains
+ * them in batches into a Kitchen with drainInto(), which hands each batch to Kitchen::newOrders(). Producers never
+ * take a lock and never wait for the kitchen: when the queue is full, tryPush() returns false and the producer keeps
+ * the dish, which is the backpressure signal (retry later, shed the order, or slow down).
+ *
+ * The ring follows Dmitry Vyukov's bounded queue: every slot carries a sequence number that says whether it is free
+ * for the producer at a given position or holds a dish for the consumer at that position. A producer claims a
+ * position with one compare-and-swap on the enqueue counter, writes its dish and publishes it by advancing the slot's
+ * sequence; the consumer owns the dequeue counter and needs no atomic read-modify-write at all. The two counters sit
+ * on separate cache lines so producers and the consumer do not invalidate each other's line on every operation.
+ *
+ * The counters double as throughput statistics: counters() reports the dishes pushed and drained, the pushes refused
+ * because the queue was full, and the number of batches, so producer and consumer rates can be measured from outside.
+ *
+ * @date October 17, 2026
+ * @author Kun Feng Wei
+ */
+
+#ifndef ORDER_QUEUE_HPP
+#define ORDER_QUEUE_HPP
+
+#include "Dish.hpp"
+#include "Kitchen.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class OrderQueue {
+public:
+    /**
+     * Totals since the queue was created.
+     */
+    struct Counters
+    {
+        uint64_t pushed;           ///< Dishes accepted by tryPush().
+        uint64_t full_rejections;  ///< tryPush() calls refused because the queue was full.
+        uint64_t drained;          ///< Dishes taken out by drain() or drainInto().
+        uint64_t batches;          ///< drain() and drainInto() calls that took at least one dish.
+        uint64_t duplicates;       ///< Dishes drainInto() dropped because the kitchen already held them.
+    };
+
+    /**
+     * Parameterized constructor.
+     * @param capacity The most dishes the queue holds; rounded up to a power of two, at least 2.
+     */
+    explicit OrderQueue(size_t capacity);
+
+    OrderQueue(const OrderQueue&) = delete;
+    OrderQueue& operator=(const OrderQueue&) = delete;
+
+    /**
+     * Destructor.
+     * @post Deletes every dish still queued or held back by drainInto(), each once even if it was pushed twice.
+     * A re-pushed pointer whose other copy a kitchen already accepted is not owned by the queue and is not deleted,
+     * so a queue that may hold such copies must be destroyed before the kitchens it drains into.
+     */
+    ~OrderQueue();
+
+    /**
+     * Queues a dish. Safe to call from any number of threads at once.
+     * @param dish The dish to queue.
+     * @return True if the dish was queued and the queue now owns it (unless a kitchen ends up holding another queued
+     * copy of the same pointer); false if the queue was full, in which case the caller still owns the dish.
+     */
+    bool tryPush(Dish* dish);
+
+    /**
+     * Takes up to `max_count` dishes out in the order they were published. Only the consumer thread may call this.
+     * @param out The array receiving the dishes; the caller owns them afterwards.
+     * @param max_count The size of `out`.
+     * @return The number of dishes taken, 0 if the queue is empty.
+     */
+    size_t drain(Dish** out, size_t max_count);
+
+    /**
+     * Moves up to `max_batch` dishes into a kitchen with one Kitchen::newOrders() call. Only the consumer thread may
+     * call this. Dishes the kitchen refuses because it is full are held back and offered first on the next call.
+     * A dish the kitchen already holds (its pointer was pushed again) is dropped, not deleted, since the kitchen owns
+     * it, and counted in Counters::duplicates; it never blocks the dishes behind it.
+     * @param kitchen The kitchen receiving the dishes; it owns the dishes it accepts.
+     * @param max_batch The most dishes to move.
+     * @return The number of dishes the kitchen accepted.
+     */
+    int drainInto(Kitchen& kitchen, size_t max_batch);
+
+    /**
+     * @return The number of dishes held back by drainInto() because the kitchen was full.
+     */
+    size_t heldBack() const;
+
+    /**
+     * @return The capacity of the ring after rounding.
+     */
+    size_t capacity() const;
+
+    /**
+     * @return The totals so far. Each value is read atomically, but not all at the same instant.
+     */
+    Counters counters() const;
+
+private:
+    static const size_t CACHE_LINE = 64;
+
+    struct Slot
+    {
+        std::atomic<size_t> sequence; // == position when free for that position's producer, position + 1 when holding its dish
+        Dish* dish;
+    };
+
+    size_t mask_;
+    std::unique_ptr<Slot[]> slots_;
+    alignas(CACHE_LINE) std::atomic<size_t> enqueue_pos_;      // next position to claim; also the number pushed
+    alignas(CACHE_LINE) std::atomic<uint64_t> full_rejections_;
+    alignas(CACHE_LINE) std::atomic<size_t> dequeue_pos_;      // written only by the consumer; also the number drained
+    std::atomic<uint64_t> batches_;                            // written only by the consumer
+    std::atomic<uint64_t> duplicates_;                         // written only by the consumer
+    std::vector<Dish*> held_back_;                             // consumer-only: refused by the kitchen, retried first
+    std::vector<Dish*> batch_;                                 // consumer-only: reused drainInto() buffer
+};
+
+#endif // ORDER_QUEUE_HPP
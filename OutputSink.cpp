@@ -0,0 +1,114 @@
+/**
+ * @file OutputSink.cpp
+ * @brief This file contains the implementation of the stream, file descriptor, string and null output sinks.
+ *
+ * @date October 17, 2026
+ * @author Kun Feng Wei
+ */
+
+#include "OutputSink.hpp"
+#include <cerrno>
+#include <climits>
+#include <algorithm>
+#include <vector>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#ifndef IOV_MAX
+#define IOV_MAX 1024
+#endif
+
+void OutputSink::writeGather(const std::string_view* blocks, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        write(blocks[i].data(), blocks[i].size());
+    }
+}
+
+void OutputSink::flush() {
+}
+
+// StreamSink
+StreamSink::StreamSink(std::ostream& stream) : stream_(stream) {
+}
+
+void StreamSink::write(const char* data, size_t size) {
+    stream_.write(data, static_cast<std::streamsize>(size));
+}
+
+void StreamSink::flush() {
+    stream_.flush();
+}
+
+// FileDescriptorSink
+FileDescriptorSink::FileDescriptorSink(int fd) : fd_(fd), good_(true) {
+}
+
+void FileDescriptorSink::write(const char* data, size_t size) {
+    std::string_view block(data, size);
+    writeGather(&block, 1);
+}
+
+void FileDescriptorSink::writeGather(const std::string_view* blocks, size_t count) {
+    std::vector<iovec> pending;
+    pending.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        if (!blocks[i].empty()) {
+            pending.push_back(iovec{const_cast<char*>(blocks[i].data()), blocks[i].size()});
+        }
+    }
+
+    // writev() may write only part of the data, so keep going from where it stopped
+    size_t next = 0;
+    while (good_ && next < pending.size()) {
+        int batch = static_cast<int>(std::min<size_t>(pending.size() - next, IOV_MAX));
+        ssize_t written = ::writev(fd_, &pending[next], batch);
+        if (written < 0) {
+            if (errno != EINTR) {
+                good_ = false;
+            }
+            continue;
+        }
+        size_t remaining = static_cast<size_t>(written);
+        while (next < pending.size() && remaining >= pending[next].iov_len) {
+            remaining -= pending[next].iov_len;
+            next++;
+        }
+        if (remaining > 0) {
+            pending[next].iov_base = static_cast<char*>(pending[next].iov_base) + remaining;
+            pending[next].iov_len -= remaining;
+        }
+    }
+}
+
+bool FileDescriptorSink::good() const {
+    return good_;
+}
+
+// StringSink
+StringSink::StringSink() : text_() {
+}
+
+void StringSink::write(const char* data, size_t size) {
+    text_.append(data, size);
+}
+
+const std::string& StringSink::str() const {
+    return text_;
+}
+
+void StringSink::clear() {
+    text_.clear();
+}
+
+// NullSink
+NullSink::NullSink() : bytes_written_(0) {
+}
+
+void NullSink::write(const char* data, size_t size) {
+    (void)data;
+    bytes_written_ += size;
+}
+
+size_t NullSink::bytesWritten() const {
+    return bytes_written_;
+}
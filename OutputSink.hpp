@@ -0,0 +1,149 @@
+/**
+ * @file OutputSink.hpp
+ * @brief This file contains the declaration of the OutputSink interface and its stream, file descriptor, string and null implementations.
+ *
+ * All menu and report rendering writes its finished text to an OutputSink, so the same code can print to the console,
+ * fill an in-memory string, write to a file or pipe through a stream, or discard the text when only the formatting cost
+ * is being measured.
+ *
+ * @date October 17, 2026
+ * @author Kun Feng Wei
+ */
+
+#ifndef OUTPUT_SINK_HPP
+#define OUTPUT_SINK_HPP
+
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+/**
+ * @class OutputSink
+ * @brief Destination for rendered text.
+ */
+class OutputSink {
+public:
+    /**
+     * Appends a block of text to the sink.
+     * @param data A pointer to the first character of the block.
+     * @param size The number of characters in the block.
+     */
+    virtual void write(const char* data, size_t size) = 0;
+
+    /**
+     * Appends several blocks of text to the sink, in order.
+     * The default writes the blocks one at a time; sinks backed by a file descriptor gather them into one system call.
+     * @param blocks A pointer to the first block.
+     * @param count The number of blocks.
+     */
+    virtual void writeGather(const std::string_view* blocks, size_t count);
+
+    /**
+     * Pushes any buffered text to its final destination.
+     * Sinks without an underlying device do nothing.
+     */
+    virtual void flush();
+
+    /**
+     * Destructor.
+     */
+    virtual ~OutputSink() = default;
+};
+
+/**
+ * @class StreamSink
+ * @brief Writes to an std::ostream (std::cout, an std::ofstream, ...) without touching its formatting flags.
+ */
+class StreamSink : public OutputSink {
+public:
+    /**
+     * Parameterized constructor.
+     * @param stream A reference to the stream that receives the text. It must outlive the sink.
+     */
+    explicit StreamSink(std::ostream& stream);
+
+    void write(const char* data, size_t size) override;
+    void flush() override;
+
+private:
+    std::ostream& stream_;
+};
+
+/**
+ * @class FileDescriptorSink
+ * @brief Writes straight to a POSIX file descriptor (a file, pipe or the terminal), gathering blocks with writev().
+ */
+class FileDescriptorSink : public OutputSink {
+public:
+    /**
+     * Parameterized constructor.
+     * @param fd The open file descriptor that receives the text. The sink does not close it.
+     */
+    explicit FileDescriptorSink(int fd);
+
+    void write(const char* data, size_t size) override;
+    void writeGather(const std::string_view* blocks, size_t count) override;
+
+    /**
+     * @return True if every write so far succeeded, false otherwise.
+     */
+    bool good() const;
+
+private:
+    int fd_;
+    bool good_;
+};
+
+/**
+ * @class StringSink
+ * @brief Appends to an in-memory string.
+ */
+class StringSink : public OutputSink {
+public:
+    /**
+     * Default constructor.
+     * Initializes an empty string.
+     */
+    StringSink();
+
+    void write(const char* data, size_t size) override;
+
+    /**
+     * @return A const reference to everything written so far.
+     */
+    const std::string& str() const;
+
+    /**
+     * @post The collected string is empty but keeps its capacity.
+     */
+    void clear();
+
+private:
+    std::string text_;
+};
+
+/**
+ * @class NullSink
+ * @brief Discards the text and only counts how many bytes were written.
+ */
+class NullSink : public OutputSink {
+public:
+    /**
+     * Default constructor.
+     * Initializes the byte count to 0.
+     */
+    NullSink();
+
+    void write(const char* data, size_t size) override;
+
+    /**
+     * @return The total number of bytes written to the sink.
+     */
+    size_t bytesWritten() const;
+
+private:
+    size_t bytes_written_;
+};
+
+#endif // OUTPUT_SINK_HPP
@@ -0,0 +1,84 @@
+/**
+ * @file ParallelMenuRenderer.cpp
+ * @brief This file contains the implementation of the ParallelMenuRenderer class, which formats a menu on several threads.
+ *
+ * @date October 17, 2026
+ * @author Kun Feng Wei
+ */
+
+#include "ParallelMenuRenderer.hpp"
+#include "Dish.hpp"
+#include <string_view>
+#include <thread>
+
+/**
+ * Parameterized constructor.
+ * @param thread_count The maximum number of worker threads. 0 uses std::thread::hardware_concurrency().
+ */
+ParallelMenuRenderer::ParallelMenuRenderer(int thread_count)
+    : thread_count_(thread_count), used_buffers_(0), buffers_() {
+    if (thread_count_ <= 0) {
+        thread_count_ = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    if (thread_count_ <= 0) {
+        thread_count_ = 1;
+    }
+    buffers_.resize(thread_count_);
+}
+
+int ParallelMenuRenderer::getThreadCount() const {
+    return thread_count_;
+}
+
+/**
+ * Formats a range of dishes, splitting it across the worker threads.
+ * @param dishes A pointer to the first `Dish*` of the range.
+ * @param count The number of dishes in the range.
+ * @post Each used buffer holds the display text of one contiguous chunk of the range.
+ *       Ranges too small to be worth splitting are formatted on the calling thread.
+ */
+void ParallelMenuRenderer::renderMenu(Dish* const* dishes, int count) {
+    int chunks = thread_count_;
+    if (count / MIN_DISHES_PER_THREAD < chunks) {
+        chunks = count / MIN_DISHES_PER_THREAD;
+    }
+    if (chunks < 1) {
+        chunks = 1;
+    }
+    used_buffers_ = chunks;
+
+    // Chunk i covers [i * count / chunks, (i + 1) * count / chunks), so every dish lands in exactly one chunk, in order
+    std::vector<std::thread> workers;
+    workers.reserve(chunks - 1);
+    for (int i = 1; i < chunks; i++) {
+        int begin = static_cast<int>(static_cast<long long>(i) * count / chunks);
+        int end = static_cast<int>(static_cast<long long>(i + 1) * count / chunks);
+        MenuRenderer* buffer = &buffers_[i];
+        workers.emplace_back([buffer, dishes, begin, end]() {
+            buffer->renderMenu(dishes + begin, end - begin);
+        });
+    }
+    // The calling thread formats the first chunk itself
+    buffers_[0].renderMenu(dishes, static_cast<int>(static_cast<long long>(count) / chunks));
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+void ParallelMenuRenderer::emit(OutputSink& out) const {
+    std::vector<std::string_view> blocks;
+    blocks.reserve(used_buffers_);
+    for (int i = 0; i < used_buffers_; i++) {
+        blocks.push_back(buffers_[i].str());
+    }
+    out.writeGather(blocks.data(), blocks.size());
+    out.flush();
+}
+
+std::string ParallelMenuRenderer::str() const {
+    std::string text;
+    for (int i = 0; i < used_buffers_; i++) {
+        text += buffers_[i].str();
+    }
+    return text;
+}
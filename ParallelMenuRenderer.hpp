@@ -0,0 +1,70 @@
+/**
+ * @file ParallelMenuRenderer.hpp
+ * @brief This file contains the declaration of the ParallelMenuRenderer class, which formats a menu on several threads.
+ *
+ * The dish range is split into contiguous chunks, one per worker thread. Each worker formats its chunk into its own
+ * MenuRenderer, and the buffers are written to the sink in chunk order with a single gathered write, so the output is
+ * identical to MenuRenderer::renderMenu().
+ *
+ * @date October 17, 2026
+ * @author Kun Feng Wei
+ */
+
+#ifndef PARALLEL_MENU_RENDERER_HPP
+#define PARALLEL_MENU_RENDERER_HPP
+
+#include "MenuRenderer.hpp"
+#include "OutputSink.hpp"
+#include <vector>
+
+class Dish;
+
+class ParallelMenuRenderer {
+public:
+    /**
+     * Parameterized constructor.
+     * @param thread_count The maximum number of worker threads. 0 uses std::thread::hardware_concurrency().
+     */
+    explicit ParallelMenuRenderer(int thread_count = 0);
+
+    /**
+     * @return The maximum number of worker threads.
+     */
+    int getThreadCount() const;
+
+    /**
+     * @param count The number of dishes in a range.
+     * @return True if renderMenu() would use more than one thread for the range, given enough threads.
+     */
+    static bool worthSplitting(int count) { return count / MIN_DISHES_PER_THREAD >= 2; }
+
+    /**
+     * Formats a range of dishes, splitting it across the worker threads.
+     * @param dishes A pointer to the first `Dish*` of the range.
+     * @param count The number of dishes in the range.
+     * @post Each used buffer holds the display text of one contiguous chunk of the range.
+     *       Ranges too small to be worth splitting are formatted on the calling thread.
+     */
+    void renderMenu(Dish* const* dishes, int count);
+
+    /**
+     * Writes the buffers to the sink in order with one gathered write, followed by one flush.
+     * @param out The sink to write to.
+     */
+    void emit(OutputSink& out) const;
+
+    /**
+     * @return The concatenated text of all buffers, in order.
+     */
+    std::string str() const;
+
+    static const int MIN_DISHES_PER_THREAD = 256; // below this a thread costs more than it saves
+
+private:
+
+    int thread_count_;
+    int used_buffers_;
+    std::vector<MenuRenderer> buffers_; // one per worker, reused between calls
+};
+
+#endif // PARALLEL_MENU_RENDERER_HPP
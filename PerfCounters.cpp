@@ -0,0 +1,101 @@
+/**
+ * @file PerfCounters.cpp
+ * @brief This file contains the implementation of the PerfCounters class, a small wrapper around Linux perf_event_open().
+ *
+ * @date October 17, 2026
+ * @author Kun Feng Wei
+ */
+
+#include "PerfCounters.hpp"
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// Opens one hardware counter for the calling thread, disabled, or returns -1
+static int openCounter(uint64_t config)
+{
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+/**
+ * Default constructor.
+ * Opens one counter per event for the calling thread; events the system refuses are left unavailable.
+ */
+PerfCounters::PerfCounters()
+{
+    static const uint64_t CONFIGS[EVENT_COUNT] = {
+        PERF_COUNT_HW_CACHE_REFERENCES,
+        PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CPU_CYCLES,
+    };
+    for (int i = 0; i < EVENT_COUNT; i++)
+    {
+        fds_[i] = openCounter(CONFIGS[i]);
+        values_[i] = 0;
+    }
+}
+
+/**
+ * Destructor.
+ * @post Closes the counters.
+ */
+PerfCounters::~PerfCounters()
+{
+    for (int i = 0; i < EVENT_COUNT; i++)
+    {
+        if (fds_[i] >= 0)
+        {
+            close(fds_[i]);
+        }
+    }
+}
+
+bool PerfCounters::available() const
+{
+    return fds_[CACHE_MISSES] >= 0;
+}
+
+void PerfCounters::start()
+{
+    for (int i = 0; i < EVENT_COUNT; i++)
+    {
+        values_[i] = 0;
+        if (fds_[i] >= 0)
+        {
+            ioctl(fds_[i], PERF_EVENT_IOC_RESET, 0);
+            ioctl(fds_[i], PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+}
+
+void PerfCounters::stop()
+{
+    for (int i = 0; i < EVENT_COUNT; i++)
+    {
+        if (fds_[i] >= 0)
+        {
+            ioctl(fds_[i], PERF_EVENT_IOC_DISABLE, 0);
+            uint64_t value = 0;
+            if (read(fds_[i], &value, sizeof(value)) == static_cast<ssize_t>(sizeof(value)))
+            {
+                values_[i] = value;
+            }
+        }
+    }
+}
+
+uint64_t PerfCounters::get(Event event) const
+{
+    return values_[event];
+}
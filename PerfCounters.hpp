@@ -0,0 +1,66 @@
+/**
+ * @file PerfCounters.hpp
+ * @brief This file contains the declaration of the PerfCounters class, a small wrapper around Linux perf_event_open().
+ *
+ * PerfCounters counts hardware events (cache references, cache misses, instructions, cycles) for the calling thread
+ * between start() and stop(). When the kernel or the sandbox does not allow perf events, available() returns false and
+ * every count reads as 0, so callers can still run and report wall time.
+ *
+ * @date October 17, 2026
+ * @author Kun Feng Wei
+ */
+
+#ifndef PERF_COUNTERS_HPP
+#define PERF_COUNTERS_HPP
+
+#include <cstdint>
+
+class PerfCounters {
+public:
+    /**
+     * The hardware events that are counted.
+     */
+    enum Event { CACHE_REFERENCES, CACHE_MISSES, INSTRUCTIONS, CYCLES, EVENT_COUNT };
+
+    /**
+     * Default constructor.
+     * Opens one counter per event for the calling thread; events the system refuses are left unavailable.
+     */
+    PerfCounters();
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    /**
+     * Destructor.
+     * @post Closes the counters.
+     */
+    ~PerfCounters();
+
+    /**
+     * @return True if at least the cache miss counter could be opened, false otherwise.
+     */
+    bool available() const;
+
+    /**
+     * Resets and enables all counters.
+     */
+    void start();
+
+    /**
+     * Disables all counters and reads their values.
+     */
+    void stop();
+
+    /**
+     * @param event The event to read.
+     * @return The count of `event` between the last start() and stop(), or 0 if it is unavailable.
+     */
+    uint64_t get(Event event) const;
+
+private:
+    int fds_[EVENT_COUNT];
+    uint64_t values_[EVENT_COUNT];
+};
+
+#endif // PERF_COUNTERS_HPP
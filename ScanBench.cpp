@@ -0,0 +1,150 @@
+/**
+ * @file ScanBench.cpp
+ * @brief This file contains a benchmark comparing aggregate scans through `Dish*` with scans over packed DishHeaders.
+ *
+ * Builds N dishes (1,000,000 by default) in a shuffled pointer order, as a long-running kitchen's heap would be, then
+ * runs the same aggregate (prep time sum, cuisine tally, count below a prep time) through the pointers and through a
+ * DishHeader array. Prints the best wall time of several runs and, where perf events are allowed, cache misses per dish.
+ *
+ * Usage: ./scanbench [dish_count]
+ *
+ * @date October 17, 2026
+ * @author Kun Feng Wei
+ */
+
+#include "Appetizer.hpp"
+#include "MainCourse.hpp"
+#include "Dessert.hpp"
+#include "DishHeader.hpp"
+#include "PerfCounters.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// Result of one aggregate scan; summed so the compiler cannot drop the loop
+struct ScanResult
+{
+    long long prep_time_sum;
+    int tally[7];
+    int below_threshold;
+};
+
+static const int RUNS = 5;
+static const int PREP_TIME_THRESHOLD = 30;
+
+static ScanResult scanPointers(const std::vector<Dish*>& dishes)
+{
+    ScanResult result = {};
+    for (const Dish* dish : dishes)
+    {
+        int prep_time = dish->getPrepTime();
+        result.prep_time_sum += prep_time;
+        result.tally[dish->getCuisineTypeEnum()]++;
+        result.below_threshold += prep_time < PREP_TIME_THRESHOLD;
+    }
+    return result;
+}
+
+static ScanResult scanHeaders(const std::vector<DishHeader>& headers)
+{
+    ScanResult result = {};
+    for (const DishHeader& header : headers)
+    {
+        result.prep_time_sum += header.prep_time;
+        result.tally[header.cuisine_type]++;
+        result.below_threshold += header.prep_time < PREP_TIME_THRESHOLD;
+    }
+    return result;
+}
+
+// Runs a scan RUNS times and prints its best time and counters
+template <class Scan>
+static void report(const char* label, size_t dish_count, Scan scan)
+{
+    PerfCounters counters;
+    double best_ms = 0;
+    uint64_t misses = 0, references = 0;
+    long long checksum = 0;
+    for (int run = 0; run < RUNS; run++)
+    {
+        counters.start();
+        std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+        ScanResult result = scan();
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+        counters.stop();
+        checksum = result.prep_time_sum + result.below_threshold + result.tally[0];
+
+        double ms = std::chrono::duration<double, std::milli>(end - begin).count();
+        if (run == 0 || ms < best_ms)
+        {
+            best_ms = ms;
+            misses = counters.get(PerfCounters::CACHE_MISSES);
+            references = counters.get(PerfCounters::CACHE_REFERENCES);
+        }
+    }
+
+    std::cout << label << ": " << best_ms << " ms, " << best_ms * 1e6 / dish_count << " ns/dish";
+    if (counters.available())
+    {
+        std::cout << ", " << double(misses) / dish_count << " cache misses/dish"
+                  << ", " << double(references) / dish_count << " cache refs/dish";
+    }
+    else
+    {
+        std::cout << ", cache counters unavailable";
+    }
+    std::cout << " (checksum " << checksum << ")" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    size_t dish_count = 1000000;
+    if (argc > 1)
+    {
+        dish_count = std::strtoul(argv[1], nullptr, 10);
+    }
+
+    std::mt19937 rng(235);
+    std::vector<Dish*> dishes;
+    dishes.reserve(dish_count);
+    for (size_t i = 0; i < dish_count; i++)
+    {
+        int prep_time = 5 + static_cast<int>(rng() % 120);
+        double price = 3.0 + (rng() % 2000) / 100.0;
+        Dish::CuisineType cuisine = static_cast<Dish::CuisineType>(rng() % 7);
+        std::vector<std::string> ingredients = {"Flour", "Sugar", "Butter", "Eggs"};
+        switch (i % 3)
+        {
+            case 0:
+                dishes.push_back(new Appetizer("Spring Rolls", ingredients, prep_time, price, cuisine, Appetizer::BUFFET, 3, true));
+                break;
+            case 1:
+                dishes.push_back(new MainCourse("Pot Roast", ingredients, prep_time, price, cuisine, MainCourse::BAKED, "Beef", {{"Rice", MainCourse::GRAIN}}, false));
+                break;
+            default:
+                dishes.push_back(new Dessert("Carrot Cake", ingredients, prep_time, price, cuisine, Dessert::SWEET, 5, false));
+                break;
+        }
+    }
+    std::shuffle(dishes.begin(), dishes.end(), rng);
+
+    std::vector<DishHeader> headers;
+    headers.reserve(dish_count);
+    for (const Dish* dish : dishes)
+    {
+        headers.push_back(DishHeader::of(*dish));
+    }
+
+    std::cout << "Scanning " << dish_count << " dishes (" << sizeof(DishHeader) << "-byte headers)" << std::endl;
+    report("Dish* scan     ", dish_count, [&]() { return scanPointers(dishes); });
+    report("DishHeader scan", dish_count, [&]() { return scanHeaders(headers); });
+
+    for (Dish* dish : dishes)
+    {
+        delete dish;
+    }
+    return 0;
+}
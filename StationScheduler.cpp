@@ -0,0 +1,296 @@
+/**
+ * @file StationScheduler.cpp
+ * @brief This file contains the implementation of the StationScheduler class, which assigns dishes to cook stations by prep time.
+ *
+ * @date October 17, 2026
+ * @author Kun Feng Wei
+ */
+
+#include "StationScheduler.hpp"
+#include "Kitchen.hpp"
+#include <algorithm>
+#include <functional>
+#include <queue>
+
+StationScheduler::StationScheduler(int station_count, Policy policy)
+    : kitchen_(nullptr), policy_(policy), stations_(std::max(1, station_count)), by_load_(), slot_of_(), slots_(), free_slots_(), next_sequence_(0) {
+    for (size_t i = 0; i < stations_.size(); i++) {
+        stations_[i].load = 0;
+        by_load_.insert(std::make_pair(0, static_cast<int>(i)));
+    }
+}
+
+StationScheduler::StationScheduler(const Kitchen& kitchen, int station_count, Policy policy) : StationScheduler(station_count, policy) {
+    kitchen_ = &kitchen;
+    kitchen_->attachScheduler(this);
+    reload();
+}
+
+StationScheduler::~StationScheduler() {
+    if (kitchen_ != nullptr) {
+        kitchen_->detachScheduler(this);
+    }
+}
+
+bool StationScheduler::before(const Job& a, const Job& b) const {
+    if (policy_ == EDF) {
+        if (a.deadline != b.deadline) {
+            return a.deadline < b.deadline;
+        }
+        if (a.prep_time != b.prep_time) {
+            return a.prep_time < b.prep_time;
+        }
+    } else if (a.prep_time != b.prep_time) {
+        return a.prep_time > b.prep_time;
+    }
+    return a.sequence < b.sequence;
+}
+
+void StationScheduler::setLoad(int station, int load) {
+    by_load_.erase(std::make_pair(stations_[station].load, station));
+    stations_[station].load = load;
+    by_load_.insert(std::make_pair(load, station));
+}
+
+// Inserts a job into a station's queue at its policy position
+void StationScheduler::place(const Job& job, int station) {
+    std::vector<Job>& jobs = stations_[station].jobs;
+    jobs.insert(std::upper_bound(jobs.begin(), jobs.end(), job, [this](const Job& a, const Job& b) { return before(a, b); }), job);
+    setLoad(station, stations_[station].load + job.prep_time);
+    slots_[job.slot] = {station, job};
+}
+
+// Takes a job out of its station's queue; its slot stays allocated
+void StationScheduler::unplace(const Placement& placement) {
+    std::vector<Job>& jobs = stations_[placement.station].jobs;
+    // The order is strict, so the lower bound is the job itself
+    jobs.erase(std::lower_bound(jobs.begin(), jobs.end(), placement.job, [this](const Job& a, const Job& b) { return before(a, b); }));
+    setLoad(placement.station, stations_[placement.station].load - placement.job.prep_time);
+}
+
+int StationScheduler::allocateSlot(const Dish* dish) {
+    int slot;
+    if (free_slots_.empty()) {
+        slot = static_cast<int>(slots_.size());
+        slots_.push_back(Placement());
+    } else {
+        slot = free_slots_.back();
+        free_slots_.pop_back();
+    }
+    slot_of_[dish] = slot;
+    return slot;
+}
+
+bool StationScheduler::add(const Dish* dish, int deadline) {
+    if (slot_of_.count(dish) != 0) {
+        return false;
+    }
+    Job job = {dish->getPrepTime(), deadline, next_sequence_++, allocateSlot(dish), dish};
+    place(job, by_load_.begin()->second);
+    return true;
+}
+
+bool StationScheduler::remove(const Dish* dish) {
+    std::unordered_map<const Dish*, int>::iterator found = slot_of_.find(dish);
+    if (found == slot_of_.end()) {
+        return false;
+    }
+    unplace(slots_[found->second]);
+    free_slots_.push_back(found->second);
+    slot_of_.erase(found);
+    return true;
+}
+
+bool StationScheduler::setDeadline(const Dish* dish, int deadline) {
+    std::unordered_map<const Dish*, int>::iterator found = slot_of_.find(dish);
+    if (found == slot_of_.end()) {
+        return false;
+    }
+    Placement placement = slots_[found->second];
+    unplace(placement);
+    placement.job.deadline = deadline;
+    place(placement.job, placement.station);
+    return true;
+}
+
+void StationScheduler::rebalance() {
+    std::vector<Job> jobs;
+    jobs.reserve(slot_of_.size());
+    for (Station& station : stations_) {
+        jobs.insert(jobs.end(), station.jobs.begin(), station.jobs.end());
+        station.jobs.clear();
+        station.load = 0;
+    }
+    std::sort(jobs.begin(), jobs.end(), [this](const Job& a, const Job& b) { return before(a, b); });
+
+    // Each job goes to the station that frees up first; jobs arrive in policy order, so every queue stays sorted
+    typedef std::pair<int, int> LoadAndStation;
+    std::priority_queue<LoadAndStation, std::vector<LoadAndStation>, std::greater<LoadAndStation>> free_at;
+    for (size_t i = 0; i < stations_.size(); i++) {
+        free_at.push(std::make_pair(0, static_cast<int>(i)));
+    }
+    for (const Job& job : jobs) {
+        LoadAndStation next = free_at.top();
+        free_at.pop();
+        stations_[next.second].jobs.push_back(job);
+        stations_[next.second].load = next.first + job.prep_time;
+        slots_[job.slot].station = next.second;
+        free_at.push(std::make_pair(stations_[next.second].load, next.second));
+    }
+
+    by_load_.clear();
+    for (size_t i = 0; i < stations_.size(); i++) {
+        by_load_.insert(std::make_pair(stations_[i].load, static_cast<int>(i)));
+    }
+}
+
+int StationScheduler::size() const {
+    return static_cast<int>(slot_of_.size());
+}
+
+int StationScheduler::stationCount() const {
+    return static_cast<int>(stations_.size());
+}
+
+StationScheduler::Policy StationScheduler::policy() const {
+    return policy_;
+}
+
+int StationScheduler::stationOf(const Dish* dish) const {
+    std::unordered_map<const Dish*, int>::const_iterator found = slot_of_.find(dish);
+    return found == slot_of_.end() ? -1 : slots_[found->second].station;
+}
+
+int StationScheduler::load(int station) const {
+    return stations_[station].load;
+}
+
+int StationScheduler::makespan() const {
+    return by_load_.rbegin()->first;
+}
+
+int StationScheduler::makespanLowerBound() const {
+    long long total = 0;
+    int longest = 0;
+    for (const Station& station : stations_) {
+        total += station.load;
+        if (!station.jobs.empty()) {
+            longest = std::max(longest, std::max_element(station.jobs.begin(), station.jobs.end(),
+                [](const Job& a, const Job& b) { return a.prep_time < b.prep_time; })->prep_time);
+        }
+    }
+    long long average = (total + stationCount() - 1) / stationCount();
+    return static_cast<int>(std::max<long long>(average, longest));
+}
+
+std::vector<StationScheduler::Assignment> StationScheduler::assignments() const {
+    std::vector<Assignment> result;
+    result.reserve(slot_of_.size());
+    for (size_t i = 0; i < stations_.size(); i++) {
+        int time = 0;
+        for (const Job& job : stations_[i].jobs) {
+            result.push_back({job.dish, static_cast<int>(i), time, time + job.prep_time, job.deadline});
+            time += job.prep_time;
+        }
+    }
+    return result;
+}
+
+int StationScheduler::lateCount() const {
+    int late = 0;
+    for (const Station& station : stations_) {
+        int time = 0;
+        for (const Job& job : station.jobs) {
+            time += job.prep_time;
+            if (job.deadline != NO_DEADLINE && time > job.deadline) {
+                late++;
+            }
+        }
+    }
+    return late;
+}
+
+void StationScheduler::writeText(MenuRenderer& out, bool list_dishes) const {
+    out.append("schedule: ").append(POLICY_INFO[policy_].token).append(", ").appendInt(stationCount()).append(" stations, ");
+    out.appendInt(size()).append(" dishes, makespan ").appendInt(makespan()).append(" min (lower bound ");
+    out.appendInt(makespanLowerBound()).append("), ").appendInt(lateCount()).append(" late\n");
+    for (size_t i = 0; i < stations_.size(); i++) {
+        out.append("station ").appendInt(static_cast<long long>(i + 1)).append(": ").appendInt(static_cast<long long>(stations_[i].jobs.size()));
+        out.append(" dishes, ").appendInt(stations_[i].load).append(" min\n");
+        if (!list_dishes) {
+            continue;
+        }
+        int time = 0;
+        for (const Job& job : stations_[i].jobs) {
+            out.append("  ").appendInt(time).append('-').appendInt(time + job.prep_time).append(' ').append(job.dish->getName());
+            if (job.deadline != NO_DEADLINE) {
+                out.append(" (due ").appendInt(job.deadline).append(time + job.prep_time > job.deadline ? ", late)" : ")");
+            }
+            out.append('\n');
+            time += job.prep_time;
+        }
+    }
+}
+
+void StationScheduler::dishAdded(const Dish* dish) {
+    add(dish);
+}
+
+void StationScheduler::dishRemoved(const Dish* dish) {
+    remove(dish);
+}
+
+void StationScheduler::dishChanged(const Dish* dish) {
+    std::unordered_map<const Dish*, int>::iterator found = slot_of_.find(dish);
+    if (found == slot_of_.end() || slots_[found->second].job.prep_time == dish->getPrepTime()) {
+        return;
+    }
+    // The dish stays on its station, like an incremental add(); rebalance() spreads the change
+    Placement placement = slots_[found->second];
+    unplace(placement);
+    placement.job.prep_time = dish->getPrepTime();
+    place(placement.job, placement.station);
+}
+
+void StationScheduler::kitchenRefreshed() {
+    reload();
+}
+
+void StationScheduler::kitchenDestroyed() {
+    kitchen_ = nullptr;
+    slot_of_.clear();
+    slots_.clear();
+    free_slots_.clear();
+    for (size_t i = 0; i < stations_.size(); i++) {
+        stations_[i].jobs.clear();
+        setLoad(static_cast<int>(i), 0);
+    }
+}
+
+void StationScheduler::reload() {
+    std::unordered_map<const Dish*, Job> previous;
+    for (const std::pair<const Dish* const, int>& entry : slot_of_) {
+        previous[entry.first] = slots_[entry.second].job;
+    }
+    slot_of_.clear();
+    slots_.clear();
+    free_slots_.clear();
+    for (Station& station : stations_) {
+        station.jobs.clear();
+    }
+    // rebalance() takes the jobs from the stations, so park them all on the first one
+    for (int i = 0; i < kitchen_->getCurrentSize(); i++) {
+        const Dish* dish = kitchen_->items_[i];
+        std::unordered_map<const Dish*, Job>::const_iterator found = previous.find(dish);
+        Job job = {dish->getPrepTime(), NO_DEADLINE, 0, allocateSlot(dish), dish};
+        if (found != previous.end()) {
+            job.deadline = found->second.deadline;
+            job.sequence = found->second.sequence;
+        } else {
+            job.sequence = next_sequence_++;
+        }
+        stations_[0].jobs.push_back(job);
+        slots_[job.slot] = {0, job};
+    }
+    rebalance();
+}
@@ -0,0 +1,246 @@
+/**
+ * @file StationScheduler.hpp
+ * @brief This file contains the declaration of the StationScheduler class, which assigns dishes to cook stations by prep time.
+ *
+ * Each of N stations cooks its dishes one after another, so a station's load is the sum of its prep times and the
+ * makespan, the time until the last dish is done, is the largest load. Two policies are offered:
+ *
+ *   LPT  longest prep time first: rebalance() sorts every dish by prep time, longest first, and gives each to the
+ *        least loaded station, which keeps the makespan within 4/3 of the optimum; a station cooks longest first.
+ *   EDF  earliest deadline first: rebalance() gives the dishes, by deadline, to the station that frees up first, and
+ *        a station cooks earliest deadline first (shortest first among equal deadlines), which minimizes the maximum
+ *        lateness on one station. It does not minimize the number of late dishes; that takes Moore-Hodgson, which
+ *        drops the longest dish whenever one runs late.
+ *
+ * Between rebalances the schedule is updated incrementally: add() puts a dish on the least loaded station and
+ * remove() takes it off, each in O(log N) plus a move of the station's queue, so a stream of orders never triggers a
+ * full resort. Incremental placement is greedy list scheduling, within twice the optimal makespan; call rebalance()
+ * to tighten it again. Deadlines and times are in minutes from the moment the schedule starts.
+ *
+ * A scheduler built on a Kitchen follows it: the kitchen tells it about every dish newOrder() or newOrders() adds and
+ * every dish serveDish() (and so every release) removes, and it rereads a dish's prep time whenever that dish changes
+ * through its mutators or dietaryAdjustment(), moving it within its station's queue. refreshDishHeaders() reloads and
+ * rebalances the whole schedule.
+ * The scheduler only stores `const Dish*` and never owns a dish.
+ *
+ * @date October 17, 2026
+ * @author Kun Feng Wei
+ */
+
+#ifndef STATION_SCHEDULER_HPP
+#define STATION_SCHEDULER_HPP
+
+#include "Dish.hpp"
+#include "EnumTable.hpp"
+#include "MenuRenderer.hpp"
+#include <climits>
+#include <cstdint>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class Kitchen;
+
+class StationScheduler {
+public:
+    /**
+     * The scheduling policies.
+     */
+    enum Policy
+    {
+        LPT,
+        EDF,
+        POLICY_COUNT
+    };
+
+    /**
+     * Metadata of each policy; the token is the name accepted on the command line.
+     */
+    static constexpr EnumInfo<Policy> POLICY_INFO[] = {
+        {LPT, "LPT", "Longest prep time first", 0},
+        {EDF, "EDF", "Earliest deadline first", 0},
+    };
+
+    /**
+     * The deadline of a dish that has none.
+     */
+    static const int NO_DEADLINE = INT_MAX;
+
+    /**
+     * Where and when one dish is cooked.
+     */
+    struct Assignment
+    {
+        const Dish* dish;
+        int station;   ///< Index of the station, from 0.
+        int start;     ///< Minute the station starts the dish.
+        int finish;    ///< Minute the dish is done.
+        int deadline;  ///< The dish's deadline, or NO_DEADLINE.
+    };
+
+    /**
+     * Parameterized constructor for a standalone schedule, filled with add().
+     * @param station_count The number of stations, at least 1.
+     * @param policy The scheduling policy.
+     */
+    StationScheduler(int station_count, Policy policy);
+
+    /**
+     * Parameterized constructor for a schedule that follows a kitchen.
+     * @param kitchen The kitchen whose dishes are scheduled.
+     * @param station_count The number of stations, at least 1.
+     * @param policy The scheduling policy.
+     * @post Every dish in the kitchen is scheduled without a deadline, and the scheduler is registered with the kitchen.
+     */
+    StationScheduler(const Kitchen& kitchen, int station_count, Policy policy);
+
+    StationScheduler(const StationScheduler&) = delete;
+    StationScheduler& operator=(const StationScheduler&) = delete;
+
+    /**
+     * Destructor.
+     * @post Unregisters the scheduler from its kitchen, if any.
+     */
+    ~StationScheduler();
+
+    /**
+     * Puts a dish on the least loaded station, in policy order within that station's queue.
+     * @param dish The dish to schedule; its prep time is read now.
+     * @param deadline The minute the dish should be done by, or NO_DEADLINE.
+     * @return True if the dish was added, false if it is already scheduled.
+     */
+    bool add(const Dish* dish, int deadline = NO_DEADLINE);
+
+    /**
+     * Takes a dish off its station.
+     * @param dish The dish to remove.
+     * @return True if the dish was scheduled, false otherwise.
+     */
+    bool remove(const Dish* dish);
+
+    /**
+     * Changes the deadline of a scheduled dish, moving it within its station's queue.
+     * @param dish The dish whose deadline changes.
+     * @param deadline The new deadline, or NO_DEADLINE.
+     * @return True if the dish is scheduled, false otherwise.
+     */
+    bool setDeadline(const Dish* dish, int deadline);
+
+    /**
+     * Reassigns every dish from scratch with the policy's heuristic (see the file comment). O(n log n).
+     */
+    void rebalance();
+
+    /**
+     * @return The number of scheduled dishes.
+     */
+    int size() const;
+
+    /**
+     * @return The number of stations.
+     */
+    int stationCount() const;
+
+    /**
+     * @return The scheduling policy.
+     */
+    Policy policy() const;
+
+    /**
+     * @param dish A dish.
+     * @return The index of the station cooking it, or -1 if it is not scheduled.
+     */
+    int stationOf(const Dish* dish) const;
+
+    /**
+     * @param station The index of a station.
+     * @return The sum of the prep times on that station.
+     */
+    int load(int station) const;
+
+    /**
+     * @return The largest station load, i.e. the minute the last dish is done.
+     */
+    int makespan() const;
+
+    /**
+     * @return A lower bound on any schedule's makespan: the larger of the average station load (rounded up) and
+     * the longest prep time.
+     */
+    int makespanLowerBound() const;
+
+    /**
+     * @return Every dish with its station and times, station by station in cooking order. O(n).
+     */
+    std::vector<Assignment> assignments() const;
+
+    /**
+     * @return The number of dishes that finish after their deadline. O(n).
+     */
+    int lateCount() const;
+
+    /**
+     * Appends a summary line, then one line per station, e.g.
+     * "schedule: LPT, 4 stations, 99 dishes, makespan 690 min (lower bound 672), 0 late".
+     * @param out The renderer receiving the text.
+     * @param list_dishes True to also append one line per dish under its station.
+     */
+    void writeText(MenuRenderer& out, bool list_dishes) const;
+
+private:
+    friend class Kitchen;
+
+    struct Job
+    {
+        int prep_time;
+        int deadline;
+        uint64_t sequence;  // order of arrival; makes the policy order strict, so a job's position is unique
+        int slot;           // index of the job's placement in slots_
+        const Dish* dish;
+    };
+
+    struct Station
+    {
+        std::vector<Job> jobs;  // in cooking order
+        int load;
+    };
+
+    // Where a scheduled dish sits; kept in a dense array so rebalance() updates it without hashing
+    struct Placement
+    {
+        int station;
+        Job job;
+    };
+
+    // True if `a` is cooked before `b` on the same station
+    bool before(const Job& a, const Job& b) const;
+
+    void place(const Job& job, int station);
+    void unplace(const Placement& placement);
+    int allocateSlot(const Dish* dish);
+    void setLoad(int station, int load);
+
+    // Called by the kitchen
+    void dishAdded(const Dish* dish);
+    void dishRemoved(const Dish* dish);
+    void dishChanged(const Dish* dish);
+    void kitchenRefreshed();
+    void kitchenDestroyed();
+
+    // Reschedules the kitchen's dishes with their current prep times, keeping deadlines
+    void reload();
+
+    const Kitchen* kitchen_;
+    Policy policy_;
+    std::vector<Station> stations_;
+    std::set<std::pair<int, int>> by_load_;  // (load, station), so the least and most loaded are at the ends
+    std::unordered_map<const Dish*, int> slot_of_;  // dish -> index in slots_
+    std::vector<Placement> slots_;
+    std::vector<int> free_slots_;                   // indexes in slots_ of removed dishes, reused by add()
+    uint64_t next_sequence_;
+};
+
+static_assert(isIndexedByValue(StationScheduler::POLICY_INFO), "POLICY_INFO must be in enum order");
+
+#endif // STATION_SCHEDULER_HPP
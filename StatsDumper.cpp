@@ -0,0 +1,75 @@
+/**
+ * @file StatsDumper.cpp
+ * @brief This file contains the implementation of the StatsDumper class, which appends Kitchen statistics to a text file periodically.
+ *
+ * @date October 17, 2026
+ * @author Kun Feng Wei
+ */
+
+#include "StatsDumper.hpp"
+#include "KitchenStats.hpp"
+#include "MenuRenderer.hpp"
+#include "OutputSink.hpp"
+#include <fstream>
+
+/**
+ * Parameterized constructor.
+ * @param filename The text file the blocks are appended to.
+ * @param interval_ms The time between two blocks in milliseconds.
+ * @post Starts the background thread.
+ */
+StatsDumper::StatsDumper(const std::string& filename, int interval_ms)
+    : filename_(filename), interval_(interval_ms), start_(std::chrono::steady_clock::now()), mutex_(), wake_(),
+      stopping_(false), thread_(&StatsDumper::run, this) {
+}
+
+/**
+ * Destructor.
+ * @post Calls stop().
+ */
+StatsDumper::~StatsDumper() {
+    stop();
+}
+
+void StatsDumper::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_one();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+bool StatsDumper::dumpNow() {
+    std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - start_;
+    MenuRenderer out;
+    out.append("# elapsed_ms=").appendInt(static_cast<long long>(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count())).append('\n');
+    KitchenStats& stats = KitchenStats::instance();
+    stats.snapshot().writeText(out);
+    stats.writeLatencies(out);
+    out.append('\n');
+
+    std::ofstream file(filename_, std::ios::app);
+    if (!file.is_open()) {
+        return false;
+    }
+    StreamSink sink(file);
+    out.emit(sink);
+    return file.good();
+}
+
+void StatsDumper::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stopping_) {
+        // Sleeps for one interval unless stop() wakes it early
+        if (!wake_.wait_for(lock, interval_, [this]() { return stopping_; })) {
+            lock.unlock();
+            dumpNow();
+            lock.lock();
+        }
+    }
+    lock.unlock();
+    dumpNow();
+}
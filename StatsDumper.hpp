@@ -0,0 +1,67 @@
+/**
+ * @file StatsDumper.hpp
+ * @brief This file contains the declaration of the StatsDumper class, which appends Kitchen statistics to a text file periodically.
+ *
+ * A StatsDumper owns one background thread. Every interval it takes a KitchenStats snapshot and appends a block to
+ * the file: a "# elapsed_ms=..." line, the counter lines and the latency percentile lines. A final block is written
+ * when the dumper is stopped or destroyed, so short runs still leave one dump.
+ *
+ * Example:
+ *   StatsDumper dumper("kitchen_stats.txt", 1000); // one block per second while `dumper` is alive
+ *
+ * @date October 17, 2026
+ * @author Kun Feng Wei
+ */
+
+#ifndef STATS_DUMPER_HPP
+#define STATS_DUMPER_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+class StatsDumper {
+public:
+    /**
+     * Parameterized constructor.
+     * @param filename The text file the blocks are appended to.
+     * @param interval_ms The time between two blocks in milliseconds.
+     * @post Starts the background thread.
+     */
+    StatsDumper(const std::string& filename, int interval_ms);
+
+    StatsDumper(const StatsDumper&) = delete;
+    StatsDumper& operator=(const StatsDumper&) = delete;
+
+    /**
+     * Destructor.
+     * @post Calls stop().
+     */
+    ~StatsDumper();
+
+    /**
+     * Stops the background thread after it writes one last block. Calling it again does nothing.
+     */
+    void stop();
+
+    /**
+     * Appends one block to the file now, from the calling thread.
+     * @return True if the block was written, false if the file could not be opened.
+     */
+    bool dumpNow();
+
+private:
+    void run();
+
+    std::string filename_;
+    std::chrono::milliseconds interval_;
+    std::chrono::steady_clock::time_point start_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    bool stopping_;
+    std::thread thread_;
+};
+
+#endif // STATS_DUMPER_HPP
@@ -0,0 +1,135 @@
+/**
+ * @file StoreBench.cpp
+ * @brief This file contains a benchmark comparing batch operations on the pointer-based Kitchen with the devirtualized DishStore.
+ *
+ * Part 1 loads the same CSV into a Kitchen (ArrayBag<Dish*>) and a DishStore and repeats each batch operation.
+ * Part 2 builds N dishes (1,000,000 by default) as shuffled `Dish*` and as a DishStore and runs the same operations once.
+ *
+ * Usage: ./storebench [csv_file] [dish_count]
+ *
+ * @date October 17, 2026
+ * @author Kun Feng Wei
+ */
+
+#include "Kitchen.hpp"
+#include "DishStore.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+// Times a callable and returns the elapsed nanoseconds
+template <class Operation>
+static double timeNs(Operation operation)
+{
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    operation();
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - begin).count();
+}
+
+static void printRow(const std::string& operation, double pointer_ns, double store_ns)
+{
+    std::cout << "  " << operation << ": Dish* " << pointer_ns << " ns/dish, DishStore " << store_ns
+              << " ns/dish, speedup " << pointer_ns / store_ns << "x" << std::endl;
+}
+
+static Dish* makeDish(std::mt19937& rng, size_t i)
+{
+    int prep_time = 5 + static_cast<int>(rng() % 120);
+    double price = 3.0 + (rng() % 2000) / 100.0;
+    Dish::CuisineType cuisine = static_cast<Dish::CuisineType>(rng() % 7);
+    switch (i % 3)
+    {
+        case 0:
+            return new Appetizer("Spring Rolls", {"Cabbage", "Pork", "Flour", "Rice Paper"}, prep_time, price, cuisine, Appetizer::BUFFET, 3, false);
+        case 1:
+            return new MainCourse("Pot Roast", {"Beef", "Carrots", "Butter", "Onion"}, prep_time, price, cuisine, MainCourse::BAKED, "Beef", {{"Rice", MainCourse::GRAIN}, {"Salad", MainCourse::SALAD}}, false);
+        default:
+            return new Dessert("Carrot Cake", {"Flour", "Walnuts", "Sugar", "Cream"}, prep_time, price, cuisine, Dessert::SWEET, 5, true);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    std::string filename = argc > 1 ? argv[1] : "Dishes.csv";
+    size_t dish_count = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 1000000;
+    Dish::DietaryRequest request = {true, true, true, true, true, true};
+    long long checksum = 0;
+
+    // Part 1: the real kitchen, capped at ArrayBag's 100 slots
+    {
+        const int repetitions = 20000;
+        Kitchen kitchen(filename);
+        DishStore store;
+        // The kitchen's dishes are not reachable by index from outside, so copy them through a cursor
+        MenuCursor cursor(kitchen);
+        while (const Dish* dish = cursor.nextDish())
+        {
+            store.add(*dish);
+        }
+        double dishes = double(repetitions) * kitchen.getCurrentSize();
+        std::cout << "Kitchen vs DishStore, " << kitchen.getCurrentSize() << " dishes from " << filename << ", "
+                  << repetitions << " repetitions" << std::endl;
+
+        double pointer_ns = timeNs([&]() { for (int r = 0; r < repetitions; r++) checksum += kitchen.tallyCuisineTypes("ITALIAN"); });
+        double store_ns = timeNs([&]() { for (int r = 0; r < repetitions; r++) checksum += store.tallyCuisineTypes(Dish::ITALIAN); });
+        printRow("tallyCuisineTypes  ", pointer_ns / dishes, store_ns / dishes);
+
+        pointer_ns = timeNs([&]() { for (int r = 0; r < repetitions; r++) checksum += kitchen.calculateAvgPrepTime(); });
+        store_ns = timeNs([&]() { for (int r = 0; r < repetitions; r++) checksum += store.calculateAvgPrepTime(); });
+        printRow("calculateAvgPrepTime", pointer_ns / dishes, store_ns / dishes);
+
+        pointer_ns = timeNs([&]() { for (int r = 0; r < repetitions; r++) kitchen.dietaryAdjustment(request); });
+        store_ns = timeNs([&]() { for (int r = 0; r < repetitions; r++) store.dietaryAdjustment(request); });
+        printRow("dietaryAdjustment  ", pointer_ns / dishes, store_ns / dishes);
+    }
+
+    // Part 2: scattered pointers against contiguous partitions at scale
+    {
+        std::mt19937 rng(235);
+        std::vector<Dish*> pointers;
+        pointers.reserve(dish_count);
+        for (size_t i = 0; i < dish_count; i++)
+        {
+            pointers.push_back(makeDish(rng, i));
+        }
+        std::shuffle(pointers.begin(), pointers.end(), rng);
+        DishStore store;
+        store.addAll(pointers.data(), static_cast<int>(pointers.size()));
+        double dishes = double(dish_count);
+        std::cout << "std::vector<Dish*> vs DishStore, " << dish_count << " dishes" << std::endl;
+
+        double pointer_ns = timeNs([&]() {
+            int count = 0;
+            for (const Dish* dish : pointers) count += dish->getCuisineTypeEnum() == Dish::ITALIAN;
+            checksum += count;
+        });
+        double store_ns = timeNs([&]() { checksum += store.tallyCuisineTypes(Dish::ITALIAN); });
+        printRow("tallyCuisineTypes  ", pointer_ns / dishes, store_ns / dishes);
+
+        pointer_ns = timeNs([&]() {
+            long long sum = 0;
+            for (const Dish* dish : pointers) sum += dish->getPrepTime();
+            checksum += std::llround(double(sum) / dishes);
+        });
+        store_ns = timeNs([&]() { checksum += store.calculateAvgPrepTime(); });
+        printRow("calculateAvgPrepTime", pointer_ns / dishes, store_ns / dishes);
+
+        pointer_ns = timeNs([&]() { for (Dish* dish : pointers) dish->dietaryAccommodations(request); });
+        store_ns = timeNs([&]() { store.dietaryAdjustment(request); });
+        printRow("dietaryAdjustment  ", pointer_ns / dishes, store_ns / dishes);
+
+        for (Dish* dish : pointers)
+        {
+            delete dish;
+        }
+    }
+
+    std::cout << "(checksum " << checksum << ")" << std::endl;
+    return 0;
+}
@@ -0,0 +1,265 @@
+/**
+ * @file TraceReplay.cpp
+ * @brief This file contains the implementation of the TraceReplay class, which replays a scripted trace of order traffic on a Kitchen.
+ *
+ * @date October 17, 2026
+ * @author Kun Feng Wei
+ */
+
+#include "TraceReplay.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+// Dietary mask names, in the bit order of a numeric mask
+const char* const DIETARY_NAMES[] = {"vegetarian", "vegan", "gluten-free", "nut-free", "low-sodium", "low-sugar"};
+const int DIETARY_COUNT = 6;
+
+void setDietaryBit(Dish::DietaryRequest& request, int bit)
+{
+    switch (bit)
+    {
+        case 0: request.vegetarian = true; break;
+        case 1: request.vegan = true; break;
+        case 2: request.gluten_free = true; break;
+        case 3: request.nut_free = true; break;
+        case 4: request.low_sodium = true; break;
+        case 5: request.low_sugar = true; break;
+    }
+}
+
+// Parses "vegan,nut-free", "vegan+nut-free", "all" or a number such as "10"
+bool parseDietaryMask(const std::string& text, Dish::DietaryRequest& request)
+{
+    request = {false, false, false, false, false, false};
+    char* end = nullptr;
+    long mask = std::strtol(text.c_str(), &end, 0);
+    if (!text.empty() && *end == '\0')
+    {
+        if (mask <= 0 || mask >= (1L << DIETARY_COUNT))
+        {
+            return false;
+        }
+        for (int bit = 0; bit < DIETARY_COUNT; bit++)
+        {
+            if (mask & (1L << bit))
+            {
+                setDietaryBit(request, bit);
+            }
+        }
+        return true;
+    }
+
+    size_t begin = 0;
+    while (begin <= text.size())
+    {
+        size_t split = text.find_first_of(",+", begin);
+        std::string name = text.substr(begin, split == std::string::npos ? std::string::npos : split - begin);
+        bool known = false;
+        for (int bit = 0; bit < DIETARY_COUNT; bit++)
+        {
+            if (name == DIETARY_NAMES[bit] || name == "all")
+            {
+                setDietaryBit(request, bit);
+                known = true;
+            }
+        }
+        if (!known)
+        {
+            return false;
+        }
+        if (split == std::string::npos)
+        {
+            break;
+        }
+        begin = split + 1;
+    }
+    return true;
+}
+
+// Parses a whole non-negative number, rejecting trailing characters
+bool parseMinutes(const std::string& text, int& minutes)
+{
+    char* end = nullptr;
+    long parsed = std::strtol(text.c_str(), &end, 10);
+    if (text.empty() || *end != '\0' || parsed < 0 || parsed > 1000000000)
+    {
+        return false;
+    }
+    minutes = static_cast<int>(parsed);
+    return true;
+}
+
+} // namespace
+
+bool TraceReplay::load(std::istream& input, std::string& error) {
+    ops_.clear();
+    std::string line;
+    int line_number = 0;
+    while (std::getline(input, line)) {
+        line_number++;
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        size_t space = line.find(' ');
+        std::string keyword = line.substr(0, space);
+        Op op = {ORDER, space == std::string::npos ? std::string() : line.substr(space + 1), 0, {false, false, false, false, false, false}};
+        std::string reason;
+        if (!tryEnumFromToken(OP_TYPE_INFO, keyword, op.type)) {
+            reason = "unknown operation " + keyword;
+        } else if (op.type == REPORT) {
+            if (!op.argument.empty()) {
+                reason = "report takes no argument";
+            }
+        } else if (op.argument.empty()) {
+            reason = keyword + " needs an argument";
+        } else if (op.type == ORDER) {
+            try {
+                Dish* dish = Kitchen::parseDish(op.argument);
+                if (dish == nullptr) {
+                    reason = "unknown dish type";
+                }
+                delete dish;
+            } catch (const std::exception& parse_error) {
+                // std::stoi and the price parser throw on malformed rows
+                reason = parse_error.what();
+            }
+        } else if (op.type == RELEASE_CUISINE) {
+            Dish::CuisineType cuisine;
+            if (!tryEnumFromToken(Dish::CUISINE_TYPE_INFO, op.argument, cuisine)) {
+                reason = "unknown cuisine type " + op.argument;
+            }
+        } else if (op.type == RELEASE_BELOW) {
+            if (!parseMinutes(op.argument, op.minutes)) {
+                reason = "invalid prep time " + op.argument;
+            }
+        } else if (op.type == ADJUST) {
+            if (!parseDietaryMask(op.argument, op.request)) {
+                reason = "invalid dietary mask " + op.argument;
+            }
+        }
+
+        if (!reason.empty()) {
+            error = "line " + std::to_string(line_number) + ": " + reason;
+            ops_.clear();
+            return false;
+        }
+        ops_.push_back(op);
+    }
+    return true;
+}
+
+size_t TraceReplay::size() const {
+    return ops_.size();
+}
+
+bool TraceReplay::apply(const Op& op, Kitchen& kitchen, OutputSink& report_out) {
+    switch (op.type) {
+        case ORDER: {
+            Dish* dish = Kitchen::parseDish(op.argument);
+            if (!kitchen.newOrder(dish)) {
+                delete dish; // the kitchen is full and does not take ownership
+                return false;
+            }
+            return true;
+        }
+        case SERVE: {
+            Dish* dish = kitchen.findDish(op.argument);
+            if (dish == nullptr || !kitchen.serveDish(dish)) {
+                return false;
+            }
+            delete dish; // served, so the kitchen no longer owns it
+            return true;
+        }
+        case RELEASE_CUISINE:
+        case RELEASE_BELOW: {
+            // Released dishes are the caller's, like a served one
+            std::vector<Dish*> released;
+            if (op.type == RELEASE_CUISINE) {
+                kitchen.releaseDishesOfCuisineType(op.argument, released);
+            } else {
+                kitchen.releaseDishesBelowPrepTime(op.minutes, released);
+            }
+            for (Dish* dish : released) {
+                delete dish;
+            }
+            return true;
+        }
+        case ADJUST:
+            kitchen.dietaryAdjustment(op.request);
+            return true;
+        case REPORT:
+            kitchen.kitchenReport(report_out);
+            return true;
+        case OP_TYPE_COUNT:
+            break;
+    }
+    return false;
+}
+
+void TraceReplay::run(Kitchen& kitchen, const Options& options, OutputSink& report_out, Result& result) const {
+    result.ops = 0;
+    result.max_lag_ms = 0.0;
+    for (int type = 0; type < OP_TYPE_COUNT; type++) {
+        result.rejections[type] = 0;
+        result.latencies[type].clear();
+    }
+
+    const bool paced = options.rate > 0.0;
+    const std::chrono::duration<double> period(paced ? 1.0 / options.rate : 0.0);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int pass = 0; pass < options.repeat; pass++) {
+        for (const Op& op : ops_) {
+            std::chrono::steady_clock::time_point begin;
+            if (paced) {
+                // Op n is due at start + n * period, so the rate does not drift when the replay catches up
+                std::chrono::steady_clock::time_point due = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(period * static_cast<double>(result.ops));
+                begin = std::chrono::steady_clock::now();
+                if (begin < due) {
+                    std::this_thread::sleep_until(due);
+                    begin = std::chrono::steady_clock::now(); // the sleep's wake-up delay is not the kitchen's latency
+                } else {
+                    // Behind schedule: the op has been waiting since it was due, and that wait is part of its latency
+                    result.max_lag_ms = std::max(result.max_lag_ms, std::chrono::duration<double, std::milli>(begin - due).count());
+                    begin = due;
+                }
+            } else {
+                begin = std::chrono::steady_clock::now();
+            }
+
+            if (!apply(op, kitchen, report_out)) {
+                result.rejections[op.type]++;
+            }
+            std::chrono::steady_clock::duration latency = std::chrono::steady_clock::now() - begin;
+            result.latencies[op.type].record(std::chrono::duration_cast<std::chrono::nanoseconds>(latency).count());
+            result.ops++;
+        }
+    }
+    result.elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void TraceReplay::Result::writeText(MenuRenderer& out, const Options& options) const {
+    out.append("replay: ").appendInt(ops).append(" ops in ").appendFixed(elapsed_ms, 3).append(" ms, ");
+    out.appendFixed(elapsed_ms > 0 ? ops / elapsed_ms * 1000.0 : 0.0, 0).append(" ops/s, ");
+    if (options.rate > 0.0) {
+        out.append("paced at ").appendFixed(options.rate, 0).append(" ops/s, max lag ").appendFixed(max_lag_ms, 3).append(" ms\n");
+    } else {
+        out.append("flat out\n");
+    }
+    for (int type = 0; type < OP_TYPE_COUNT; type++) {
+        latencies[type].writeSummary(out, OP_TYPE_INFO[type].token);
+    }
+    for (int type = 0; type < OP_TYPE_COUNT; type++) {
+        if (rejections[type] > 0) {
+            out.append(OP_TYPE_INFO[type].token).append(": rejected=").appendInt(rejections[type]).append('\n');
+        }
+    }
+}
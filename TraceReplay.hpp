@@ -0,0 +1,138 @@
+/**
+ * @file TraceReplay.hpp
+ * @brief This file contains the declaration of the TraceReplay class, which replays a scripted trace of order traffic on a Kitchen.
+ *
+ * A trace is a text file with one operation per line; blank lines and lines starting with '#' are skipped:
+ *
+ *   order APPETIZER,Spring Rolls,Cabbage;Carrots,20,5.99,ASIAN,BUFFET;3;true
+ *   serve Spring Rolls
+ *   release-cuisine ITALIAN
+ *   release-below 30
+ *   adjust vegan,nut-free
+ *   report
+ *
+ * `order` takes one row in the Dishes.csv schema, `serve` the name of a dish (the first dish with that name is
+ * served), `release-below` a prep time in minutes, and `adjust` a dietary mask: the names vegetarian, vegan,
+ * gluten-free, nut-free, low-sodium, low-sugar and all joined by ',' or '+', or a number whose bits 0 to 5 stand for
+ * those names in that order. The whole trace is checked by load(), so a replay never stops halfway on a bad line.
+ *
+ * run() replays the operations either flat out or paced at a fixed rate. Every operation's latency goes into a
+ * LatencyHistogram of its type. When a paced replay falls behind schedule, latency is measured from the time the
+ * operation was due rather than from when the replay got to it, so a slow operation also counts against the ones
+ * queued behind it.
+ *
+ * @date October 17, 2026
+ * @author Kun Feng Wei
+ */
+
+#ifndef TRACE_REPLAY_HPP
+#define TRACE_REPLAY_HPP
+
+#include "Dish.hpp"
+#include "EnumTable.hpp"
+#include "Kitchen.hpp"
+#include "LatencyHistogram.hpp"
+#include "MenuRenderer.hpp"
+#include "OutputSink.hpp"
+#include <istream>
+#include <string>
+#include <vector>
+
+class TraceReplay {
+public:
+    /**
+     * The operation types of a trace.
+     */
+    enum OpType
+    {
+        ORDER,
+        SERVE,
+        RELEASE_CUISINE,
+        RELEASE_BELOW,
+        ADJUST,
+        REPORT,
+        OP_TYPE_COUNT
+    };
+
+    /**
+     * Metadata of each operation type; the token is the keyword that starts a trace line.
+     */
+    static constexpr EnumInfo<OpType> OP_TYPE_INFO[] = {
+        {ORDER, "order", "Order", 0},
+        {SERVE, "serve", "Serve", 0},
+        {RELEASE_CUISINE, "release-cuisine", "Release cuisine type", 0},
+        {RELEASE_BELOW, "release-below", "Release below prep time", 0},
+        {ADJUST, "adjust", "Dietary adjustment", 0},
+        {REPORT, "report", "Kitchen report", 0},
+    };
+
+    /**
+     * How run() paces the trace.
+     */
+    struct Options
+    {
+        double rate;  ///< Operations per second, or 0 to replay flat out.
+        int repeat;   ///< Number of passes over the trace.
+    };
+
+    /**
+     * What one run() measured.
+     */
+    struct Result
+    {
+        long long ops;                              ///< Operations replayed.
+        double elapsed_ms;                          ///< Wall time of the whole replay.
+        double max_lag_ms;                          ///< Largest delay behind schedule when paced, 0 otherwise.
+        long long rejections[OP_TYPE_COUNT];        ///< Orders the kitchen refused and serves of dishes it did not have.
+        LatencyHistogram latencies[OP_TYPE_COUNT];  ///< Latency in ns of every operation, by type.
+
+        /**
+         * Appends the throughput line, one latency line per operation type that ran and, if any, the rejections, e.g.
+         * "replay: 1200 ops in 3.512 ms, 341686 ops/s, flat out".
+         * @param out The renderer receiving the text.
+         * @param options The options the result was run with.
+         */
+        void writeText(MenuRenderer& out, const Options& options) const;
+    };
+
+    /**
+     * Reads and checks a whole trace, replacing any trace loaded before.
+     * @param input The trace text.
+     * @param[out] error Receives "line N: reason" when the trace is rejected.
+     * @return True if every line is a valid operation, false otherwise (the trace is then empty).
+     */
+    bool load(std::istream& input, std::string& error);
+
+    /**
+     * @return The number of operations in the trace.
+     */
+    size_t size() const;
+
+    /**
+     * Replays the trace on a kitchen.
+     * @param kitchen The kitchen the operations run on.
+     * @param options The rate and number of passes.
+     * @param report_out The sink that receives the text of every `report` operation.
+     * @param[out] result Receives the measurements; its previous contents are discarded.
+     */
+    void run(Kitchen& kitchen, const Options& options, OutputSink& report_out, Result& result) const;
+
+private:
+    // One parsed trace line
+    struct Op
+    {
+        OpType type;
+        std::string argument;          // the row of an order, the dish name of a serve, the cuisine type of a release
+        int minutes;                   // prep time of release-below
+        Dish::DietaryRequest request;  // mask of adjust
+    };
+
+    // Runs one operation; returns false if the kitchen refused it
+    static bool apply(const Op& op, Kitchen& kitchen, OutputSink& report_out);
+
+    std::vector<Op> ops_;
+};
+
+static_assert(isIndexedByValue(TraceReplay::OP_TYPE_INFO), "OP_TYPE_INFO must be in enum order");
+
+#endif // TRACE_REPLAY_HPP
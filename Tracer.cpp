@@ -0,0 +1,225 @@
+/**
+ * @file Tracer.cpp
+ * @brief This file contains the implementation of the Tracer class, which records timed spans as a Chrome trace_event timeline.
+ *
+ * Each thread's ring buffer is taken when the thread records its first span and belongs to a registry that
+ * outlives the thread, so the spans of worker threads that have already exited are still written at stop().
+ * An exiting thread hands its ring back to the registry and the next new thread appends to it, so the number of
+ * rings is bounded by the most threads ever recording at once, not by the number of threads started.
+ *
+ * A writer raises its ring's `writing` flag before it checks that recording is on and lowers it after the span is
+ * stored. start() and stop() turn recording off first and then wait for every flag to drop, so they never touch a
+ * slot while a thread is still filling it.
+ *
+ * @date October 17, 2026
+ * @author Kun Feng Wei
+ */
+
+#include "Tracer.hpp"
+#include "MenuRenderer.hpp"
+#include "OutputSink.hpp"
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+std::atomic<bool> Tracer::active_(false);
+
+namespace {
+
+struct Event
+{
+    const char* name;
+    const char* category;
+    uint64_t begin_ns;
+    uint64_t end_ns;
+};
+
+// One thread's spans; written only by the thread holding it, read by stop()
+struct ThreadRing
+{
+    int tid;
+    uint64_t generation; // start() that the spans belong to
+    std::vector<Event> events;
+    std::atomic<uint64_t> written;
+    std::atomic<bool> writing; // true while the holder may be storing a span
+
+    ThreadRing(int thread_id, uint64_t current_generation)
+        : tid(thread_id), generation(current_generation), events(Tracer::RING_CAPACITY), written(0), writing(false) {}
+};
+
+struct TraceRegistry
+{
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadRing>> rings;
+    std::vector<ThreadRing*> free_rings; // rings of exited threads, handed to the next new thread
+    std::string filename;
+    uint64_t start_ns = 0;
+    uint64_t generation = 0;
+};
+
+TraceRegistry& traceRegistry()
+{
+    static TraceRegistry* registry = new TraceRegistry(); // never destroyed, so late spans and exit flushes can use it
+    return *registry;
+}
+
+// A thread's hold on its ring; gives the ring back to the registry when the thread exits
+struct RingLease
+{
+    ThreadRing* ring = nullptr;
+
+    ~RingLease()
+    {
+        if (ring != nullptr)
+        {
+            TraceRegistry& registry = traceRegistry();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            registry.free_rings.push_back(ring);
+        }
+    }
+};
+
+ThreadRing& threadRing()
+{
+    thread_local RingLease lease;
+    if (lease.ring == nullptr)
+    {
+        TraceRegistry& registry = traceRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        if (!registry.free_rings.empty())
+        {
+            // The previous holder has exited, so its spans stay on the same track ahead of this thread's
+            lease.ring = registry.free_rings.back();
+            registry.free_rings.pop_back();
+        }
+        else
+        {
+            registry.rings.emplace_back(new ThreadRing(static_cast<int>(registry.rings.size()) + 1, registry.generation));
+            lease.ring = registry.rings.back().get();
+        }
+    }
+    return *lease.ring;
+}
+
+// Waits until no thread is storing a span; recording must already be off. Called with the registry mutex held.
+void waitForWriters(TraceRegistry& registry)
+{
+    for (const std::unique_ptr<ThreadRing>& ring : registry.rings)
+    {
+        while (ring->writing.load(std::memory_order_acquire))
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void appendMicroseconds(MenuRenderer& out, uint64_t ns)
+{
+    out.appendFixed(static_cast<double>(ns) / 1000.0, 3);
+}
+
+// Starts tracing from the environment and writes the file when the program exits
+struct TraceAtExit
+{
+    TraceAtExit()
+    {
+        if (const char* filename = std::getenv("KITCHEN_TRACE_FILE"))
+        {
+            if (Tracer::COMPILED_IN && filename[0] != '\0')
+            {
+                Tracer::start(filename);
+            }
+        }
+    }
+
+    ~TraceAtExit()
+    {
+        Tracer::stop();
+    }
+};
+
+TraceAtExit trace_at_exit;
+
+} // namespace
+
+void Tracer::start(const std::string& filename) {
+    TraceRegistry& registry = traceRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    active_.store(false);
+    waitForWriters(registry);
+    registry.filename = filename;
+    registry.start_ns = nowNs();
+    registry.generation++;
+    for (std::unique_ptr<ThreadRing>& ring : registry.rings) {
+        ring->written.store(0, std::memory_order_relaxed);
+        ring->generation = registry.generation;
+    }
+    active_.store(true);
+}
+
+void Tracer::record(const char* name, const char* category, uint64_t begin_ns, uint64_t end_ns) {
+    ThreadRing& ring = threadRing();
+    // Raising the flag before checking active_ means stop() either sees the flag and waits, or this thread sees
+    // recording off and stores nothing
+    ring.writing.store(true);
+    if (!active_.load())
+    {
+        ring.writing.store(false, std::memory_order_release);
+        return;
+    }
+    uint64_t written = ring.written.load(std::memory_order_relaxed);
+    ring.events[written % RING_CAPACITY] = {name, category, begin_ns, end_ns};
+    ring.written.store(written + 1, std::memory_order_relaxed);
+    ring.writing.store(false, std::memory_order_release);
+}
+
+bool Tracer::stop() {
+    if (!active_.exchange(false)) {
+        return false;
+    }
+    TraceRegistry& registry = traceRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    waitForWriters(registry);
+
+    MenuRenderer out;
+    out.append("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    bool first = true;
+    for (const std::unique_ptr<ThreadRing>& ring : registry.rings) {
+        uint64_t written = ring->written.load(std::memory_order_relaxed);
+        if (ring->generation != registry.generation || written == 0) {
+            continue;
+        }
+        out.append(first ? "" : ",\n");
+        first = false;
+        out.append("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":").appendInt(ring->tid);
+        out.append(",\"args\":{\"name\":\"thread ").appendInt(ring->tid).append("\"}}");
+        // Oldest surviving span first; spans older than the ring capacity were overwritten
+        uint64_t begin = written > static_cast<uint64_t>(RING_CAPACITY) ? written - RING_CAPACITY : 0;
+        for (uint64_t i = begin; i < written; i++) {
+            const Event& event = ring->events[i % RING_CAPACITY];
+            if (event.begin_ns < registry.start_ns) {
+                continue; // started before this recording
+            }
+            out.append(",\n{\"name\":").appendJsonString(event.name);
+            out.append(",\"cat\":").appendJsonString(event.category);
+            out.append(",\"ph\":\"X\",\"pid\":1,\"tid\":").appendInt(ring->tid);
+            out.append(",\"ts\":");
+            appendMicroseconds(out, event.begin_ns - registry.start_ns);
+            out.append(",\"dur\":");
+            appendMicroseconds(out, event.end_ns - event.begin_ns);
+            out.append('}');
+        }
+    }
+    out.append("\n]}\n");
+
+    std::ofstream file(registry.filename);
+    if (!file.is_open()) {
+        return false;
+    }
+    StreamSink sink(file);
+    out.emit(sink);
+    return file.good();
+}
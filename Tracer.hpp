@@ -0,0 +1,147 @@
+/**
+ * @file Tracer.hpp
+ * @brief This file contains the declaration of the Tracer class, which records timed spans as a Chrome trace_event timeline.
+ *
+ * A Tracer::Span measures the time between its construction and destruction and stores it, with its name, category
+ * and thread, in a ring buffer held by the calling thread; when a ring is full the oldest spans are overwritten.
+ * A thread that exits leaves its ring to the next thread that starts recording, so short-lived worker threads do
+ * not each keep a ring.
+ * The spans of all threads are written to a JSON file in the Chrome trace_event format (complete "X" events, one
+ * track per thread), which can be opened in chrome://tracing or https://ui.perfetto.dev.
+ *
+ * Spans are compiled in only when KITCHEN_TRACE is defined (`make TRACE=1`); otherwise Span is an empty class and
+ * tracing costs nothing. When compiled in, recording starts at program start if the KITCHEN_TRACE_FILE environment
+ * variable names an output file, or when start() is called, and the file is written by stop() or at exit.
+ * While recording is stopped a span costs one relaxed atomic load.
+ *
+ * @date October 17, 2026
+ * @author Kun Feng Wei
+ */
+
+#ifndef TRACER_HPP
+#define TRACER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+class Tracer {
+public:
+    /**
+     * True when spans are compiled in (KITCHEN_TRACE is defined).
+     */
+#ifdef KITCHEN_TRACE
+    static constexpr bool COMPILED_IN = true;
+#else
+    static constexpr bool COMPILED_IN = false;
+#endif
+
+    /**
+     * The number of spans each thread keeps; older spans are overwritten.
+     */
+    static const int RING_CAPACITY = 1 << 16;
+
+    /**
+     * Starts recording spans. Spans recorded by an earlier start() are discarded.
+     * @param filename The JSON file written by stop() or at exit.
+     */
+    static void start(const std::string& filename);
+
+    /**
+     * Stops recording and writes every thread's spans to the file given to start(). Does nothing if not recording.
+     * A span that ends while stop() runs is dropped rather than written half stored.
+     * @return True if the file was written, false otherwise.
+     */
+    static bool stop();
+
+    /**
+     * @return True while spans are being recorded.
+     */
+    static bool active()
+    {
+        return active_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @return The steady clock in nanoseconds.
+     */
+    static uint64_t nowNs()
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    /**
+     * Stores one finished span in the calling thread's ring buffer. Called by Span.
+     * @param name The span name; must be a string literal.
+     * @param category The span category; must be a string literal.
+     */
+    static void record(const char* name, const char* category, uint64_t begin_ns, uint64_t end_ns);
+
+    class Span;
+
+private:
+    static std::atomic<bool> active_;
+};
+
+#ifdef KITCHEN_TRACE
+
+/**
+ * @class Tracer::Span
+ * @brief Records the time from construction to destruction (or to restart()) as one span.
+ */
+class Tracer::Span {
+public:
+    /**
+     * @param name The span name; must be a string literal.
+     * @param category The span category; must be a string literal.
+     */
+    Span(const char* name, const char* category) : name_(name), category_(category), begin_ns_(active() ? nowNs() : 0) {}
+
+    Span(const Span&) = delete;
+    Span& operator=(const Span&) = delete;
+
+    ~Span()
+    {
+        if (begin_ns_ != 0)
+        {
+            record(name_, category_, begin_ns_, nowNs());
+        }
+    }
+
+    /**
+     * Ends the current span and starts the next one with the same name, e.g. once per chunk of a loop.
+     */
+    void restart()
+    {
+        uint64_t now = active() ? nowNs() : 0;
+        if (begin_ns_ != 0 && now != 0)
+        {
+            record(name_, category_, begin_ns_, now);
+        }
+        begin_ns_ = now;
+    }
+
+private:
+    const char* name_;
+    const char* category_;
+    uint64_t begin_ns_; // 0 when recording was off at the start of the span
+};
+
+#else
+
+// Compiled-out Span: no members and no clock reads
+class Tracer::Span {
+public:
+    Span(const char*, const char*) {}
+
+    Span(const Span&) = delete;
+    Span& operator=(const Span&) = delete;
+
+    void restart() {}
+};
+
+#endif // KITCHEN_TRACE
+
+#endif // TRACER_HPP
@@ -0,0 +1,86 @@
+/**
+ * @file WireFormat.hpp
+ * @brief This file contains the little-endian integer helpers shared by the binary formats (the order log and the socket protocol).
+ *
+ * Integers are stored byte by byte, lowest first, so files and frames read the same on any host and unaligned
+ * fields need no special care; compilers turn these loops into single loads and stores on little-endian machines.
+ *
+ * @date October 17, 2026
+ * @author Kun Feng Wei
+ */
+
+#ifndef WIRE_FORMAT_HPP
+#define WIRE_FORMAT_HPP
+
+#include <cstdint>
+#include <string>
+
+/**
+ * @param data The first of 4 bytes.
+ * @return The little-endian 32-bit integer stored there.
+ */
+inline uint32_t getU32(const char* data)
+{
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+    return static_cast<uint32_t>(bytes[0]) | static_cast<uint32_t>(bytes[1]) << 8 | static_cast<uint32_t>(bytes[2]) << 16 |
+           static_cast<uint32_t>(bytes[3]) << 24;
+}
+
+/**
+ * @param data The first of 8 bytes.
+ * @return The little-endian 64-bit integer stored there.
+ */
+inline uint64_t getU64(const char* data)
+{
+    return static_cast<uint64_t>(getU32(data)) | static_cast<uint64_t>(getU32(data + 4)) << 32;
+}
+
+/**
+ * Stores a 32-bit integer in little-endian order.
+ * @param data The first of 4 bytes receiving the integer.
+ * @param value The integer.
+ */
+inline void putU32(char* data, uint32_t value)
+{
+    for (int i = 0; i < 4; i++)
+    {
+        data[i] = static_cast<char>(value >> (8 * i));
+    }
+}
+
+/**
+ * Stores a 64-bit integer in little-endian order.
+ * @param data The first of 8 bytes receiving the integer.
+ * @param value The integer.
+ */
+inline void putU64(char* data, uint64_t value)
+{
+    putU32(data, static_cast<uint32_t>(value));
+    putU32(data + 4, static_cast<uint32_t>(value >> 32));
+}
+
+/**
+ * Appends a 32-bit integer in little-endian order.
+ * @param out The string receiving the 4 bytes.
+ * @param value The integer.
+ */
+inline void appendU32(std::string& out, uint32_t value)
+{
+    char bytes[4];
+    putU32(bytes, value);
+    out.append(bytes, sizeof(bytes));
+}
+
+/**
+ * Appends a 64-bit integer in little-endian order.
+ * @param out The string receiving the 8 bytes.
+ * @param value The integer.
+ */
+inline void appendU64(std::string& out, uint64_t value)
+{
+    char bytes[8];
+    putU64(bytes, value);
+    out.append(bytes, sizeof(bytes));
+}
+
+#endif // WIRE_FORMAT_HPP
@@ -5,6 +5,7 @@
 #include "MainCourse.hpp"
 #include "ArrayBag.hpp"
 #include "Kitchen.hpp"
+#include "KitchenCli.hpp"
 #include <vector>
 #include <string>
 #include <iomanip> // For std::fixed and std::setprecision
@@ -13,8 +14,15 @@
 #include <sstream>
 #include <cmath>
 
-int main()
+int main(int argc, char* argv[])
 {
+    // With arguments, run them as commands (see KitchenCli.hpp); without, keep the original demo
+    if (argc > 1)
+    {
+        KitchenCli cli;
+        return cli.run(argc, argv);
+    }
+
     Kitchen dish("small_Dishes.csv");
 
     std::cout << "Before adjustment and out of bounds" << std::endl;  